@@ -5,14 +5,23 @@
 #include "VoxelAssets/VoxelDataAssetInstance.h"
 #include "VoxelGenerators/VoxelEmptyGenerator.h"
 #include "VoxelGenerators/VoxelTransformableGeneratorHelper.h"
+#include "VoxelGenerators/VoxelGeneratorInstanceCache.h"
 #include "VoxelUtilities/VoxelSerializationUtilities.h"
 #include "VoxelFeedbackContext.h"
 #include "VoxelMessages.h"
 
 #include "Engine/Texture2D.h"
+#include "HAL/ConsoleManager.h"
+#include "UObject/Package.h"
 #include "Serialization/LargeMemoryReader.h"
 #include "Serialization/LargeMemoryWriter.h"
 
+static TAutoConsoleVariable<int32> CVarDataAssetLazySlabs(
+	TEXT("voxel.dataassets.LazySlabs"),
+	1,
+	TEXT("If true, generator instances of data assets only decompress the slabs they are queried in. Else the whole asset is decompressed when the first instance is created"),
+	ECVF_Default);
+
 UVoxelDataAsset::UVoxelDataAsset()
 {
 	Data = MakeVoxelShared<FVoxelDataAssetData>();
@@ -35,6 +44,8 @@ TVoxelSharedRef<FVoxelTransformableGeneratorInstance> UVoxelDataAsset::GetTransf
 TVoxelSharedRef<const FVoxelDataAssetData> UVoxelDataAsset::GetData()
 {
 	TryLoad();
+	// Tools & editors access the raw arrays
+	Data->LoadAllSlabs();
 	return Data.ToSharedRef();
 }
 
@@ -47,34 +58,69 @@ void UVoxelDataAsset::SetData(const TVoxelSharedRef<FVoxelDataAssetData>& InData
 TVoxelSharedRef<FVoxelDataAssetInstance> UVoxelDataAsset::GetInstanceImpl()
 {
 	TryLoad();
-	return MakeVoxelShared<FVoxelDataAssetInstance>(*this);
+	if (!CVarDataAssetLazySlabs.GetValueOnAnyThread())
+	{
+		Data->LoadAllSlabs();
+	}
+	// All the instances share the same data & slabs
+	return MakeVoxelShared<FVoxelDataAssetInstance>(*this, Data.ToSharedRef());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+void UVoxelDataAsset::CompressData(FVoxelDataAssetData& InData, TArray<uint8>& OutCompressedData)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	// Slow tasks are disabled outside of the game thread
+	FVoxelScopedSlowTask Saving(1.f);
+
+	Saving.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Compressing"));
+	InData.CompressSlabs(OutCompressedData);
+}
+
+void UVoxelDataAsset::SetCompressedData(const TVoxelSharedRef<FVoxelDataAssetData>& InData, TArray<uint8>&& InCompressedData, bool bKeepDataLoaded)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Data = InData;
+	SaveCompressedData(MoveTemp(InCompressedData));
+
+	if (!bKeepDataLoaded)
+	{
+		// Properties are synced: TryLoad will decompress it when needed
+		Data = MakeVoxelShared<FVoxelDataAssetData>();
+	}
+}
+
 void UVoxelDataAsset::Save()
 {
 	VOXEL_FUNCTION_COUNTER();
-	
-	FVoxelScopedSlowTask Saving(2.f);
+
+	TArray<uint8> NewCompressedData;
+	CompressData(*Data, NewCompressedData);
+	SaveCompressedData(MoveTemp(NewCompressedData));
+}
+
+void UVoxelDataAsset::SaveCompressedData(TArray<uint8>&& InCompressedData)
+{
+	VOXEL_FUNCTION_COUNTER();
 
 	Modify();
 
+	// Must match CompressData
 	VoxelCustomVersion = FVoxelDataAssetDataVersion::LatestVersion;
 	ValueConfigFlag = GVoxelValueConfigFlag;
 	MaterialConfigFlag = GVoxelMaterialConfigFlag;
 
-	Saving.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Serializing"));
-
-	FLargeMemoryWriter MemoryWriter(Data->GetAllocatedSize());
-	Data->Serialize(MemoryWriter, ValueConfigFlag, MaterialConfigFlag, FVoxelDataAssetDataVersion::Type(VoxelCustomVersion));
-
-	Saving.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Compressing"));
-	FVoxelSerializationUtilities::CompressData(MemoryWriter, CompressedData);
+	CompressedData = MakeVoxelShared<TArray<uint8>>(MoveTemp(InCompressedData));
 
 	SyncProperties();
+
+	// Don't share the instances using the old data with new users
+	FVoxelGeneratorInstanceCache::Invalidate(this);
 }
 
 
@@ -82,14 +128,27 @@ void UVoxelDataAsset::Load()
 {
 	VOXEL_FUNCTION_COUNTER();
 	
-	if (CompressedData.Num() == 0)
+	if (CompressedData->Num() == 0)
 	{
 		// Nothing to load
 		return;
 	}
+
+	if (VoxelCustomVersion >= FVoxelDataAssetDataVersion::SlabPayload)
+	{
+		// Slabs are decompressed when used
+		if (!Data->InitSlabs(CompressedData, ValueConfigFlag, MaterialConfigFlag, FVoxelDataAssetDataVersion::Type(VoxelCustomVersion)))
+		{
+			FVoxelMessages::Error("Invalid slab payload, data is corrupted", this);
+			return;
+		}
+
+		SyncProperties();
+		return;
+	}
 	
 	TArray64<uint8> UncompressedData;
-	if (!FVoxelSerializationUtilities::DecompressData(CompressedData, UncompressedData))
+	if (!FVoxelSerializationUtilities::DecompressData(*CompressedData, UncompressedData))
 	{
 		FVoxelMessages::Error("Decompression failed, data is corrupted", this);
 		return;
@@ -127,7 +186,7 @@ void UVoxelDataAsset::SyncProperties()
 	UncompressedSizeInMB =
 		Data->GetRawValues().Num() * Data->GetRawValues().GetTypeSize() / double(1 << 20) +
 		Data->GetRawMaterials().Num() * sizeof(FVoxelMaterial) / double(1 << 20);
-	CompressedSizeInMB = CompressedData.Num() / double(1 << 20);
+	CompressedSizeInMB = CompressedData->Num() / double(1 << 20);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -142,14 +201,20 @@ void UVoxelDataAsset::Serialize(FArchive& Ar)
 
 	if ((Ar.IsLoading() || Ar.IsSaving()) && !Ar.IsTransacting())
 	{
+		if (Ar.IsLoading())
+		{
+			// The old payload might be used by slabs
+			CompressedData = MakeVoxelShared<TArray<uint8>>();
+		}
+		
 		if (VoxelCustomVersion == FVoxelDataAssetDataVersion::BeforeCustomVersionWasAdded)
 		{
 			Ar << MaterialConfigFlag;
-			Ar << CompressedData;
+			Ar << *CompressedData;
 		}
 		else
 		{
-			CompressedData.BulkSerialize(Ar);
+			CompressedData->BulkSerialize(Ar);
 		}
 	}
 }
@@ -203,4 +268,111 @@ UTexture2D* UVoxelDataAsset::GetThumbnail()
 
 	return ThumbnailTexture;
 }
-#endif
\ No newline at end of file
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommand CmdBenchmarkTransformedDataAsset(
+	TEXT("voxel.generators.BenchmarkTransformedDataAsset"),
+	TEXT("Benchmark the batched transformed queries of a rotated & scaled data asset against querying every voxel individually"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		constexpr int32 AssetSize = 64;
+		constexpr int32 ChunkSize = 32;
+		constexpr int32 NumRuns = 8;
+
+		// Sphere with some noise
+		const TVoxelSharedRef<FVoxelDataAssetData> Data = MakeVoxelShared<FVoxelDataAssetData>();
+		Data->SetSize(FIntVector(AssetSize), false);
+		FRandomStream Stream(AssetSize);
+		for (int32 Z = 0; Z < AssetSize; Z++)
+		{
+			for (int32 Y = 0; Y < AssetSize; Y++)
+			{
+				for (int32 X = 0; X < AssetSize; X++)
+				{
+					const float Distance = FVector::Distance(FVector(X, Y, Z), FVector(AssetSize / 2.f)) - AssetSize / 3.f;
+					Data->SetValue(X, Y, Z, FVoxelValue(FMath::Clamp(Distance / 2.f + Stream.FRandRange(-0.2f, 0.2f), -1.f, 1.f)));
+				}
+			}
+		}
+
+		UVoxelDataAsset* Asset = NewObject<UVoxelDataAsset>(GetTransientPackage());
+		Asset->SetData(Data);
+
+		const TVoxelSharedRef<FVoxelTransformableGeneratorInstance> Instance = Asset->GetTransformableInstance();
+		Instance->Init(FVoxelGeneratorInit());
+
+		const FTransform LocalToWorld(FRotator(30, 45, 60), FVector(100, -50, 20), FVector(1.5f, 1.5f, 0.75f));
+		const FVoxelIntBox WorldBounds = FVoxelIntBox(FIntVector::ZeroValue, Data->GetSize()).ApplyTransform<EInverseTransform::False>(LocalToWorld).MakeMultipleOfBigger(ChunkSize);
+
+		FVoxelValueArray BatchedValues;
+		FVoxelValueArray IndividualValues;
+		BatchedValues.SetNumUninitialized(ChunkSize * ChunkSize * ChunkSize);
+		IndividualValues.SetNumUninitialized(ChunkSize * ChunkSize * ChunkSize);
+
+		double BatchedTime = 0;
+		double IndividualTime = 0;
+		int32 NumChunks = 0;
+		int32 NumDifferences = 0;
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			for (int32 ChunkX = WorldBounds.Min.X; ChunkX < WorldBounds.Max.X; ChunkX += ChunkSize)
+			{
+				for (int32 ChunkY = WorldBounds.Min.Y; ChunkY < WorldBounds.Max.Y; ChunkY += ChunkSize)
+				{
+					for (int32 ChunkZ = WorldBounds.Min.Z; ChunkZ < WorldBounds.Max.Z; ChunkZ += ChunkSize)
+					{
+						const FVoxelIntBox Bounds(FIntVector(ChunkX, ChunkY, ChunkZ), FIntVector(ChunkX, ChunkY, ChunkZ) + ChunkSize);
+
+						{
+							const double StartTime = FPlatformTime::Seconds();
+							TVoxelQueryZone<FVoxelValue> QueryZone(Bounds, BatchedValues);
+							Instance->GetValues_Transform(LocalToWorld, QueryZone, 0, FVoxelItemStack::Empty);
+							BatchedTime += FPlatformTime::Seconds() - StartTime;
+						}
+						{
+							const double StartTime = FPlatformTime::Seconds();
+							TVoxelQueryZone<FVoxelValue> QueryZone(Bounds, IndividualValues);
+							for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
+							{
+								for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
+								{
+									for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
+									{
+										QueryZone.Set(X, Y, Z, FVoxelValue(Instance->GetValue_Transform(LocalToWorld, X, Y, Z, 0, FVoxelItemStack::Empty)));
+									}
+								}
+							}
+							IndividualTime += FPlatformTime::Seconds() - StartTime;
+						}
+
+						if (Run == 0)
+						{
+							NumChunks++;
+							for (int32 Index = 0; Index < ChunkSize * ChunkSize * ChunkSize; Index++)
+							{
+								// Stepping can differ from the individual transforms by float rounding
+								if (FMath::Abs(FVoxelUtilities::Get(BatchedValues, Index).ToFloat() - FVoxelUtilities::Get(IndividualValues, Index).ToFloat()) > 0.01f)
+								{
+									NumDifferences++;
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+
+		LOG_VOXEL(Log, TEXT("Transformed data asset queries (%d chunks of size %d): %fms batched, %fms individually (x%.2f); %d values differ"),
+			NumChunks,
+			ChunkSize,
+			BatchedTime * 1000 / NumRuns,
+			IndividualTime * 1000 / NumRuns,
+			IndividualTime / FMath::Max(BatchedTime, 1e-9),
+			NumDifferences);
+	}));
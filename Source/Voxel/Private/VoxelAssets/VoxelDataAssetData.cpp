@@ -4,14 +4,112 @@
 #include "VoxelUtilities/VoxelSerializationUtilities.h"
 #include "VoxelFeedbackContext.h"
 
+#include "HAL/ConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "Serialization/LargeMemoryWriter.h"
+
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelDataAssetMemory);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Data Asset Slabs Loaded"), STAT_VoxelDataAssetSlabsLoaded, STATGROUP_VoxelCounters);
+
+static TAutoConsoleVariable<int32> CVarDataAssetSlabSizeInKB(
+	TEXT("voxel.dataassets.SlabSizeInKB"),
+	256,
+	TEXT("Approximate uncompressed size of the Z slabs data assets are saved in. Smaller slabs let queries decompress less unused data, but compress worse"),
+	ECVF_Default);
+
+struct FVoxelDataAssetSlabs
+{
+	enum EState : int32
+	{
+		Unloaded,
+		Loading,
+		Loaded
+	};
+
+	TVoxelSharedPtr<const TArray<uint8>> Payload;
+	// Start of the compressed slabs in the payload
+	int64 PayloadStart = 0;
+	// Start & end of each slab, relative to PayloadStart
+	TArray<int64> Offsets;
+
+	int32 SlabDepth = 0;
+	uint32 ValueConfigFlag = 0;
+	uint32 MaterialConfigFlag = 0;
+	FVoxelDataAssetDataVersion::Type Version = {};
+
+	// EState, accessed atomically
+	TArray<int32> States;
+};
+
+static FVoxelSerializationVersion::Type GetSerializationVersion(FVoxelDataAssetDataVersion::Type Version)
+{
+	static_assert(FVoxelSerializationVersion::LatestVersion == FVoxelSerializationVersion::SHARED_StoreMaterialChannelsIndividuallyAndRemoveFoliage, "Need to add a new FVoxelDataAssetDataVersion");
+
+	return
+		Version >= FVoxelDataAssetDataVersion::ValueConfigFlagAndSaveGUIDs
+		? FVoxelSerializationVersion::ValueConfigFlagAndSaveGUIDs
+		: Version >= FVoxelDataAssetDataVersion::RemoveEnableVoxelSpawnedActorsEnableVoxelGrass
+		? FVoxelSerializationVersion::RemoveEnableVoxelSpawnedActorsEnableVoxelGrass
+		: FVoxelSerializationVersion::BeforeCustomVersionWasAdded;
+}
+
+// Slabs start on a word boundary in bit arrays, see GetSlabDepth
+static void CopyVoxels(FVoxelBitArray32& Dst, int32 DstStart, const FVoxelBitArray32& Src, int32 SrcStart, int32 Num)
+{
+	constexpr int32 NumBitsPerWord = FVoxelBitArray32::VoxelNumBitsPerDWORD;
+	check(DstStart % NumBitsPerWord == 0 && SrcStart % NumBitsPerWord == 0);
+	check(DstStart + Num <= Dst.Num() && SrcStart + Num <= Src.Num());
+	// The end of the last word is padding when Num isn't a multiple of the word size
+	FMemory::Memcpy(Dst.GetWordData() + DstStart / NumBitsPerWord, Src.GetWordData() + SrcStart / NumBitsPerWord, FMath::DivideAndRoundUp(Num, NumBitsPerWord) * sizeof(uint32));
+}
+template<typename T, typename TAllocator>
+static void CopyVoxels(TArray<T, TAllocator>& Dst, int32 DstStart, const TArray<T, TAllocator>& Src, int32 SrcStart, int32 Num)
+{
+	check(DstStart + Num <= Dst.Num() && SrcStart + Num <= Src.Num());
+	FMemory::Memcpy(Dst.GetData() + DstStart, Src.GetData() + SrcStart, Num * sizeof(T));
+}
+
+static int32 GetSlabDepth(const FIntVector& Size, bool bHasMaterials)
+{
+	const int64 SliceSize = int64(Size.X) * int64(Size.Y);
+	const int64 SliceBytes = SliceSize * (sizeof(FVoxelValue) + (bHasMaterials ? sizeof(FVoxelMaterial) : 0));
+	int32 SlabDepth = int32(FMath::Clamp<int64>(int64(CVarDataAssetSlabSizeInKB.GetValueOnAnyThread()) * 1024 / FMath::Max<int64>(SliceBytes, 1), 1, Size.Z));
+
+	// Slabs must start on a word in bit arrays. Always done, so that payloads can be loaded in the one bit config
+	const int32 Alignment = 32 >> FMath::Min<uint32>(5, FMath::CountTrailingZeros64(SliceSize));
+	SlabDepth = FMath::DivideAndRoundUp(SlabDepth, Alignment) * Alignment;
+
+	return SlabDepth;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelDataAssetData::FVoxelDataAssetData()
+{
+	Values.Add(FVoxelValue::Empty());
+}
+
+FVoxelDataAssetData::~FVoxelDataAssetData()
+{
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelDataAssetMemory, AllocatedSize);
+}
+
 void FVoxelDataAssetData::SetSize(const FIntVector& NewSize, bool bCreateMaterials)
 {
 	VOXEL_FUNCTION_COUNTER();
 	check(int64(NewSize.X) * int64(NewSize.Y) * int64(NewSize.Z) < MAX_int32);
 
 	const int32 Num = NewSize.X * NewSize.Y * NewSize.Z;
+
+	// Slabs being loaded would write to the new arrays
+	check(AreAllSlabsLoaded());
+	Slabs.Reset();
 	
 	// Somewhat thread safe
 	Values.Empty(Num);
@@ -33,16 +131,11 @@ void FVoxelDataAssetData::Serialize(FArchive& Ar, uint32 ValueConfigFlag, uint32
 	
 	FVoxelScopedSlowTask Serializing(2.f);
 	
+	checkf(AreAllSlabsLoaded(), TEXT("Slabs must be loaded first"));
+	
 	Ar << Size;
 
-	const auto SerializationVersion =
-		Version >= FVoxelDataAssetDataVersion::ValueConfigFlagAndSaveGUIDs
-		? FVoxelSerializationVersion::ValueConfigFlagAndSaveGUIDs
-		: Version >= FVoxelDataAssetDataVersion::RemoveEnableVoxelSpawnedActorsEnableVoxelGrass
-		? FVoxelSerializationVersion::RemoveEnableVoxelSpawnedActorsEnableVoxelGrass
-		: FVoxelSerializationVersion::BeforeCustomVersionWasAdded;
-	
-	static_assert(FVoxelSerializationVersion::LatestVersion == FVoxelSerializationVersion::SHARED_StoreMaterialChannelsIndividuallyAndRemoveFoliage, "Need to add a new FVoxelDataAssetDataVersion");
+	const auto SerializationVersion = GetSerializationVersion(Version);
 
 	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Serializing values"));
 	FVoxelSerializationUtilities::SerializeValues(Ar, Values, ValueConfigFlag, SerializationVersion);
@@ -58,6 +151,228 @@ void FVoxelDataAssetData::Serialize(FArchive& Ar, uint32 ValueConfigFlag, uint32
 	UpdateStats();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelDataAssetData::CompressSlabs(TArray<uint8>& OutPayload) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	LoadAllSlabs();
+
+	const int32 SliceSize = Size.X * Size.Y;
+	const int32 SlabDepth = GetSlabDepth(Size, HasMaterials());
+	const int32 NumSlabs = FMath::DivideAndRoundUp(Size.Z, SlabDepth);
+
+	TArray<TArray<uint8>> CompressedSlabs;
+	CompressedSlabs.SetNum(NumSlabs);
+
+	// Already called in parallel by importers, but big assets are usually saved alone
+	ParallelFor(NumSlabs, [&](int32 SlabIndex)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Compress Slab");
+
+		const int32 Start = SlabIndex * SlabDepth * SliceSize;
+		const int32 Num = FMath::Min(SlabDepth, Size.Z - SlabIndex * SlabDepth) * SliceSize;
+
+		FVoxelValueArray SlabValues;
+		SlabValues.Empty(Num);
+		SlabValues.SetNumUninitialized(Num);
+		CopyVoxels(SlabValues, 0, Values, Start, Num);
+
+		TNoGrowArray<FVoxelMaterial> SlabMaterials;
+		if (HasMaterials())
+		{
+			SlabMaterials.Empty(Num);
+			SlabMaterials.SetNumUninitialized(Num);
+			CopyVoxels(SlabMaterials, 0, Materials, Start, Num);
+		}
+
+		FLargeMemoryWriter Writer(Num * (sizeof(FVoxelValue) + (HasMaterials() ? sizeof(FVoxelMaterial) : 0)));
+		FVoxelSerializationUtilities::SerializeValues(Writer, SlabValues, GVoxelValueConfigFlag, FVoxelSerializationVersion::LatestVersion);
+		FVoxelSerializationUtilities::SerializeMaterials(Writer, SlabMaterials, GVoxelMaterialConfigFlag, FVoxelSerializationVersion::LatestVersion);
+
+		FVoxelSerializationUtilities::CompressData(Writer.GetData(), Writer.Tell(), CompressedSlabs[SlabIndex], EVoxelCompressionLevel::VoxelDefault, false);
+	});
+
+	TArray<int64> Offsets;
+	Offsets.Add(0);
+	for (const TArray<uint8>& CompressedSlab : CompressedSlabs)
+	{
+		Offsets.Add(Offsets.Last() + CompressedSlab.Num());
+	}
+
+	OutPayload.Reset();
+
+	FMemoryWriter Writer(OutPayload);
+	FIntVector SizeCopy = Size;
+	int32 SlabDepthCopy = SlabDepth;
+	bool bHasMaterials = HasMaterials();
+	Writer << SizeCopy;
+	Writer << SlabDepthCopy;
+	Writer << bHasMaterials;
+	Writer << Offsets;
+
+	OutPayload.Reserve(OutPayload.Num() + Offsets.Last());
+	for (const TArray<uint8>& CompressedSlab : CompressedSlabs)
+	{
+		OutPayload.Append(CompressedSlab);
+	}
+}
+
+bool FVoxelDataAssetData::InitSlabs(const TVoxelSharedRef<const TArray<uint8>>& Payload, uint32 ValueConfigFlag, uint32 MaterialConfigFlag, FVoxelDataAssetDataVersion::Type Version)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(Version >= FVoxelDataAssetDataVersion::SlabPayload);
+
+	TUniquePtr<FVoxelDataAssetSlabs> NewSlabs = MakeUnique<FVoxelDataAssetSlabs>();
+	NewSlabs->Payload = Payload;
+	NewSlabs->ValueConfigFlag = ValueConfigFlag;
+	NewSlabs->MaterialConfigFlag = MaterialConfigFlag;
+	NewSlabs->Version = Version;
+
+	FIntVector NewSize;
+	bool bHasMaterials = false;
+
+	FMemoryReader Reader(*Payload);
+	Reader << NewSize;
+	Reader << NewSlabs->SlabDepth;
+	Reader << bHasMaterials;
+	Reader << NewSlabs->Offsets;
+	NewSlabs->PayloadStart = Reader.Tell();
+
+	const int32 NumSlabs = NewSlabs->Offsets.Num() - 1;
+	if (Reader.IsError() ||
+		NewSize.GetMin() <= 0 ||
+		int64(NewSize.X) * int64(NewSize.Y) * int64(NewSize.Z) >= MAX_int32 ||
+		NewSlabs->SlabDepth <= 0 ||
+		NumSlabs != FMath::DivideAndRoundUp(NewSize.Z, NewSlabs->SlabDepth) ||
+		NewSlabs->PayloadStart + NewSlabs->Offsets.Last() != Payload->Num())
+	{
+		return false;
+	}
+
+	// Uninitialized: the pages of slabs that are never loaded are usually never committed
+	SetSize(NewSize, bHasMaterials);
+
+	NewSlabs->States.SetNumZeroed(NumSlabs);
+	static_assert(FVoxelDataAssetSlabs::Unloaded == 0, "");
+
+	Slabs = MoveTemp(NewSlabs);
+	FPlatformAtomics::InterlockedExchange(&NumSlabsToLoad, NumSlabs);
+
+	return true;
+}
+
+void FVoxelDataAssetData::LoadAllSlabs() const
+{
+	if (AreAllSlabsLoaded())
+	{
+		return;
+	}
+
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	ParallelFor(Slabs->States.Num(), [&](int32 SlabIndex)
+	{
+		LoadSlab(SlabIndex);
+	});
+	ensure(AreAllSlabsLoaded());
+}
+
+void FVoxelDataAssetData::LoadSlabsImpl(int32 MinZ, int32 MaxZ) const
+{
+	checkVoxelSlow(Slabs.IsValid());
+
+	MinZ = FMath::Max(MinZ, 0);
+	MaxZ = FMath::Min(MaxZ, Size.Z - 1);
+
+	if (MinZ > MaxZ)
+	{
+		// Query outside of the asset: nothing to load
+		return;
+	}
+
+	for (int32 SlabIndex = MinZ / Slabs->SlabDepth; SlabIndex <= MaxZ / Slabs->SlabDepth; SlabIndex++)
+	{
+		LoadSlab(SlabIndex);
+	}
+}
+
+void FVoxelDataAssetData::LoadSlab(int32 SlabIndex) const
+{
+	int32& State = Slabs->States[SlabIndex];
+	if (FPlatformAtomics::AtomicRead(&State) == FVoxelDataAssetSlabs::Loaded)
+	{
+		return;
+	}
+
+	if (FPlatformAtomics::InterlockedCompareExchange(&State, FVoxelDataAssetSlabs::Loading, FVoxelDataAssetSlabs::Unloaded) != FVoxelDataAssetSlabs::Unloaded)
+	{
+		// Being loaded by another thread. Slabs are small, no need for anything smarter than spinning
+		while (FPlatformAtomics::AtomicRead(&State) != FVoxelDataAssetSlabs::Loaded)
+		{
+			FPlatformProcess::Yield();
+		}
+		return;
+	}
+
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	const int32 SliceSize = Size.X * Size.Y;
+	const int32 Start = SlabIndex * Slabs->SlabDepth * SliceSize;
+	const int32 Num = FMath::Min(Slabs->SlabDepth, Size.Z - SlabIndex * Slabs->SlabDepth) * SliceSize;
+
+	FVoxelValueArray SlabValues;
+	TNoGrowArray<FVoxelMaterial> SlabMaterials;
+
+	TArray64<uint8> UncompressedData;
+	const int64 Offset = Slabs->PayloadStart + Slabs->Offsets[SlabIndex];
+	const int64 CompressedSize = Slabs->Offsets[SlabIndex + 1] - Slabs->Offsets[SlabIndex];
+	bool bSuccess = FVoxelSerializationUtilities::DecompressData(Slabs->Payload->GetData() + Offset, CompressedSize, UncompressedData, false);
+	if (bSuccess)
+	{
+		FLargeMemoryReader Reader(UncompressedData.GetData(), UncompressedData.Num());
+		const auto SerializationVersion = GetSerializationVersion(Slabs->Version);
+		FVoxelSerializationUtilities::SerializeValues(Reader, SlabValues, Slabs->ValueConfigFlag, SerializationVersion);
+		FVoxelSerializationUtilities::SerializeMaterials(Reader, SlabMaterials, Slabs->MaterialConfigFlag, SerializationVersion);
+
+		bSuccess =
+			!Reader.IsError() &&
+			SlabValues.Num() == Num &&
+			SlabMaterials.Num() == (HasMaterials() ? Num : 0);
+	}
+
+	// Only this thread writes to the slab, and nobody reads it until it's marked as loaded
+	FVoxelDataAssetData& This = const_cast<FVoxelDataAssetData&>(*this);
+	if (ensureMsgf(bSuccess, TEXT("Data asset slab %d is corrupted"), SlabIndex))
+	{
+		CopyVoxels(This.Values, Start, SlabValues, 0, Num);
+		if (HasMaterials())
+		{
+			CopyVoxels(This.Materials, Start, SlabMaterials, 0, Num);
+		}
+	}
+	else
+	{
+		for (int32 Index = Start; Index < Start + Num; Index++)
+		{
+			FVoxelUtilities::Get(This.Values, Index) = FVoxelValue::Empty();
+		}
+		for (int32 Index = Start; Index < Start + Num && HasMaterials(); Index++)
+		{
+			This.Materials[Index] = FVoxelMaterial::Default();
+		}
+	}
+
+	INC_DWORD_STAT(STAT_VoxelDataAssetSlabsLoaded);
+	FPlatformAtomics::InterlockedExchange(&State, FVoxelDataAssetSlabs::Loaded);
+	FPlatformAtomics::InterlockedDecrement(&NumSlabsToLoad);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 void FVoxelDataAssetData::UpdateStats() const
 {
 	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelDataAssetMemory, AllocatedSize);
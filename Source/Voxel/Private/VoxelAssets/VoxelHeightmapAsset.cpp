@@ -8,6 +8,7 @@
 #include "VoxelUtilities/VoxelSerializationUtilities.h"
 #include "VoxelGenerators/VoxelEmptyGenerator.h"
 #include "VoxelGenerators/VoxelTransformableGeneratorHelper.h"
+#include "VoxelGenerators/VoxelGeneratorInstanceCache.h"
 
 #include "Serialization/LargeMemoryReader.h"
 #include "Serialization/LargeMemoryWriter.h"
@@ -19,6 +20,18 @@
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelHeightmapAssetMemory);
 
+VOXEL_API TAutoConsoleVariable<int32> CVarHeightmapResidentTilesBudget(
+		TEXT("voxel.heightmaps.ResidentTilesBudget"),
+		1024,
+		TEXT("Max number of decompressed tiles kept in memory per heightmap asset. A 256x256 tile of a float heightmap without materials uses 256KB"),
+		ECVF_Default);
+
+VOXEL_API uint64 NewHeightmapAssetDataId()
+{
+	static FThreadSafeCounter64 Counter;
+	return Counter.Increment();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -72,11 +85,24 @@ void UVoxelHeightmapAsset::SaveData(const TVoxelHeightmapAssetData<T>& Data)
 	const_cast<TVoxelHeightmapAssetData<T>&>(Data).Serialize(MemoryWriter, MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type(VoxelCustomVersion), bNeedToSave);
 	ensure(!bNeedToSave);
 	
-	Saving.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Compressing"));
-	FVoxelSerializationUtilities::CompressData(MemoryWriter, CompressedData);
+	// The tiles are already compressed: store the data as is, to be able to read it without decompressing everything
+	Saving.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Copying"));
+	if (ensure(MemoryWriter.TotalSize() < MAX_int32))
+	{
+		CompressedData.SetNumUninitialized(MemoryWriter.TotalSize());
+		FMemory::Memcpy(CompressedData.GetData(), MemoryWriter.GetData(), MemoryWriter.TotalSize());
+	}
+	else
+	{
+		FVoxelMessages::Error("Heightmap is too big to be saved", this);
+		CompressedData.Empty();
+	}
 
 	SyncProperties(Data);
 
+	// Don't share the instances using the old data with new users
+	FVoxelGeneratorInstanceCache::Invalidate(this);
+
 #if WITH_EDITOR
 	// Clear thumbnail
 	ThumbnailSave.Reset();
@@ -93,13 +119,19 @@ void UVoxelHeightmapAsset::LoadData(TVoxelHeightmapAssetData<T>& Data)
 		return;
 	}
 	TArray64<uint8> UncompressedData;
-	if (!FVoxelSerializationUtilities::DecompressData(CompressedData, UncompressedData))
+	if (VoxelCustomVersion < FVoxelHeightmapAssetDataVersion::TiledStorage)
 	{
-		FVoxelMessages::Error("Decompression failed, data is corrupted", this);
-		return;
+		if (!FVoxelSerializationUtilities::DecompressData(CompressedData, UncompressedData))
+		{
+			FVoxelMessages::Error("Decompression failed, data is corrupted", this);
+			return;
+		}
 	}
 
-	FLargeMemoryReader MemoryReader(UncompressedData.GetData(), UncompressedData.Num());
+	// Since TiledStorage, the data is made of compressed tiles and isn't compressed as a whole
+	FLargeMemoryReader MemoryReader(
+		UncompressedData.Num() > 0 ? UncompressedData.GetData() : CompressedData.GetData(),
+		UncompressedData.Num() > 0 ? UncompressedData.Num() : CompressedData.Num());
 
 	bool bNeedToSave = false;
 	Data.Serialize(MemoryReader, MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type(VoxelCustomVersion), bNeedToSave);
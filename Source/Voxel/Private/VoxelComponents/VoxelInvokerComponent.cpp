@@ -45,6 +45,12 @@ FVoxelInvokerSettings UVoxelInvokerComponentBase::GetInvokerSettings_Implementat
 	return {};
 }
 
+FVector UVoxelInvokerComponentBase::GetInvokerVelocity_Implementation() const
+{
+	const AActor* Owner = GetOwner();
+	return Owner ? Owner->GetVelocity() : FVector::ZeroVector;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
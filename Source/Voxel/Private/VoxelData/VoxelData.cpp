@@ -31,6 +31,18 @@ VOXEL_API TAutoConsoleVariable<int32> CVarStoreSpecialValueForGeneratorValuesInS
 		TEXT("Important: must be the same when saving & loading!"),
 		ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarIsEmptyFromSamplesMaxSamples(
+		TEXT("voxel.data.IsEmptyFromSamples.MaxSamples"),
+		512,
+		TEXT("Max number of generator samples to use when proving that a chunk has no surface. If more are needed, the chunk is computed normally"),
+		ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarIsEmptyFromSamplesMinCellSize(
+		TEXT("voxel.data.IsEmptyFromSamples.MinCellSize"),
+		4,
+		TEXT("Size, relative to the LOD step, below which the sampling lattice isn't refined anymore"),
+		ECVF_Default);
+
 DEFINE_STAT(STAT_NumVoxelAssetItems);
 DEFINE_STAT(STAT_NumVoxelDisableEditsItems);
 DEFINE_STAT(STAT_NumVoxelDataItems);
@@ -458,60 +470,180 @@ TVoxelRange<FVoxelValue> FVoxelData::GetValueRange(const FVoxelIntBox& InBounds,
 			}
 		}
 
-		auto& ItemHolder = Tree.GetItemHolder();
+		return GetGeneratorValueRange(Tree, QueryBounds, LOD);
+	};
+	const auto Reduction = [](auto RangeA, auto RangeB)
+	{
+		return TVoxelRange<FVoxelValue>::Union(RangeA, RangeB);
+	};
+	
+	// Note: even if WorldBounds doesn't contain InBounds, we don't need to check other values are the queries are always clamped to world bounds
+	const auto Result = FVoxelOctreeUtilities::ReduceInBounds<TVoxelRange<FVoxelValue>>(GetOctree(), WorldBounds.Clamp(InBounds), Apply, Reduction);
+	
+	ensure(Result.IsSet());
+	return Result.Get(FVoxelValue::Empty());
+}
 
-		TOptional<TVoxelRange<FVoxelValue>> Range;
-		for (int32 Index = ItemHolder.GetAssetItems().Num() - 1; Index >= 0; Index--)
+bool FVoxelData::IsEmptyFromSamples(const FVoxelIntBox& Bounds, int32 LOD) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	if (!WorldBounds.Contains(Bounds))
+	{
+		// Queries outside the world are clamped
+		return false;
+	}
+
+	v_flt Lipschitz = 0;
+	if (!Generator->GetValueLipschitzConstant(Bounds, LOD, Lipschitz) || !ensure(Lipschitz >= 0))
+	{
+		return false;
+	}
+
+	// Only the generator values are bounded: give up on any item, edit or cached value
+	const bool bGeneratorOnly = FVoxelOctreeUtilities::IterateTreeInBoundsEarlyExit(GetOctree(), Bounds, [&](FVoxelDataOctreeBase& Tree)
+	{
+		if (Tree.GetItemHolder().NumItems() > 0)
 		{
-			auto& Asset = *ItemHolder.GetAssetItems()[Index];
+			return false;
+		}
+		if (Tree.IsLeaf() && Tree.AsLeaf().GetData<FVoxelValue>().HasData())
+		{
+			return false;
+		}
+		return true;
+	});
+	if (!bGeneratorOnly)
+	{
+		return false;
+	}
 
-			if (!Asset.Bounds.Intersect(QueryBounds)) continue;
+	const int32 Step = 1 << LOD;
+	const int32 MinCellSize = Step * FMath::Max(1, CVarIsEmptyFromSamplesMinCellSize.GetValueOnAnyThread());
+	const int32 MaxSamples = CVarIsEmptyFromSamplesMaxSamples.GetValueOnAnyThread();
 
-			const auto AssetRangeFlt = Asset.Generator->GetValueRange_Transform(
-				Asset.LocalToWorld,
-				Asset.Bounds.Overlap(QueryBounds),
-				LOD,
-				FVoxelItemStack(ItemHolder, *Generator, Index));
-			const auto AssetRange = TVoxelRange<FVoxelValue>(AssetRangeFlt);
+	// Make sure values close to 0 can't be rounded to the other sign when converted to FVoxelValue
+	// Bigger than the quantization step of all the value configs
+	constexpr v_flt Margin = 0.01f;
 
-			if (!Range.IsSet())
-			{
-				Range = AssetRange;
-			}
-			else
+	TMap<FIntVector, v_flt> Samples;
+	Samples.Reserve(MaxSamples);
+	const auto GetSample = [&](const FIntVector& Position)
+	{
+		if (const v_flt* Sample = Samples.Find(Position))
+		{
+			return *Sample;
+		}
+		const v_flt Value = Generator->GetValue(Position.X, Position.Y, Position.Z, LOD, FVoxelItemStack::Empty);
+		Samples.Add(Position, Value);
+		return Value;
+	};
+
+	const bool bIsEmpty = GetSample(Bounds.Min) > 0;
+
+	struct FCell
+	{
+		FIntVector Min;
+		int32 Size;
+	};
+	TArray<FCell, TInlineAllocator<64>> Cells;
+	Cells.Add({ Bounds.Min, int32(FMath::RoundUpToPowerOfTwo(FMath::Max(1, Bounds.Size().GetMax()))) });
+
+	while (Cells.Num() > 0)
+	{
+		const FCell Cell = Cells.Pop(false);
+
+		v_flt MinAbsValue = MAX_vflt;
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			const FIntVector Position = Cell.Min + FIntVector(bool(Corner & 1), bool(Corner & 2), bool(Corner & 4)) * Cell.Size;
+			const v_flt Value = GetSample(Position);
+			if ((Value > 0) != bIsEmpty)
 			{
-				Range = TVoxelRange<FVoxelValue>::Union(Range.GetValue(), AssetRange);
+				// There's a surface in there
+				return false;
 			}
+			MinAbsValue = FMath::Min(MinAbsValue, FMath::Abs(Value));
+		}
 
-			if (Asset.Bounds.Contains(QueryBounds))
+		if (Samples.Num() > MaxSamples)
+		{
+			return false;
+		}
+
+		// Any point of the cell is at most half a diagonal away from a corner, so it can't reach 0
+		const v_flt HalfDiagonal = Cell.Size * v_flt(0.8660254037844386);
+		if (MinAbsValue > Lipschitz * HalfDiagonal + Margin)
+		{
+			continue;
+		}
+
+		const int32 ChildSize = Cell.Size / 2;
+		if (ChildSize < MinCellSize)
+		{
+			// Dense evaluation will be about as fast
+			return false;
+		}
+		for (int32 Child = 0; Child < 8; Child++)
+		{
+			const FIntVector ChildMin = Cell.Min + FIntVector(bool(Child & 1), bool(Child & 2), bool(Child & 4)) * ChildSize;
+			if (FVoxelIntBox(ChildMin, ChildMin + ChildSize).Intersect(Bounds))
 			{
-				// This one is covering everything, no need to continue deeper in the stack nor to check the generator
-				return Range.GetValue();
+				Cells.Add({ ChildMin, ChildSize });
 			}
 		}
-		
-		// Note: need to query individual bounds as ItemHolder might be different
-		const auto GeneratorRangeFlt = Generator->GetValueRange(QueryBounds, LOD, FVoxelItemStack(ItemHolder));
-		const auto GeneratorRange = TVoxelRange<FVoxelValue>(GeneratorRangeFlt);
+	}
+
+	return true;
+}
+
+TVoxelRange<FVoxelValue> FVoxelData::GetGeneratorValueRange(const FVoxelDataOctreeBase& Tree, const FVoxelIntBox& Bounds, int32 LOD) const
+{
+	ensureVoxelSlowNoSideEffects(Tree.GetBounds().Contains(Bounds));
+	
+	auto& ItemHolder = Tree.GetItemHolder();
+
+	TOptional<TVoxelRange<FVoxelValue>> Range;
+	for (int32 Index = ItemHolder.GetAssetItems().Num() - 1; Index >= 0; Index--)
+	{
+		auto& Asset = *ItemHolder.GetAssetItems()[Index];
+
+		if (!Asset.Bounds.Intersect(Bounds)) continue;
+
+		const auto AssetRangeFlt = Asset.Generator->GetValueRange_Transform(
+			Asset.LocalToWorld,
+			Asset.Bounds.Overlap(Bounds),
+			LOD,
+			FVoxelItemStack(ItemHolder, *Generator, Index));
+		const auto AssetRange = TVoxelRange<FVoxelValue>(AssetRangeFlt);
+
 		if (!Range.IsSet())
 		{
-			return GeneratorRange;
+			Range = AssetRange;
 		}
 		else
 		{
-			return TVoxelRange<FVoxelValue>::Union(Range.GetValue(), GeneratorRange);
+			Range = TVoxelRange<FVoxelValue>::Union(Range.GetValue(), AssetRange);
 		}
-	};
-	const auto Reduction = [](auto RangeA, auto RangeB)
-	{
-		return TVoxelRange<FVoxelValue>::Union(RangeA, RangeB);
-	};
-	
-	// Note: even if WorldBounds doesn't contain InBounds, we don't need to check other values are the queries are always clamped to world bounds
-	const auto Result = FVoxelOctreeUtilities::ReduceInBounds<TVoxelRange<FVoxelValue>>(GetOctree(), WorldBounds.Clamp(InBounds), Apply, Reduction);
+
+		if (Asset.Bounds.Contains(Bounds))
+		{
+			// This one is covering everything, no need to continue deeper in the stack nor to check the generator
+			return Range.GetValue();
+		}
+	}
 	
-	ensure(Result.IsSet());
-	return Result.Get(FVoxelValue::Empty());
+	// Note: need to query individual bounds as ItemHolder might be different
+	const auto GeneratorRangeFlt = Generator->GetValueRange(Bounds, LOD, FVoxelItemStack(ItemHolder));
+	const auto GeneratorRange = TVoxelRange<FVoxelValue>(GeneratorRangeFlt);
+	if (!Range.IsSet())
+	{
+		return GeneratorRange;
+	}
+	else
+	{
+		return TVoxelRange<FVoxelValue>::Union(Range.GetValue(), GeneratorRange);
+	}
 }
 
 TVoxelRange<v_flt> FVoxelData::GetCustomOutputRange(TVoxelRange<v_flt> DefaultValue, FName Name, const FVoxelIntBox& InBounds, int32 LOD) const
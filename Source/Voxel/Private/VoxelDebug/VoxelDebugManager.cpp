@@ -304,6 +304,7 @@ bool FVoxelGlobalDebugManager::Tick(float DeltaTime)
 		Counters.GetNumTasksForType(EVoxelTaskType::VisibleChunksMeshing) +
 		Counters.GetNumTasksForType(EVoxelTaskType::CollisionsChunksMeshing) +
 		Counters.GetNumTasksForType(EVoxelTaskType::VisibleCollisionsChunksMeshing) +
+		Counters.GetNumTasksForType(EVoxelTaskType::EditChunksMeshing) +
 		Counters.GetNumTasksForType(EVoxelTaskType::MeshMerge);
 
 	const int32 FoliageTaskCount =
@@ -5,8 +5,11 @@
 #include "VoxelDebug/VoxelDebugUtilities.h"
 #include "VoxelUtilities/VoxelThreadingUtilities.h"
 #include "VoxelWorld.h"
+#include "VoxelPool.h"
 #include "VoxelMinimal.h"
 
+#include "Async/ParallelFor.h"
+
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Voxel Events"), STAT_NumVoxelEvents, STATGROUP_VoxelCounters);
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Voxel Event Manager - Num active or generated chunks"), STAT_VoxelEventManager_NumActiveOrGeneratedChunks, STATGROUP_VoxelCounters);
 
@@ -22,12 +25,353 @@ static TAutoConsoleVariable<int32> CVarShowEventsBounds(
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+class FVoxelEventsAsyncUpdater : public FVoxelAsyncWork
+{
+	GENERATED_VOXEL_ASYNC_WORK_BODY(FVoxelEventsAsyncUpdater)
+
+public:
+	using FEventKey = FVoxelEventManager::FEventKey;
+	
+	struct FInput
+	{
+		FEventKey EventKey;
+		uint64 EventId = 0;
+		bool bGenerationEvent = false;
+		// If false, InvokerPositions are in the same order as in the previous update of this event
+		bool bInvokersChanged = false;
+		TArray<FIntVector> InvokerPositions;
+	};
+	struct FOutput
+	{
+		FEventKey EventKey;
+		uint64 EventId = 0;
+		TArray<FIntVector> ChunksToActivate;
+		TArray<FIntVector> ChunksToDeactivate;
+	};
+	TArray<FOutput> Outputs;
+
+	explicit FVoxelEventsAsyncUpdater(const FVoxelIntBox& WorldBounds)
+		: FVoxelAsyncWork(STATIC_FNAME("Events Update"), EVoxelTaskType::RenderOctree, EPriority::Null)
+		, WorldBounds(WorldBounds)
+	{
+		SetIsDone(true);
+	}
+
+	void Init(TArray<FInput>&& InInputs, TArray<uint64>&& InRemovedEventIds)
+	{
+		VOXEL_FUNCTION_COUNTER();
+		check(IsDone());
+
+		Inputs = MoveTemp(InInputs);
+		RemovedEventIds = MoveTemp(InRemovedEventIds);
+		Outputs.Reset();
+
+		SetIsDone(false);
+	}
+
+private:
+	//~ Begin FVoxelAsyncWork Interface
+	virtual void DoWork() override
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		for (const uint64 EventId : RemovedEventIds)
+		{
+			States.Remove(EventId);
+		}
+		RemovedEventIds.Reset();
+
+		// Add the states first, so that they are not reallocated in the parallel for
+		TArray<FEventState*> EventStates;
+		for (const FInput& Input : Inputs)
+		{
+			EventStates.Add(&States.FindOrAdd(Input.EventId));
+		}
+
+		Outputs.SetNum(Inputs.Num());
+		ParallelFor(Inputs.Num(), [&](int32 Index)
+		{
+			UpdateEvent(Inputs[Index], *EventStates[Index], Outputs[Index]);
+		}, Inputs.Num() < 2);
+
+		Inputs.Reset();
+	}
+	//~ End FVoxelAsyncWork Interface
+
+private:
+	const FVoxelIntBox WorldBounds;
+
+	TArray<FInput> Inputs;
+	TArray<uint64> RemovedEventIds;
+
+	// Only accessed by DoWork
+	struct FEventState
+	{
+		TArray<FIntVector> InvokerPositions;
+		// Union of the chunks in range of InvokerPositions, or all the chunks generated so far for generation events
+		FVoxelEventChunkSet Chunks;
+	};
+	TMap<uint64, FEventState> States;
+
+	// The chunks in range of an invoker: within its cube of DistanceInChunks, intersecting the world and closer than DistanceInChunks * ChunkSize
+	// For a given (X, Y) these chunks form a Z range, which allows to only visit the chunks entering or leaving the range when an invoker moves
+	struct FRange
+	{
+		const int32 ChunkSize;
+		const int32 DistanceInVoxels;
+		FIntVector WorldMinChunk;
+		FIntVector WorldMaxChunk; // Inclusive
+
+		FRange(int32 ChunkSize, int32 DistanceInChunks, const FVoxelIntBox& WorldBounds)
+			: ChunkSize(ChunkSize)
+			, DistanceInVoxels(ChunkSize * DistanceInChunks)
+		{
+			// Chunks strictly intersecting WorldBounds
+			WorldMinChunk = FVoxelUtilities::DivideFloor(WorldBounds.Min, ChunkSize);
+			WorldMaxChunk = FVoxelUtilities::DivideCeil(WorldBounds.Max, ChunkSize) - 1;
+		}
+
+		// Inclusive
+		void GetCube(const FIntVector& Position, FIntVector& OutMin, FIntVector& OutMax) const
+		{
+			OutMin = FVoxelUtilities::ComponentMax(WorldMinChunk, FVoxelUtilities::DivideFloor(Position - DistanceInVoxels, ChunkSize));
+			// Max is exclusive, since this is the coordinate of the Bounds.Min of the chunk
+			OutMax = FVoxelUtilities::ComponentMin(WorldMaxChunk, FVoxelUtilities::DivideCeil(Position + DistanceInVoxels, ChunkSize) - 1);
+		}
+
+		// Distance between Position and the chunk bounds along one axis
+		int64 GetAxisDistance(int32 Position, int32 Chunk) const
+		{
+			const int64 Min = int64(Chunk) * ChunkSize;
+			const int64 Max = Min + ChunkSize;
+			if (Position < Min)
+			{
+				return Min - Position;
+			}
+			if (Position > Max)
+			{
+				return Position - Max;
+			}
+			return 0;
+		}
+
+		// Inclusive. Returns false if the column has no chunk in range
+		bool GetColumn(const FIntVector& Position, int32 X, int32 Y, int32& OutZMin, int32& OutZMax) const
+		{
+			FIntVector CubeMin;
+			FIntVector CubeMax;
+			GetCube(Position, CubeMin, CubeMax);
+
+			if (X < CubeMin.X || X > CubeMax.X ||
+				Y < CubeMin.Y || Y > CubeMax.Y ||
+				CubeMin.Z > CubeMax.Z)
+			{
+				return false;
+			}
+
+			const int64 Budget = FMath::Square<int64>(DistanceInVoxels) - FMath::Square(GetAxisDistance(Position.X, X)) - FMath::Square(GetAxisDistance(Position.Y, Y));
+			if (Budget < 0)
+			{
+				return false;
+			}
+
+			// Largest Z distance such that the squared distance is <= Budget
+			int64 MaxDistanceZ = FMath::FloorToInt(FMath::Sqrt(double(Budget)));
+			while (FMath::Square(MaxDistanceZ + 1) <= Budget) MaxDistanceZ++;
+			while (FMath::Square(MaxDistanceZ) > Budget) MaxDistanceZ--;
+
+			// Chunks above: Z * ChunkSize - Position.Z <= MaxDistanceZ
+			// Chunks below: Position.Z - (Z + 1) * ChunkSize <= MaxDistanceZ
+			// MaxDistanceZ <= DistanceInVoxels, so this fits in an int32 like the cube
+			const int32 ZMin = FVoxelUtilities::DivideCeil(Position.Z - int32(MaxDistanceZ), ChunkSize) - 1;
+			const int32 ZMax = FVoxelUtilities::DivideFloor(Position.Z + int32(MaxDistanceZ), ChunkSize);
+
+			OutZMin = FMath::Max(ZMin, CubeMin.Z);
+			OutZMax = FMath::Min(ZMax, CubeMax.Z);
+			return OutZMin <= OutZMax;
+		}
+
+		bool IsInRange(const FIntVector& Position, const FIntVector& Chunk) const
+		{
+			int32 ZMin;
+			int32 ZMax;
+			return GetColumn(Position, Chunk.X, Chunk.Y, ZMin, ZMax) && ZMin <= Chunk.Z && Chunk.Z <= ZMax;
+		}
+
+		template<typename T>
+		void IterateChunks(const FIntVector& Position, T Lambda) const
+		{
+			FIntVector CubeMin;
+			FIntVector CubeMax;
+			GetCube(Position, CubeMin, CubeMax);
+
+			for (int32 X = CubeMin.X; X <= CubeMax.X; X++)
+			{
+				for (int32 Y = CubeMin.Y; Y <= CubeMax.Y; Y++)
+				{
+					int32 ZMin;
+					int32 ZMax;
+					if (GetColumn(Position, X, Y, ZMin, ZMax))
+					{
+						for (int32 Z = ZMin; Z <= ZMax; Z++)
+						{
+							Lambda(FIntVector(X, Y, Z));
+						}
+					}
+				}
+			}
+		}
+
+		// Iterate the chunks in range of NewPosition but not of OldPosition
+		template<typename T>
+		void IterateEnteringChunks(const FIntVector& OldPosition, const FIntVector& NewPosition, T Lambda) const
+		{
+			FIntVector CubeMin;
+			FIntVector CubeMax;
+			GetCube(NewPosition, CubeMin, CubeMax);
+
+			for (int32 X = CubeMin.X; X <= CubeMax.X; X++)
+			{
+				for (int32 Y = CubeMin.Y; Y <= CubeMax.Y; Y++)
+				{
+					int32 NewZMin;
+					int32 NewZMax;
+					if (!GetColumn(NewPosition, X, Y, NewZMin, NewZMax))
+					{
+						continue;
+					}
+
+					int32 OldZMin;
+					int32 OldZMax;
+					if (!GetColumn(OldPosition, X, Y, OldZMin, OldZMax))
+					{
+						// Empty range
+						OldZMin = NewZMax + 1;
+						OldZMax = NewZMax;
+					}
+
+					// At most two slabs
+					for (int32 Z = NewZMin; Z <= FMath::Min(NewZMax, OldZMin - 1); Z++)
+					{
+						Lambda(FIntVector(X, Y, Z));
+					}
+					for (int32 Z = FMath::Max(NewZMin, OldZMax + 1); Z <= NewZMax; Z++)
+					{
+						Lambda(FIntVector(X, Y, Z));
+					}
+				}
+			}
+		}
+	};
+
+	void UpdateEvent(const FInput& Input, FEventState& State, FOutput& Output) const
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		Output.EventKey = Input.EventKey;
+		Output.EventId = Input.EventId;
+
+		const FRange Range(Input.EventKey.ChunkSize, Input.EventKey.Distance, WorldBounds);
+
+		if (Input.bInvokersChanged || State.InvokerPositions.Num() != Input.InvokerPositions.Num())
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Full update");
+
+			FVoxelEventChunkSet NewChunks;
+			for (const FIntVector& Position : Input.InvokerPositions)
+			{
+				Range.IterateChunks(Position, [&](const FIntVector& Chunk) { NewChunks.Add(Chunk); });
+			}
+
+			FVoxelEventChunkSet::IterateDifference(NewChunks, State.Chunks, [&](const FIntVector& Chunk) { Output.ChunksToActivate.Add(Chunk); });
+
+			if (Input.bGenerationEvent)
+			{
+				for (const FIntVector& Chunk : Output.ChunksToActivate)
+				{
+					State.Chunks.Add(Chunk);
+				}
+			}
+			else
+			{
+				FVoxelEventChunkSet::IterateDifference(State.Chunks, NewChunks, [&](const FIntVector& Chunk) { Output.ChunksToDeactivate.Add(Chunk); });
+				State.Chunks = MoveTemp(NewChunks);
+			}
+		}
+		else
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Delta update");
+
+			TArray<FIntVector> LeavingChunks;
+			for (int32 Index = 0; Index < Input.InvokerPositions.Num(); Index++)
+			{
+				const FIntVector& OldPosition = State.InvokerPositions[Index];
+				const FIntVector& NewPosition = Input.InvokerPositions[Index];
+				if (OldPosition == NewPosition)
+				{
+					continue;
+				}
+
+				Range.IterateEnteringChunks(OldPosition, NewPosition, [&](const FIntVector& Chunk)
+				{
+					if (State.Chunks.Add(Chunk))
+					{
+						Output.ChunksToActivate.Add(Chunk);
+					}
+				});
+
+				if (!Input.bGenerationEvent)
+				{
+					Range.IterateEnteringChunks(NewPosition, OldPosition, [&](const FIntVector& Chunk) { LeavingChunks.Add(Chunk); });
+				}
+			}
+
+			// A chunk leaving the range of an invoker might still be in the range of another one
+			for (const FIntVector& Chunk : LeavingChunks)
+			{
+				if (!State.Chunks.Contains(Chunk))
+				{
+					// Already removed
+					continue;
+				}
+
+				bool bInRange = false;
+				for (const FIntVector& Position : Input.InvokerPositions)
+				{
+					if (Range.IsInRange(Position, Chunk))
+					{
+						bInRange = true;
+						break;
+					}
+				}
+
+				if (!bInRange)
+				{
+					State.Chunks.Remove(Chunk);
+					Output.ChunksToDeactivate.Add(Chunk);
+				}
+			}
+		}
+
+		State.InvokerPositions = Input.InvokerPositions;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 DEFINE_VOXEL_SUBSYSTEM_PROXY(UVoxelEventSubsystemProxy);
 
 void FVoxelEventManager::Create()
 {
 	Super::Create();
 	
+	Task = MakeVoxelAsyncWork<FVoxelEventsAsyncUpdater>(Settings.GetWorldBounds());
 	UVoxelInvokerComponentBase::OnForceRefreshInvokers.AddThreadSafeSP(this, &FVoxelEventManager::ClearOldInvokerComponents);
 }
 
@@ -36,6 +380,12 @@ void FVoxelEventManager::Destroy()
 	Super::Destroy();
 	
 	StopTicking();
+
+	if (Task.IsValid() && !Task->IsDone())
+	{
+		Task->CancelAndAutodelete();
+		Task.Release();
+	}
 }
 
 FVoxelEventManager::~FVoxelEventManager()
@@ -69,7 +419,7 @@ FVoxelEventHandle FVoxelEventManager::BindEvent(
 	auto& EventInfo = Events.FindOrAdd(EventKey);
 	if (!EventInfo.IsValid())
 	{
-		EventInfo = MakeUnique<FEventInfo>(ChunkSize, DistanceInChunks, Flags);
+		EventInfo = MakeUnique<FEventInfo>(++EventIdCounter, ChunkSize, DistanceInChunks, Flags);
 	}
 
 	FVoxelEventHandle Handle;
@@ -130,6 +480,7 @@ void FVoxelEventManager::UnbindEvent(FVoxelEventHandle Handle)
 
 	if (!Event.OnActivate.IsBound() && !Event.OnDeactivate.IsBound())
 	{
+		RemovedEventIds.Add(Event.Id);
 		Events.Remove(EventKey);
 		EventsInvokers.Remove(EventKey);
 	}
@@ -143,8 +494,14 @@ void FVoxelEventManager::Tick(float DeltaTime)
 {
 	VOXEL_FUNCTION_COUNTER();
 
+	if (bAsyncTaskWorking && Task->IsDone())
+	{
+		bAsyncTaskWorking = false;
+		FireDelegates();
+	}
+
 	const double Time = FPlatformTime::Seconds();
-	if (Time - LastUpdateTime > 1. / Settings.EventsTickRate)
+	if (!bAsyncTaskWorking && Time - LastUpdateTime > 1. / Settings.EventsTickRate)
 	{
 		LastUpdateTime = Time;
 		Update();
@@ -169,7 +526,7 @@ void FVoxelEventManager::Update()
 
 	const auto GetInvokerPosition = [&](auto& Invoker) { return Invoker->GetInvokerVoxelPosition(Settings.VoxelWorld.Get()); };
 
-	TArray<TPair<FEventKey, TArray<FIntVector>>> InvokersToUpdate;
+	TArray<FVoxelEventsAsyncUpdater::FInput> Inputs;
 	if (NewInvokerComponents != OldInvokerComponents)
 	{
 		OldInvokerComponents = NewInvokerComponents;
@@ -198,7 +555,12 @@ void FVoxelEventManager::Update()
 				Positions.Add(Position);
 			}
 
-			InvokersToUpdate.Emplace(EventKey, MoveTemp(Positions));
+			FVoxelEventsAsyncUpdater::FInput& Input = Inputs.Emplace_GetRef();
+			Input.EventKey = EventKey;
+			Input.EventId = EventInfo.Id;
+			Input.bGenerationEvent = (EventInfo.Flags & EVoxelEventFlags::GenerationEvent) != 0;
+			Input.bInvokersChanged = true;
+			Input.InvokerPositions = MoveTemp(Positions);
 		}
 	}
 	else
@@ -208,7 +570,8 @@ void FVoxelEventManager::Update()
 			const FEventKey EventKey = EventInvokerIt.Key;
 			auto& EventInvokers = EventInvokerIt.Value;
 
-			if (!Events[EventKey]->IsBound()) continue;
+			const auto& EventInfo = *Events[EventKey];
+			if (!EventInfo.IsBound()) continue;
 
 			// First check if some need to update
 			bool bUpdate = false;
@@ -234,138 +597,85 @@ void FVoxelEventManager::Update()
 				Positions.Add(Position);
 			}
 
-			InvokersToUpdate.Emplace(EventKey, MoveTemp(Positions));
+			FVoxelEventsAsyncUpdater::FInput& Input = Inputs.Emplace_GetRef();
+			Input.EventKey = EventKey;
+			Input.EventId = EventInfo.Id;
+			Input.bGenerationEvent = (EventInfo.Flags & EVoxelEventFlags::GenerationEvent) != 0;
+			Input.bInvokersChanged = false;
+			Input.InvokerPositions = MoveTemp(Positions);
 		}
 	}
-	if (InvokersToUpdate.Num() > 0)
+	
+	if (Inputs.Num() > 0)
 	{
-		UpdateInvokers(InvokersToUpdate);
+		check(Task->IsDone());
+		Task->Init(MoveTemp(Inputs), MoveTemp(RemovedEventIds));
+		RemovedEventIds.Reset();
+		GetSubsystemChecked<FVoxelPool>().QueueTask(Task.Get());
+		bAsyncTaskWorking = true;
 	}
 }
 
-void FVoxelEventManager::UpdateInvokers(const TArray<TPair<FEventKey, TArray<FIntVector>>>& InvokersToUpdate)
+void FVoxelEventManager::FireDelegates()
 {
 	VOXEL_FUNCTION_COUNTER();
 
 	const bool bDebug = CVarShowEventsBounds.GetValueOnGameThread() != 0;
 
-	for (auto& It : InvokersToUpdate)
+	for (const FVoxelEventsAsyncUpdater::FOutput& Output : Task->Outputs)
 	{
-		const FEventKey EventKey = It.Key;
-		const auto& InvokerPositions = It.Value;
-		auto& EventInfo = *Events[EventKey];
+		auto* EventPtr = Events.Find(Output.EventKey);
+		if (!EventPtr || (*EventPtr)->Id != Output.EventId)
+		{
+			// Event was unbound during the update
+			continue;
+		}
+		auto& EventInfo = **EventPtr;
 
 		const auto GetChunkBounds = [&](const FIntVector& Chunk)
 		{
 			return FVoxelIntBox(Chunk * EventInfo.ChunkSize, (Chunk + 1) * EventInfo.ChunkSize);
 		};
 
-		TSet<FIntVector> NewActiveChunks;
+		VOXEL_SCOPE_COUNTER_FORMAT("Fire Delegates: %d activated, %d deactivated", Output.ChunksToActivate.Num(), Output.ChunksToDeactivate.Num());
+
+		const bool bGenerationEvent = (EventInfo.Flags & EVoxelEventFlags::GenerationEvent) != 0;
+		// Generation event: only the chunks not already generated are activated, and they are never deactivated
+		ensure(!bGenerationEvent || (!EventInfo.OnDeactivate.IsBound() && Output.ChunksToDeactivate.Num() == 0));
+
+		const FColor ActivateColor = bGenerationEvent ? FColor::Yellow : FColor::Blue;
+		for (const FIntVector& Chunk : Output.ChunksToActivate)
 		{
-			VOXEL_SCOPE_COUNTER("Find NewActiveChunks");
-			const auto WorldBounds = Settings.GetWorldBounds();
+			ensure(EventInfo.ActiveOrGeneratedChunks.Add(Chunk));
 
-			// NOTE: This part could be multi threaded
-			
-			// Iterate every position and add all chunks within activation radius
-			for (const FIntVector& InvokerPosition : InvokerPositions)
+			if (EventInfo.OnActivate.IsBound())
 			{
-				const FIntVector MinChunkPosition = FVoxelUtilities::DivideFloor(InvokerPosition - EventInfo.ChunkSize * EventInfo.DistanceInChunks, EventInfo.ChunkSize);
-				// Max is exclusive, since this is the coordinate of the Bounds.Min of the chunk
-				const FIntVector MaxChunkPosition = FVoxelUtilities::DivideCeil(InvokerPosition + EventInfo.ChunkSize * EventInfo.DistanceInChunks, EventInfo.ChunkSize);
+				const FVoxelIntBox Bounds = GetChunkBounds(Chunk);
+				EventInfo.OnActivate.Broadcast(Bounds);
 
-				if (!WorldBounds.Intersect(FVoxelIntBox(MinChunkPosition, MaxChunkPosition)))
+				if (bDebug)
 				{
-					continue;
-				}
-
-				const uint64 SquaredDistanceInVoxels = FMath::Square(EventInfo.DistanceInChunks * EventInfo.ChunkSize);
-
-				for (int32 X = MinChunkPosition.X; X < MaxChunkPosition.X; X++)
-				{
-					for (int32 Y = MinChunkPosition.Y; Y < MaxChunkPosition.Y; Y++)
-					{
-						for (int32 Z = MinChunkPosition.Z; Z < MaxChunkPosition.Z; Z++)
-						{
-							const FIntVector Chunk = FIntVector(X, Y, Z);
-							const FVoxelIntBox ChunkBounds = GetChunkBounds(Chunk);
-							
-							if (ChunkBounds.ComputeSquaredDistanceFromBoxToPoint(InvokerPosition) <= SquaredDistanceInVoxels &&
-								ChunkBounds.Intersect(WorldBounds))
-							{
-								NewActiveChunks.Add(Chunk);
-							}
-						}
-					}
+					UVoxelDebugUtilities::DrawDebugIntBox(Settings.VoxelWorld.Get(), Bounds, 1.f, 0, ActivateColor);
 				}
 			}
 		}
-
+		for (const FIntVector& Chunk : Output.ChunksToDeactivate)
 		{
-			VOXEL_SCOPE_COUNTER("Fire Delegates");
+			ensure(EventInfo.ActiveOrGeneratedChunks.Remove(Chunk));
 
-			if (EventInfo.Flags & EVoxelEventFlags::GenerationEvent)
+			if (EventInfo.OnDeactivate.IsBound())
 			{
-				// Generation event: trigger all chunks not already triggered
-				ensure(!EventInfo.OnDeactivate.IsBound());
-				if (ensure(EventInfo.OnActivate.IsBound()))
-				{
-					for (auto& Chunk : NewActiveChunks)
-					{
-						bool bAlreadyInSet;
-						EventInfo.ActiveOrGeneratedChunks.Add(Chunk, &bAlreadyInSet);
-						if (!bAlreadyInSet)
-						{
-							const FVoxelIntBox Bounds = GetChunkBounds(Chunk);
-							EventInfo.OnActivate.Broadcast(Bounds);
+				const FVoxelIntBox Bounds = GetChunkBounds(Chunk);
+				EventInfo.OnDeactivate.Broadcast(Bounds);
 
-							if (bDebug)
-							{
-								UVoxelDebugUtilities::DrawDebugIntBox(Settings.VoxelWorld.Get(), Bounds, 1.f, 0, FColor::Yellow);
-							}
-						}
-					}
-				}
-			}
-			else
-			{
-				// Normal event: activate new chunks, deactivate old chunks
-				if (EventInfo.OnActivate.IsBound())
+				if (bDebug)
 				{
-					for (auto& Chunk : NewActiveChunks)
-					{
-						if (!EventInfo.ActiveOrGeneratedChunks.Contains(Chunk))
-						{
-							const FVoxelIntBox Bounds = GetChunkBounds(Chunk);
-							EventInfo.OnActivate.Broadcast(Bounds);
-
-							if (bDebug)
-							{
-								UVoxelDebugUtilities::DrawDebugIntBox(Settings.VoxelWorld.Get(), Bounds, 1.f, 0, FColor::Blue);
-							}
-						}
-					}
-				}
-				if (EventInfo.OnDeactivate.IsBound())
-				{
-					for (auto& Chunk : EventInfo.ActiveOrGeneratedChunks)
-					{
-						if (!NewActiveChunks.Contains(Chunk))
-						{
-							const FVoxelIntBox Bounds = GetChunkBounds(Chunk);
-							EventInfo.OnDeactivate.Broadcast(Bounds);
-
-							if (bDebug)
-							{
-								UVoxelDebugUtilities::DrawDebugIntBox(Settings.VoxelWorld.Get(), Bounds, 1.f, 0, FColor::Red);
-							}
-						}
-					}
+					UVoxelDebugUtilities::DrawDebugIntBox(Settings.VoxelWorld.Get(), Bounds, 1.f, 0, FColor::Red);
 				}
-				EventInfo.ActiveOrGeneratedChunks = NewActiveChunks;
 			}
 		}
 	}
+	Task->Outputs.Reset();
 
 	UpdateEventsAllocatedSize();
 }
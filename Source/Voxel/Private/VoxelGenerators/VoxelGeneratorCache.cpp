@@ -3,6 +3,7 @@
 #include "VoxelGenerators/VoxelGeneratorCache.h"
 #include "VoxelGenerators/VoxelGeneratorTools.h"
 #include "VoxelGenerators/VoxelGeneratorInstance.h"
+#include "VoxelGenerators/VoxelGeneratorInstanceCache.h"
 #include "VoxelGenerators/VoxelGeneratorInstanceWrapper.h"
 #include "VoxelMessages.h"
 #include "VoxelUtilities/VoxelThreadingUtilities.h"
@@ -121,8 +122,8 @@ TVoxelSharedRef<typename T::FInstance> FVoxelGeneratorCache::MakeGeneratorInstan
 		return Instance->ToSharedRef();
 	}
 	
-	const auto Instance = Picker.GetInstance();
-	Instance->Init(GeneratorInit);
+	// Shared with the other worlds using the same generator if possible
+	const auto Instance = FVoxelGeneratorInstanceCache::GetInstance(Picker, GeneratorInit);
 	GetCache<T>().Add(Picker, Instance);
 	
 	return Instance;
@@ -0,0 +1,347 @@
+// Copyright 2021 Phyronnaz
+
+#include "VoxelGenerators/VoxelGeneratorInstanceCache.h"
+#include "VoxelGenerators/VoxelGeneratorCache.h"
+#include "VoxelGenerators/VoxelGeneratorInstance.h"
+#include "VoxelGenerators/VoxelGeneratorParameters.h"
+#include "VoxelRender/MaterialCollections/VoxelMaterialCollectionBase.h"
+#include "HAL/ConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/PropertyPortFlags.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Shared Generator Instances Hits"), STAT_VoxelGeneratorInstanceCacheHits, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Shared Generator Instances Misses"), STAT_VoxelGeneratorInstanceCacheMisses, STATGROUP_VoxelCounters);
+
+static TAutoConsoleVariable<int32> CVarShareGeneratorInstances(
+	TEXT("voxel.generators.ShareInstances"),
+	1,
+	TEXT("If true, generator instances with the same generator, parameters & init settings are shared by all the voxel worlds, asset actors and data items"),
+	ECVF_Default);
+
+static FAutoConsoleCommand CmdLogGeneratorInstanceCache(
+	TEXT("voxel.generators.LogInstanceCache"),
+	TEXT("Log the number of shared generator instances, and the hits & misses since the last voxel.generators.ClearInstanceCache"),
+	FConsoleCommandDelegate::CreateStatic(&FVoxelGeneratorInstanceCache::LogStats));
+
+static FAutoConsoleCommand CmdClearGeneratorInstanceCache(
+	TEXT("voxel.generators.ClearInstanceCache"),
+	TEXT("Stop sharing the existing generator instances with new users, and clear the stats"),
+	FConsoleCommandDelegate::CreateStatic(&FVoxelGeneratorInstanceCache::Clear));
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+struct FVoxelGeneratorInstanceCacheKey
+{
+	bool bTransformable = false;
+	// Class for class pickers, generator for object pickers
+	TWeakObjectPtr<const UObject> Object;
+	TMap<FName, FString> Parameters;
+	uint32 ParametersHash = 0;
+
+	// The init settings the instances can depend on. Runtime & world aren't included: instances using them can't be shared
+	float VoxelSize = 0;
+	int32 WorldSize = 0;
+	EVoxelRenderType RenderType = {};
+	EVoxelMaterialConfig MaterialConfig = {};
+	TWeakObjectPtr<const UVoxelMaterialCollectionBase> MaterialCollection;
+
+	template<typename TPicker>
+	FVoxelGeneratorInstanceCacheKey(const TPicker& Picker, const FVoxelGeneratorInit& Init)
+		: bTransformable(TPicker::bIsTransformable)
+		, Object(Picker.GetObject())
+		, Parameters(Picker.Parameters)
+		, VoxelSize(Init.VoxelSize)
+		, WorldSize(Init.WorldSize)
+		, RenderType(Init.RenderType)
+		, MaterialConfig(Init.MaterialConfig)
+		, MaterialCollection(Init.MaterialCollection)
+	{
+		// Order independent
+		for (auto& It : Parameters)
+		{
+			ParametersHash += HashCombine(GetTypeHash(It.Key), GetTypeHash(It.Value));
+		}
+	}
+
+	bool operator==(const FVoxelGeneratorInstanceCacheKey& Other) const
+	{
+		return
+			bTransformable == Other.bTransformable &&
+			Object == Other.Object &&
+			ParametersHash == Other.ParametersHash &&
+			VoxelSize == Other.VoxelSize &&
+			WorldSize == Other.WorldSize &&
+			RenderType == Other.RenderType &&
+			MaterialConfig == Other.MaterialConfig &&
+			MaterialCollection == Other.MaterialCollection &&
+			Parameters.OrderIndependentCompareEqual(Other.Parameters);
+	}
+	friend uint32 GetTypeHash(const FVoxelGeneratorInstanceCacheKey& Key)
+	{
+		return HashCombine(
+			HashCombine(GetTypeHash(Key.Object), Key.ParametersHash),
+			HashCombine(GetTypeHash(Key.VoxelSize), GetTypeHash(Key.WorldSize + 256 * int32(Key.MaterialConfig) + 65536 * int32(Key.RenderType))));
+	}
+};
+
+struct FVoxelGeneratorInstanceCacheStorage
+{
+	FCriticalSection Section;
+	TMap<FVoxelGeneratorInstanceCacheKey, TVoxelWeakPtr<FVoxelGeneratorInstance>> Map;
+	bool bDelegatesBound = false;
+
+	FThreadSafeCounter64 NumHits;
+	FThreadSafeCounter64 NumMisses;
+
+	// Must be called under Section
+	void RemoveExpired()
+	{
+		for (auto It = Map.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid() || !It.Key().Object.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	// Must be called under Section
+	void BindDelegates()
+	{
+		if (bDelegatesBound)
+		{
+			return;
+		}
+		bDelegatesBound = true;
+
+		FVoxelGeneratorCache::OnGeneratorRecompiled.AddLambda([](UVoxelGenerator* Generator)
+		{
+			FVoxelGeneratorInstanceCache::Invalidate(Generator);
+		});
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+		{
+			if (Object && Object->IsA<UVoxelGenerator>())
+			{
+				FVoxelGeneratorInstanceCache::Invalidate(Object);
+			}
+		});
+#endif
+	}
+};
+
+static FVoxelGeneratorInstanceCacheStorage GVoxelGeneratorInstanceCacheStorage;
+
+// Nested generators (eg generator variables of graphs) are created by the Init of their parent, using the init of its first user:
+// the parent can only be shared if all its nested generators can be shared too
+static bool CanShareInstances(UVoxelGenerator* Generator, const TMap<FName, FString>& Parameters, int32 Depth = 0)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!Generator || !Generator->CanShareInstances())
+	{
+		return false;
+	}
+	if (Depth > 16)
+	{
+		// Most likely a cycle
+		return false;
+	}
+
+	const auto IsPickerType = [](const FVoxelGeneratorParameterTerminalType& Type)
+	{
+		return
+			Type.PropertyType == EVoxelGeneratorParameterPropertyType::Struct &&
+			(Type.PropertyClass == FVoxelGeneratorPicker::StaticStruct()->GetFName() ||
+				Type.PropertyClass == FVoxelTransformableGeneratorPicker::StaticStruct()->GetFName());
+	};
+
+	for (const FVoxelGeneratorParameter& Parameter : Generator->GetParameters())
+	{
+		if (!IsPickerType(Parameter.Type) && !IsPickerType(Parameter.Type.ValueType))
+		{
+			continue;
+		}
+		if (Parameter.Type.ContainerType != EVoxelGeneratorParameterContainerType::None)
+		{
+			// Not worth parsing containers of pickers
+			return false;
+		}
+
+		const FString* Value = Parameters.Find(Parameter.Id);
+		const FString& Text = Value ? *Value : Parameter.DefaultValue;
+
+		UVoxelGenerator* NestedGenerator;
+		TMap<FName, FString> NestedParameters;
+		if (Parameter.Type.PropertyClass == FVoxelGeneratorPicker::StaticStruct()->GetFName())
+		{
+			FVoxelGeneratorPicker NestedPicker;
+			FVoxelGeneratorPicker::StaticStruct()->ImportText(*Text, &NestedPicker, nullptr, PPF_None, GLog, FVoxelGeneratorPicker::StaticStruct()->GetName());
+			NestedGenerator = NestedPicker.GetGenerator();
+			NestedParameters = MoveTemp(NestedPicker.Parameters);
+		}
+		else
+		{
+			FVoxelTransformableGeneratorPicker NestedPicker;
+			FVoxelTransformableGeneratorPicker::StaticStruct()->ImportText(*Text, &NestedPicker, nullptr, PPF_None, GLog, FVoxelTransformableGeneratorPicker::StaticStruct()->GetName());
+			NestedGenerator = NestedPicker.GetGenerator();
+			NestedParameters = MoveTemp(NestedPicker.Parameters);
+		}
+
+		// Empty pickers don't create any instance
+		if (NestedGenerator && !CanShareInstances(NestedGenerator, NestedParameters, Depth + 1))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename TPicker>
+static TVoxelSharedRef<typename TPicker::FInstance> GetSharedInstance(const TPicker& Picker, const FVoxelGeneratorInit& Init)
+{
+	VOXEL_FUNCTION_COUNTER();
+	using FInstance = typename TPicker::FInstance;
+
+	const auto CreateInstance = [&]()
+	{
+		const TVoxelSharedRef<FInstance> Instance = Picker.GetInstance();
+		Instance->Init(Init);
+		return Instance;
+	};
+
+	UVoxelGenerator* Generator = Picker.GetGenerator();
+	if (!FVoxelGeneratorInstanceCache::IsEnabled() ||
+		!CanShareInstances(Generator, Picker.Parameters))
+	{
+		return CreateInstance();
+	}
+
+	auto& Storage = GVoxelGeneratorInstanceCacheStorage;
+	const FVoxelGeneratorInstanceCacheKey Key(Picker, Init);
+
+	{
+		FScopeLock Lock(&Storage.Section);
+		Storage.BindDelegates();
+
+		if (const auto* WeakInstance = Storage.Map.Find(Key))
+		{
+			if (const TVoxelSharedPtr<FVoxelGeneratorInstance> Instance = WeakInstance->Pin())
+			{
+				Storage.NumHits.Increment();
+				INC_DWORD_STAT(STAT_VoxelGeneratorInstanceCacheHits);
+				// Safe: the key is different for transformable instances
+				return StaticCastSharedRef<FInstance>(Instance.ToSharedRef());
+			}
+		}
+	}
+
+	// Init outside of the lock: it can be slow, and can create other instances
+	const TVoxelSharedRef<FInstance> NewInstance = CreateInstance();
+
+	FScopeLock Lock(&Storage.Section);
+	Storage.NumMisses.Increment();
+	INC_DWORD_STAT(STAT_VoxelGeneratorInstanceCacheMisses);
+
+	TVoxelWeakPtr<FVoxelGeneratorInstance>& WeakInstance = Storage.Map.FindOrAdd(Key);
+	if (const TVoxelSharedPtr<FVoxelGeneratorInstance> Instance = WeakInstance.Pin())
+	{
+		// Created by someone else in the meantime
+		return StaticCastSharedRef<FInstance>(Instance.ToSharedRef());
+	}
+	WeakInstance = NewInstance;
+
+	// Keep the map small without needing a tick
+	if (Storage.Map.Num() % 64 == 0)
+	{
+		Storage.RemoveExpired();
+	}
+
+	return NewInstance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool FVoxelGeneratorInstanceCache::IsEnabled()
+{
+	return CVarShareGeneratorInstances.GetValueOnAnyThread() != 0;
+}
+
+TVoxelSharedRef<FVoxelGeneratorInstance> FVoxelGeneratorInstanceCache::GetInstance(const FVoxelGeneratorPicker& Picker, const FVoxelGeneratorInit& Init)
+{
+	return GetSharedInstance(Picker, Init);
+}
+
+TVoxelSharedRef<FVoxelTransformableGeneratorInstance> FVoxelGeneratorInstanceCache::GetInstance(const FVoxelTransformableGeneratorPicker& Picker, const FVoxelGeneratorInit& Init)
+{
+	return GetSharedInstance(Picker, Init);
+}
+
+void FVoxelGeneratorInstanceCache::Invalidate(const UObject* Generator)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!Generator)
+	{
+		return;
+	}
+
+	auto& Storage = GVoxelGeneratorInstanceCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+	for (auto It = Storage.Map.CreateIterator(); It; ++It)
+	{
+		const UObject* Object = It.Key().Object.Get();
+		// Class pickers use the class default object
+		if (Object == Generator || Object == Generator->GetClass() || !Object)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FVoxelGeneratorInstanceCache::Clear()
+{
+	auto& Storage = GVoxelGeneratorInstanceCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+	Storage.Map.Empty();
+	Storage.NumHits.Reset();
+	Storage.NumMisses.Reset();
+
+	LOG_VOXEL(Log, TEXT("Generator instance cache cleared"));
+}
+
+void FVoxelGeneratorInstanceCache::LogStats()
+{
+	auto& Storage = GVoxelGeneratorInstanceCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+	Storage.RemoveExpired();
+
+	const int64 NumHits = Storage.NumHits.GetValue();
+	const int64 NumMisses = Storage.NumMisses.GetValue();
+	const int64 NumQueries = FMath::Max<int64>(1, NumHits + NumMisses);
+
+	LOG_VOXEL(Log, TEXT("Generator instance cache: %d alive shared instances; %lld hits (%.1f%%); %lld misses"),
+		Storage.Map.Num(),
+		NumHits,
+		100. * NumHits / NumQueries,
+		NumMisses);
+
+	for (auto& It : Storage.Map)
+	{
+		const TVoxelSharedPtr<FVoxelGeneratorInstance> Instance = It.Value.Pin();
+		LOG_VOXEL(Log, TEXT("\t%s%s: %d users"),
+			*GetNameSafe(It.Key.Object.Get()),
+			It.Key.bTransformable ? TEXT(" (transformable)") : TEXT(""),
+			// Don't count ourselves
+			Instance.IsValid() ? Instance.GetSharedReferenceCount() - 1 : 0);
+	}
+}
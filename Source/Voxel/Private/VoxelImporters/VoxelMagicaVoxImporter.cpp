@@ -13,6 +13,10 @@
 #include "Engine/World.h"
 #include "UObject/Package.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformMemory.h"
 
 FVoxelMagicaVoxScene::FVoxelMagicaVoxScene(const ogt_vox_scene& Scene)
 	: Scene(Scene)
@@ -34,17 +38,50 @@ UVoxelMagicaVoxScene* FVoxelMagicaVoxScene::Import(
 	FName NamePrefix,
 	EObjectFlags Flags,
 	bool bUsePalette,
-	TArray<UVoxelDataAsset*>& OutAssets) const
+	TArray<UVoxelDataAsset*>& OutAssets)
 {
 	VOXEL_FUNCTION_COUNTER();
 
+	const double StartTime = FPlatformTime::Seconds();
+
 	if (!Parent)
 	{
 		Parent = GetTransientPackage();
 	}
 
+	// Estimate of the memory used by the import: decoded models + converted data not released yet
+	struct FMemoryTracker
+	{
+		FCriticalSection Section;
+		int64 Current = 0;
+		int64 Peak = 0;
+
+		void Add(int64 Bytes)
+		{
+			FScopeLock Lock(&Section);
+			Current += Bytes;
+			Peak = FMath::Max(Peak, Current);
+		}
+	};
+	FMemoryTracker MemoryTracker;
+
+	const auto GetModelSize = [](const ogt_vox_model& Model)
+	{
+		return int64(sizeof(ogt_vox_model)) + int64(Model.size_x) * int64(Model.size_y) * int64(Model.size_z);
+	};
+	int64 NumVoxels = 0;
+	for (const ogt_vox_model* Model : Models)
+	{
+		if (Model)
+		{
+			MemoryTracker.Add(GetModelSize(*Model));
+			NumVoxels += int64(Model->size_x) * int64(Model->size_y) * int64(Model->size_z);
+		}
+	}
+
 	TSet<FName> UsedNames;
 
+	// Create the objects first, as that needs to be done on the game thread
 	for (int32 ModelIndex = 0; ModelIndex < Models.Num(); ModelIndex++)
 	{
 		const ogt_vox_model* Model = Models[ModelIndex];
@@ -88,19 +125,68 @@ UVoxelMagicaVoxScene* FVoxelMagicaVoxScene::Import(
 		}
 		
 		Asset = NewObject<UVoxelDataAsset>(Parent, NamePrefix.IsNone() ? NAME_None : ModelName, Flags);
-		
-		const auto Data = MakeVoxelShared<FVoxelDataAssetData>();
-		ImportModel(*Data, *Model, bUsePalette, Scene.palette);
-		Asset->SetData(Data);
 	}
 
+	struct FConvertedModel
+	{
+		TVoxelSharedPtr<FVoxelDataAssetData> Data;
+		TArray<uint8> CompressedData;
+	};
+
+	// Only a few models are converted at once, so that the uncompressed data of all the models is never in memory at the same time
+	const int32 BatchSize = FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	for (int32 BatchStart = 0; BatchStart < Models.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchNum = FMath::Min(BatchSize, Models.Num() - BatchStart);
+
+		TArray<FConvertedModel> ConvertedModels;
+		ConvertedModels.SetNum(BatchNum);
+
+		ParallelFor(BatchNum, [&](int32 IndexInBatch)
+		{
+			const int32 ModelIndex = BatchStart + IndexInBatch;
+			const ogt_vox_model* Model = Models[ModelIndex];
+			if (!Model)
+			{
+				return;
+			}
+
+			FConvertedModel& ConvertedModel = ConvertedModels[IndexInBatch];
+			ConvertedModel.Data = MakeVoxelShared<FVoxelDataAssetData>();
+			ImportModel(*ConvertedModel.Data, *Model, bUsePalette, Scene.palette);
+			MemoryTracker.Add(ConvertedModel.Data->GetAllocatedSize());
+
+			MemoryTracker.Add(-GetModelSize(*Model));
+			ReleaseModel(ModelIndex);
+
+			UVoxelDataAsset::CompressData(*ConvertedModel.Data, ConvertedModel.CompressedData);
+			MemoryTracker.Add(ConvertedModel.CompressedData.GetAllocatedSize());
+		});
+
+		for (int32 IndexInBatch = 0; IndexInBatch < BatchNum; IndexInBatch++)
+		{
+			FConvertedModel& ConvertedModel = ConvertedModels[IndexInBatch];
+			UVoxelDataAsset* Asset = OutAssets[BatchStart + IndexInBatch];
+			if (!ConvertedModel.Data.IsValid() || !ensure(Asset))
+			{
+				continue;
+			}
+
+			// The compressed data is kept by the asset
+			MemoryTracker.Add(-ConvertedModel.Data->GetAllocatedSize());
+			Asset->SetCompressedData(ConvertedModel.Data.ToSharedRef(), MoveTemp(ConvertedModel.CompressedData), false);
+		}
+	}
 	
 	const FName SceneName = *FString::Printf(TEXT("%s_scene"), *NamePrefix.ToString());
 	auto* SceneObject = NewObject<UVoxelMagicaVoxScene>(Parent, NamePrefix.IsNone() ? NAME_None : SceneName, Flags);
 
-	for (const ogt_vox_instance& Instance : Instances)
+	SceneObject->Entries.SetNum(Instances.Num());
+	ParallelFor(Instances.Num(), [&](int32 InstanceIndex)
 	{
-		FVoxelMagicaVoxSceneEntry& Entry = SceneObject->Entries.Emplace_GetRef();
+		const ogt_vox_instance& Instance = Instances[InstanceIndex];
+
+		FVoxelMagicaVoxSceneEntry& Entry = SceneObject->Entries[InstanceIndex];
 		Entry.Name = Instance.name;
 		Entry.Asset = ensure(OutAssets.IsValidIndex(Instance.model_index)) ? OutAssets[Instance.model_index] : nullptr;
 		Entry.Transform = ConvertTransform(Instance.transform);
@@ -113,7 +199,15 @@ UVoxelMagicaVoxScene* FVoxelMagicaVoxScene::Import(
 			Entry.Transform *= ConvertTransform(Group.transform);
 			GroupIndex = Group.parent_group_index;
 		}
-	}
+	});
+
+	LOG_VOXEL(Log, TEXT("MagicaVoxel import: %d models (%lld voxels) and %d instances imported in %.2fs. Peak import memory: %.1fMB. Peak process memory: %.1fMB"),
+		Models.Num(),
+		NumVoxels,
+		Instances.Num(),
+		FPlatformTime::Seconds() - StartTime,
+		MemoryTracker.Peak / double(1 << 20),
+		FPlatformMemory::GetStats().PeakUsedPhysical / double(1 << 20));
 
 	return SceneObject;
 }
@@ -134,6 +228,19 @@ bool FVoxelMagicaVoxScene::ImportModel(FVoxelDataAssetData& Asset, int32 ModelIn
 	return true;
 }
 
+void FVoxelMagicaVoxScene::ReleaseModel(int32 ModelIndex)
+{
+	if (!ensure(Models.IsValidIndex(ModelIndex)))
+	{
+		return;
+	}
+
+	// The scene is owned by us. ogt_vox_destroy_scene skips null models
+	ogt_vox_scene& MutableScene = const_cast<ogt_vox_scene&>(Scene);
+	ogt_vox_free(const_cast<ogt_vox_model*>(MutableScene.models[ModelIndex]));
+	MutableScene.models[ModelIndex] = nullptr;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -165,33 +272,49 @@ void FVoxelMagicaVoxScene::ImportModel(FVoxelDataAssetData& Asset, const ogt_vox
 	
 	check(Model.voxel_data);
 
-	Asset.SetSize(FIntVector(Model.size_y, Model.size_x, Model.size_z), true);
+	// X and Y are swapped, see ConvertTransform
+	const FIntVector Size(Model.size_y, Model.size_x, Model.size_z);
+	Asset.SetSize(Size, true);
+
+	// Only 256 different voxels
+	TStaticArray<FVoxelMaterial, 256> MaterialsLUT;
+	for (int32 Voxel = 0; Voxel < 256; Voxel++)
+	{
+		FVoxelMaterial Material(ForceInit);
+		if (bUsePalette)
+		{
+			const auto MagicaColor = Palette.color[Voxel];
+			// Store the color as a linear color, so edits can be in linear space
+			const FColor Color = FLinearColor(FColor(MagicaColor.r, MagicaColor.g, MagicaColor.b, MagicaColor.a)).ToFColor(false);
+			Material.SetColor(Color);
+		}
+		else
+		{
+			Material.SetSingleIndex(Voxel);
+		}
+		MaterialsLUT[Voxel] = Material;
+	}
+
+	// Write the asset storage linearly, reading the model with a stride
+	auto& Values = Asset.GetRawValues();
+	FVoxelMaterial* RESTRICT Materials = Asset.GetRawMaterials().GetData();
+	const uint8* RESTRICT VoxelData = Model.voxel_data;
 
-	for (uint32 Z = 0; Z < Model.size_z; Z++)
+	int32 Index = 0;
+	for (int32 Z = 0; Z < Size.Z; Z++)
 	{
-		for (uint32 Y = 0; Y < Model.size_y; Y++)
+		for (int32 Y = 0; Y < Size.Y; Y++)
 		{
-			for (uint32 X = 0; X < Model.size_x; X++)
+			// Asset Y is model X, asset X is model Y
+			const uint8* RESTRICT Row = VoxelData + Y + Model.size_x * Model.size_y * Z;
+			for (int32 X = 0; X < Size.X; X++)
 			{
-				const uint32 Index = X + Model.size_x * Y + Model.size_x * Model.size_y * Z;
-				const uint8 Voxel = Model.voxel_data[Index];
-
-				Asset.SetValue(Y, X, Z, Voxel > 0 ? FVoxelValue::Full() : FVoxelValue::Empty());
-
-				FVoxelMaterial Material(ForceInit);
-				if (bUsePalette)
-				{
-					const auto MagicaColor = Palette.color[Voxel];
-					// Store the color as a linear color, so edits can be in linear space
-					const FColor Color = FLinearColor(FColor(MagicaColor.r, MagicaColor.g, MagicaColor.b, MagicaColor.a)).ToFColor(false);
-					Material.SetColor(Color);
-				}
-				else
-				{
-					Material.SetSingleIndex(Voxel);
-				}
-
-				Asset.SetMaterial(Y, X, Z, Material);
+				const uint8 Voxel = Row[Model.size_x * X];
+				checkVoxelSlow(Index == Asset.GetIndex(X, Y, Z));
+
+				FVoxelUtilities::Get(Values, Index) = Voxel > 0 ? FVoxelValue::Full() : FVoxelValue::Empty();
+				Materials[Index] = MaterialsLUT[Voxel];
+				Index++;
 			}
 		}
 	}
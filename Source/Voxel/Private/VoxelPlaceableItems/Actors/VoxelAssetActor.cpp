@@ -12,6 +12,7 @@
 #include "VoxelRender/VoxelProceduralMeshComponent.h"
 #include "VoxelRender/Renderers/VoxelDefaultRenderer.h"
 #include "VoxelGenerators/VoxelEmptyGenerator.h"
+#include "VoxelGenerators/VoxelGeneratorInstanceCache.h"
 #include "VoxelWorld.h"
 #include "VoxelWorldRootComponent.h"
 #include "VoxelPool.h"
@@ -104,8 +105,8 @@ FVoxelIntBox AVoxelAssetActor::AddItemToData(
 		return WorldBounds;
 	}
 
-	auto AssetInstance = Generator.GetInstance();
-	AssetInstance->Init(VoxelWorld->GetGeneratorInit());
+	// Shared with the other actors & worlds using the same asset
+	const auto AssetInstance = FVoxelGeneratorInstanceCache::GetInstance(Generator, VoxelWorld->GetGeneratorInit());
 	
 	if (bImportAsReference)
 	{
@@ -3,6 +3,7 @@
 #include "VoxelPlaceableItems/VoxelPlaceableItem.h"
 #include "VoxelGenerators/VoxelGeneratorInit.h"
 #include "VoxelGenerators/VoxelGeneratorInstance.h"
+#include "VoxelGenerators/VoxelGeneratorInstanceCache.h"
 #include "VoxelMessages.h"
 #include "VoxelObjectArchive.h"
 
@@ -64,8 +65,9 @@ void FVoxelPlaceableItemsUtilities::SerializeItems(
 				continue;
 			}
 
-			const auto Instance = LoadedGenerator->GetTransformableInstance();
-			Instance->Init(ensure(LoadInfo.GeneratorInit) ? *LoadInfo.GeneratorInit : FVoxelGeneratorInit());
+			const auto Instance = FVoxelGeneratorInstanceCache::GetInstance(
+				FVoxelTransformableGeneratorPicker(LoadedGenerator),
+				ensure(LoadInfo.GeneratorInit) ? *LoadInfo.GeneratorInit : FVoxelGeneratorInit());
 			AssetItems.Emplace(FVoxelAssetItem{ Instance, Bounds, LocalToWorld, Priority });
 		}
 	}
@@ -51,6 +51,8 @@ void FVoxelPool::FixPriorityCategories(TMap<EVoxelTaskType, int32>& PriorityCate
 	FIX(AsyncEditFunctions);
 	FIX(MeshMerge);
 	FIX(RenderOctree);
+	FIX(EditChunksMeshing);
+	FIX(InvokersPrefetch);
 #undef FIX
 }
 
@@ -67,5 +69,7 @@ void FVoxelPool::FixPriorityOffsets(TMap<EVoxelTaskType, int32>& PriorityOffsets
 	FIX(AsyncEditFunctions);
 	FIX(RenderOctree);
 	FIX(MeshMerge);
+	FIX(EditChunksMeshing);
+	FIX(InvokersPrefetch);
 #undef FIX
 }
\ No newline at end of file
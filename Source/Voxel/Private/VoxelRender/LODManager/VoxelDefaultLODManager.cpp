@@ -7,6 +7,7 @@
 #include "VoxelPool.h"
 #include "VoxelWorld.h"
 #include "VoxelComponents/VoxelInvokerComponent.h"
+#include "VoxelData/VoxelDataIncludes.h"
 #include "VoxelUtilities/VoxelThreadingUtilities.h"
 
 #include "EngineUtils.h"
@@ -20,6 +21,154 @@ static TAutoConsoleVariable<int32> CVarFreezeLODs(
 	TEXT("Stops LOD manager tick"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<float> CVarInvokerPredictionTime(
+	TEXT("voxel.lod.InvokerPredictionTime"),
+	0.f,
+	TEXT("In seconds. If > 0, the invokers velocity is used to predict where they will be in that time. "
+		"Chunks along the predicted path are subdivided ahead of time, task priorities use the predicted positions and the data along the path is cached"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarInvokerPredictionSteps(
+	TEXT("voxel.lod.InvokerPredictionSteps"),
+	4,
+	TEXT("Number of positions along the predicted path of an invoker that are subdivided ahead of time"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarInvokerPrefetchBudget(
+	TEXT("voxel.lod.InvokerPrefetchBudget"),
+	256,
+	TEXT("Max number of data chunks cached per LOD update along the predicted path of the invokers. 0 to disable data prefetching"),
+	ECVF_Default);
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Caches the data along the predicted path of the invokers, so that the meshers don't have to query the generator when they get there
+class FVoxelInvokersPrefetchWork : public FVoxelAsyncWork
+{
+public:
+	FVoxelInvokersPrefetchWork(
+		const TVoxelSharedRef<FVoxelData>& Data,
+		const FVoxelCancelCounter& CancelCounter,
+		const TVoxelSharedRef<FVoxelInvokersPrefetchedChunks>& PrefetchedChunks,
+		TArray<FVoxelIntBox>&& BoundsToPrefetch,
+		TArray<FVoxelIntBox>&& BoundsToClear,
+		TArray<FVoxelIntBox>&& BoundsToKeep)
+		: FVoxelAsyncWork(STATIC_FNAME("FVoxelInvokersPrefetchWork"), EVoxelTaskType::InvokersPrefetch, EPriority::Null, true)
+		, Data(Data)
+		, CancelTracker(CancelCounter)
+		, PrefetchedChunks(PrefetchedChunks)
+		, BoundsToPrefetch(MoveTemp(BoundsToPrefetch))
+		, BoundsToClear(MoveTemp(BoundsToClear))
+		, BoundsToKeep(MoveTemp(BoundsToKeep))
+	{
+	}
+
+	virtual void DoWork() override
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+		
+		const auto PinnedData = Data.Pin();
+		if (!PinnedData.IsValid())
+		{
+			return;
+		}
+
+		FVoxelData& LocalData = *PinnedData;
+
+		// Not speculative: always done, as these bounds are not tracked anymore
+		// Only clear the chunks cached by the prefetch: the others might have been cached by the user
+		TArray<FIntVector> ChunksToClear;
+		{
+			FScopeLock Lock(&PrefetchedChunks->Section);
+			for (auto It = PrefetchedChunks->Chunks.CreateIterator(); It; ++It)
+			{
+				const FVoxelIntBox ChunkBounds(*It, *It + DATA_CHUNK_SIZE);
+				const auto Intersect = [&](const FVoxelIntBox& Bounds) { return Bounds.Intersect(ChunkBounds); };
+				if (BoundsToClear.ContainsByPredicate(Intersect) && !BoundsToKeep.ContainsByPredicate(Intersect))
+				{
+					ChunksToClear.Add(*It);
+					It.RemoveCurrent();
+				}
+			}
+		}
+		for (const FIntVector& Chunk : ChunksToClear)
+		{
+			const FVoxelIntBox ChunkBounds(Chunk, Chunk + DATA_CHUNK_SIZE);
+			FVoxelWriteScopeLock Lock(LocalData, ChunkBounds, FUNCTION_FNAME);
+			LocalData.ClearCacheInBounds<FVoxelValue>(ChunkBounds);
+		}
+
+		const auto IsCached = [&](const FVoxelIntBox& ChunkBounds)
+		{
+			return FVoxelOctreeUtilities::IterateTreeInBoundsEarlyExit(LocalData.GetOctree(), ChunkBounds, [&](FVoxelDataOctreeBase& Chunk)
+			{
+				if (Chunk.IsLeaf())
+				{
+					return Chunk.AsLeaf().GetData<FVoxelValue>().HasData();
+				}
+				return Chunk.AsParent().HasChildren();
+			});
+		};
+
+		// Closest bounds first: stop as soon as the predictions changed
+		// Chunk by chunk, so that the meshers are only blocked by the chunk being cached
+		for (const FVoxelIntBox& Bounds : BoundsToPrefetch)
+		{
+			bool bCanceled = false;
+			Bounds.MakeMultipleOfBigger(DATA_CHUNK_SIZE).Iterate(DATA_CHUNK_SIZE, [&](int32 X, int32 Y, int32 Z)
+			{
+				if (bCanceled || CancelTracker.IsCanceled() || IsCanceled())
+				{
+					bCanceled = true;
+					return;
+				}
+
+				const FIntVector Chunk(X, Y, Z);
+				const FVoxelIntBox ChunkBounds(Chunk, Chunk + DATA_CHUNK_SIZE);
+				{
+					// Most chunks are already cached: only check them with a read lock
+					FVoxelReadScopeLock Lock(LocalData, ChunkBounds, FUNCTION_FNAME);
+					if (IsCached(ChunkBounds))
+					{
+						return;
+					}
+				}
+				{
+					// CacheBounds requires a write lock
+					FVoxelWriteScopeLock Lock(LocalData, ChunkBounds, FUNCTION_FNAME);
+					if (IsCached(ChunkBounds))
+					{
+						// Cached by someone else in the meantime
+						return;
+					}
+					LocalData.CacheBounds<FVoxelValue>(ChunkBounds, false);
+				}
+
+				FScopeLock Lock(&PrefetchedChunks->Section);
+				PrefetchedChunks->Chunks.Add(Chunk);
+			});
+
+			if (bCanceled)
+			{
+				return;
+			}
+		}
+	}
+
+private:
+	const TVoxelWeakPtr<FVoxelData> Data;
+	const FVoxelCancelTracker CancelTracker;
+	const TVoxelSharedRef<FVoxelInvokersPrefetchedChunks> PrefetchedChunks;
+	const TArray<FVoxelIntBox> BoundsToPrefetch;
+	const TArray<FVoxelIntBox> BoundsToClear;
+	// Bounds still used: their chunks aren't cleared even if they are also in BoundsToClear
+	const TArray<FVoxelIntBox> BoundsToKeep;
+
+	~FVoxelInvokersPrefetchWork() = default;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -48,6 +197,8 @@ void FVoxelDefaultLODManager::Destroy()
 		Task->CancelAndAutodelete();
 		Task.Release();
 	}
+
+	PrefetchCancelCounter.Cancel();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -60,6 +211,15 @@ inline FVoxelIntBox GetBoundsToUpdate(const FVoxelIntBox& Bounds)
 	return Bounds.Extend(2);
 }
 
+// Invoker bounds moved along its predicted path, closest first
+inline void GetPredictedBounds(const FVoxelIntBox& Bounds, const FIntVector& PredictedOffset, int32 NumSteps, TArray<FVoxelIntBox>& OutBounds)
+{
+	for (int32 Step = 1; Step <= NumSteps; Step++)
+	{
+		OutBounds.Add(Bounds.ShiftBy(PredictedOffset * Step / NumSteps));
+	}
+}
+
 int32 FVoxelDefaultLODManager::UpdateBounds(const FVoxelIntBox& Bounds, const FVoxelOnChunkUpdateFinished& FinishDelegate)
 {
 	VOXEL_FUNCTION_COUNTER();
@@ -163,6 +323,12 @@ void FVoxelDefaultLODManager::Tick(float DeltaTime)
 			INC_DWORD_STAT_BY(STAT_VoxelChunkUpdates, Task->ChunkUpdates.Num());
 			GetSubsystemChecked<IVoxelRenderer>().UpdateLODs(Octree->UpdateIndex, Task->ChunkUpdates);
 
+			if (Task->HasPendingChunks())
+			{
+				// Some chunks were kept back by MinChunkLifetime
+				bLODUpdateQueued = true;
+			}
+
 			if (Settings.bStaticWorld)
 			{
 				// Destroy octree and stop ticking
@@ -190,7 +356,6 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 	{
 		return;
 	}
-	ensure(SortedInvokerComponents.Num() == InvokerComponentsInfos.Num());
 
 	if (Settings.bContributesToStaticLighting)
 	{
@@ -213,64 +378,90 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 	
 	bool bNeedUpdate = false;
 	
-	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> NewSortedInvokerComponents = UVoxelInvokerComponentBase::GetInvokers(VoxelWorld);
-	NewSortedInvokerComponents.Sort([](auto& A, auto& B) { return A.Get() < B.Get(); });
+	const TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> InvokerComponents = UVoxelInvokerComponentBase::GetInvokers(VoxelWorld);
+
+	// No need to sort the components: they changed iff one of them isn't in the map, as they are unique
+	TArray<FVoxelInvokerInfo*, TInlineAllocator<16>> ExistingInfos;
+	bool bInvokerComponentsChanged = InvokerComponents.Num() != InvokerComponentsInfos.Num();
+	if (!bInvokerComponentsChanged)
+	{
+		ExistingInfos.Reserve(InvokerComponents.Num());
+		for (const auto& InvokerComponent : InvokerComponents)
+		{
+			FVoxelInvokerInfo* ExistingInfo = InvokerComponentsInfos.Find(InvokerComponent);
+			if (!ExistingInfo)
+			{
+				bInvokerComponentsChanged = true;
+				break;
+			}
+			ExistingInfos.Add(ExistingInfo);
+		}
+	}
 	
-	if (SortedInvokerComponents != NewSortedInvokerComponents)
+	if (bInvokerComponentsChanged)
 	{
 		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Components Array changed"));
 		bNeedUpdate = true;
 	}
 
-	TMap<TWeakObjectPtr<UVoxelInvokerComponentBase>, FVoxelInvokerInfo> NewInvokerComponentsInfos;
-	NewInvokerComponentsInfos.Reserve(NewSortedInvokerComponents.Num());
+	TArray<FVoxelInvokerInfo, TInlineAllocator<16>> NewInfos;
+	NewInfos.Reserve(InvokerComponents.Num());
 	
 	const uint64 SquaredDistanceThreshold = FMath::Square(FMath::Max(DynamicSettings->InvokerDistanceThreshold / Settings.VoxelSize, 0.f)); // Truncate
-	for (const auto& InvokerComponent : NewSortedInvokerComponents)
+	const float PredictionTime = FMath::Max(CVarInvokerPredictionTime.GetValueOnGameThread(), 0.f);
+	for (int32 Index = 0; Index < InvokerComponents.Num(); Index++)
 	{
+		const auto& InvokerComponent = InvokerComponents[Index];
+
 		FVoxelInvokerSettings InvokerSettings = InvokerComponent->GetInvokerSettings(VoxelWorld);
 		InvokerSettings.bUseForLOD &= InvokerComponent->IsLocalInvoker();
 
 		const FIntVector InvokerPosition = InvokerComponent->GetInvokerVoxelPosition(VoxelWorld);
 		
-		FVoxelInvokerInfo Info;
+		FVoxelInvokerInfo& Info = NewInfos.Emplace_GetRef();
 		Info.LocalPosition = InvokerPosition;
 		Info.Settings = InvokerSettings;
 
-		NewInvokerComponentsInfos.Add(InvokerComponent, Info);
+		if (PredictionTime > 0)
+		{
+			const FVector GlobalOffset = InvokerComponent->GetInvokerVelocity() * PredictionTime;
+			Info.PredictedOffset = FVoxelUtilities::RoundToInt(FVector(VoxelWorld->GlobalToLocalFloat(GlobalOffset) - VoxelWorld->GlobalToLocalFloat(FVector::ZeroVector)));
+		}
 
 		if (!bNeedUpdate)
 		{
-			auto* ExistingInfo = InvokerComponentsInfos.Find(InvokerComponent);
-			if (ensure(ExistingInfo)) // Should be valid if bNeedUpdate is false (would be set to true if invoker components array changed)
+			const FVoxelInvokerInfo* ExistingInfo = ExistingInfos[Index];
+			const auto& OldSettings = ExistingInfo->Settings;
+			const auto& NewSettings = Info.Settings;
+			if (OldSettings.bUseForLOD != NewSettings.bUseForLOD)
 			{
-				const auto& OldSettings = ExistingInfo->Settings;
-				const auto& NewSettings = Info.Settings;
-				if (OldSettings.bUseForLOD != NewSettings.bUseForLOD)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForLOD changed"));
-					bNeedUpdate = true;
-				}
-				else if (OldSettings.LODToSet != NewSettings.LODToSet)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: LODToSet changed"));
-					bNeedUpdate = true;
-				}
-				else if (OldSettings.bUseForCollisions != NewSettings.bUseForCollisions)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForCollisions changed"));
-					bNeedUpdate = true;
-				}
-				else if (OldSettings.bUseForNavmesh != NewSettings.bUseForNavmesh)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForNavmesh changed"));
-					bNeedUpdate = true;
-				}
-				else if (FVoxelUtilities::SquaredSize(ExistingInfo->LocalPosition - Info.LocalPosition) > SquaredDistanceThreshold)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component moved"));
-					bNeedUpdate = true;
-				}
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForLOD changed"));
+				bNeedUpdate = true;
+			}
+			else if (OldSettings.LODToSet != NewSettings.LODToSet)
+			{
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: LODToSet changed"));
+				bNeedUpdate = true;
+			}
+			else if (OldSettings.bUseForCollisions != NewSettings.bUseForCollisions)
+			{
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForCollisions changed"));
+				bNeedUpdate = true;
+			}
+			else if (OldSettings.bUseForNavmesh != NewSettings.bUseForNavmesh)
+			{
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForNavmesh changed"));
+				bNeedUpdate = true;
+			}
+			else if (FVoxelUtilities::SquaredSize(ExistingInfo->LocalPosition - Info.LocalPosition) > SquaredDistanceThreshold)
+			{
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component moved"));
+				bNeedUpdate = true;
+			}
+			else if (FVoxelUtilities::SquaredSize(ExistingInfo->PredictedOffset - Info.PredictedOffset) > SquaredDistanceThreshold)
+			{
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component velocity changed"));
+				bNeedUpdate = true;
 			}
 		}
 	}
@@ -282,8 +473,23 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 			bLODUpdateQueued = true;
 		}
 
-		SortedInvokerComponents = MoveTemp(NewSortedInvokerComponents);
-		InvokerComponentsInfos = MoveTemp(NewInvokerComponentsInfos);
+		if (bInvokerComponentsChanged)
+		{
+			InvokerComponentsInfos.Reset();
+			InvokerComponentsInfos.Reserve(InvokerComponents.Num());
+			for (int32 Index = 0; Index < InvokerComponents.Num(); Index++)
+			{
+				InvokerComponentsInfos.Add(InvokerComponents[Index], NewInfos[Index]);
+			}
+		}
+		else
+		{
+			// Update in place to keep the map order
+			for (int32 Index = 0; Index < InvokerComponents.Num(); Index++)
+			{
+				*ExistingInfos[Index] = NewInfos[Index];
+			}
+		}
 
 		// Update the invoker positions, used for priorities
 		TArray<FIntVector> NewInvokerPositions;
@@ -292,6 +498,12 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 			if (It.Key->bUseForPriorities)
 			{
 				NewInvokerPositions.Add(It.Value.LocalPosition);
+				
+				if (It.Value.PredictedOffset != FIntVector::ZeroValue)
+				{
+					// Also prioritize the chunks the invoker is heading to
+					NewInvokerPositions.Add(It.Value.LocalPosition + It.Value.PredictedOffset);
+				}
 			}
 		}
 		
@@ -303,8 +515,6 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 		InvokerPositions->Set(NewInvokerPositions);
 	}
 
-	ensure(SortedInvokerComponents.Num() == InvokerComponentsInfos.Num());
-
 	const double Time = FPlatformTime::Seconds();
 	if (bLODUpdateQueued && Task->IsDone() && Time - LastLODUpdateTime > Settings.MinDelayBetweenLODUpdates)
 	{
@@ -343,6 +553,80 @@ void FVoxelDefaultLODManager::UpdateLODs()
 		}
 	}
 
+	// Speculative invokers along the predicted paths, added after the actual ones to keep their order stable
+	// They only subdivide: collisions and navmesh stay around the actual invokers
+	const int32 NumPredictionSteps = FMath::Clamp(CVarInvokerPredictionSteps.GetValueOnGameThread(), 1, 16);
+	TArray<FVoxelInvokerSettings> NewPredictedInvokers;
+	TArray<TArray<FVoxelIntBox>> PredictedLOD0Bounds;
+	TArray<FVoxelIntBox> InvokersLOD0Bounds;
+	for (const auto& It : InvokerComponentsInfos)
+	{
+		const FVoxelInvokerSettings& InvokerSettings = It.Value.Settings;
+		if (!InvokerSettings.bUseForLOD)
+		{
+			continue;
+		}
+		if (InvokerSettings.LODToSet == 0)
+		{
+			InvokersLOD0Bounds.Add(InvokerSettings.LODBounds);
+		}
+		if (It.Value.PredictedOffset == FIntVector::ZeroValue)
+		{
+			continue;
+		}
+
+		TArray<FVoxelIntBox> PredictedBounds;
+		GetPredictedBounds(InvokerSettings.LODBounds, It.Value.PredictedOffset, NumPredictionSteps, PredictedBounds);
+
+		for (const FVoxelIntBox& Bounds : PredictedBounds)
+		{
+			FVoxelInvokerSettings PredictedSettings;
+			PredictedSettings.bUseForLOD = true;
+			PredictedSettings.LODToSet = InvokerSettings.LODToSet;
+			PredictedSettings.LODBounds = Bounds;
+			NewPredictedInvokers.Add(PredictedSettings);
+		}
+
+		// The generator is only queried at full resolution around LOD 0 invokers
+		if (InvokerSettings.LODToSet == 0)
+		{
+			PredictedLOD0Bounds.Add(MoveTemp(PredictedBounds));
+		}
+	}
+
+	{
+		// Interleave the invokers paths so that the closest bounds are prefetched first
+		TArray<FVoxelIntBox> BoundsToPrefetch;
+		for (int32 Step = 0; Step < NumPredictionSteps; Step++)
+		{
+			for (const TArray<FVoxelIntBox>& PredictedBounds : PredictedLOD0Bounds)
+			{
+				BoundsToPrefetch.Add(PredictedBounds[Step]);
+			}
+		}
+		PrefetchData(BoundsToPrefetch, InvokersLOD0Bounds);
+	}
+
+	{
+		// Keep the previous predictions if none of them moved more than the invokers distance threshold
+		const int64 DistanceThreshold = FMath::Max(DynamicSettings->InvokerDistanceThreshold / Settings.VoxelSize, 0.f); // Truncate
+		bool bPredictionsMoved = NewPredictedInvokers.Num() != PredictedInvokers.Num();
+		for (int32 Index = 0; Index < NewPredictedInvokers.Num() && !bPredictionsMoved; Index++)
+		{
+			const FVoxelInvokerSettings& OldInvoker = PredictedInvokers[Index];
+			const FVoxelInvokerSettings& NewInvoker = NewPredictedInvokers[Index];
+			bPredictionsMoved =
+				OldInvoker.LODToSet != NewInvoker.LODToSet ||
+				OldInvoker.LODBounds.Size() != NewInvoker.LODBounds.Size() ||
+				FVoxelUtilities::SquaredSize(OldInvoker.LODBounds.Min - NewInvoker.LODBounds.Min) > uint64(DistanceThreshold * DistanceThreshold);
+		}
+		if (bPredictionsMoved)
+		{
+			PredictedInvokers = MoveTemp(NewPredictedInvokers);
+		}
+		OctreeSettings.Invokers.Append(PredictedInvokers);
+	}
+
 	OctreeSettings.ChunksCullingLOD = DynamicSettings->ChunksCullingLOD;
 
 	OctreeSettings.bEnableRender = DynamicSettings->bRenderWorld;
@@ -357,13 +641,98 @@ void FVoxelDefaultLODManager::UpdateLODs()
 	OctreeSettings.bComputeVisibleChunksNavmesh = DynamicSettings->bComputeVisibleChunksNavmesh;
 	OctreeSettings.VisibleChunksNavmeshMaxLOD = DynamicSettings->VisibleChunksNavmeshMaxLOD;
 
+	OctreeSettings.LODHysteresis = Settings.LODHysteresis;
+	OctreeSettings.MinChunkLifetime = Settings.MinChunkLifetime;
+	OctreeSettings.Time = FPlatformTime::Seconds();
+
 	Task->Init(OctreeSettings, Octree);
 	GetSubsystemChecked<FVoxelPool>().QueueTask(Task.Get());
 	bAsyncTaskWorking = true;
 }
 
+void FVoxelDefaultLODManager::PrefetchData(const TArray<FVoxelIntBox>& BoundsToPrefetch, const TArray<FVoxelIntBox>& InvokersBounds)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const auto Data = GetSubsystem<FVoxelData>();
+	if (!Data.IsValid())
+	{
+		return;
+	}
+	
+	const FVoxelIntBox WorldBounds = Settings.GetWorldBounds();
+	
+	TArray<FVoxelIntBox> NewBoundsToPrefetch;
+	int32 NumChunks = 0;
+	const int32 Budget = CVarInvokerPrefetchBudget.GetValueOnGameThread();
+	for (const FVoxelIntBox& Bounds : BoundsToPrefetch)
+	{
+		if (!Bounds.Intersect(WorldBounds))
+		{
+			continue;
+		}
+		
+		const FVoxelIntBox ClampedBounds = Bounds.Overlap(WorldBounds);
+		const FIntVector NumChunksInBounds = FVoxelUtilities::DivideCeil(ClampedBounds.Size(), DATA_CHUNK_SIZE) + FIntVector(1); // +1: the bounds aren't aligned
+		NumChunks += NumChunksInBounds.X * NumChunksInBounds.Y * NumChunksInBounds.Z;
+		if (NumChunks > Budget)
+		{
+			break;
+		}
+		NewBoundsToPrefetch.Add(ClampedBounds);
+	}
+
+	// Clear the bounds that were previously prefetched and that no invoker is going through anymore
+	TArray<FVoxelIntBox> NewPrefetchedBounds = NewBoundsToPrefetch;
+	TArray<FVoxelIntBox> BoundsToClear;
+	for (const FVoxelIntBox& Bounds : PrefetchedBounds)
+	{
+		const auto Intersect = [&](const FVoxelIntBox& Other) { return Bounds.Intersect(Other); };
+		if (NewBoundsToPrefetch.ContainsByPredicate(Intersect) ||
+			InvokersBounds.ContainsByPredicate(Intersect))
+		{
+			// Still used: keep tracking it
+			NewPrefetchedBounds.AddUnique(Bounds);
+		}
+		else
+		{
+			BoundsToClear.Add(Bounds);
+		}
+	}
+	PrefetchedBounds = MoveTemp(NewPrefetchedBounds);
+
+	if (NewBoundsToPrefetch == QueuedBoundsToPrefetch)
+	{
+		// Same predictions: the previous prefetch is still valid, let it finish
+		NewBoundsToPrefetch.Reset();
+	}
+	else
+	{
+		// Cancel the previous prefetch: it's following outdated predictions
+		PrefetchCancelCounter.Cancel();
+		QueuedBoundsToPrefetch = NewBoundsToPrefetch;
+	}
+	
+	if (NewBoundsToPrefetch.Num() == 0 && BoundsToClear.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FVoxelIntBox> BoundsToKeep = PrefetchedBounds;
+	BoundsToKeep.Append(InvokersBounds);
+	
+	LOG_VOXEL(VeryVerbose, TEXT("Prefetching %d bounds along the invokers predicted paths, clearing %d"), NewBoundsToPrefetch.Num(), BoundsToClear.Num());
+
+	GetSubsystemChecked<FVoxelPool>().QueueTask(new FVoxelInvokersPrefetchWork(
+		Data.ToSharedRef(),
+		PrefetchCancelCounter,
+		PrefetchedChunks,
+		MoveTemp(NewBoundsToPrefetch),
+		MoveTemp(BoundsToClear),
+		MoveTemp(BoundsToKeep)));
+}
+
 void FVoxelDefaultLODManager::ClearInvokerComponents()
 {
-	SortedInvokerComponents.Reset();
 	InvokerComponentsInfos.Reset();
 }
\ No newline at end of file
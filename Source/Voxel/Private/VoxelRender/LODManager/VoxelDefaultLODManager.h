@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "VoxelTickable.h"
 #include "VoxelAsyncWork.h"
+#include "VoxelCancelCounter.h"
 #include "VoxelInvokerSettings.h"
 #include "VoxelRender/IVoxelLODManager.h"
 #include "VoxelDefaultLODManager.generated.h"
@@ -13,6 +14,14 @@ class FVoxelRenderOctree;
 class UVoxelInvokerComponentBase;
 class FVoxelRenderOctreeAsyncBuilder;
 
+// Data chunks cached by the invokers prefetch tasks, so that they only clear the caches they created
+struct FVoxelInvokersPrefetchedChunks
+{
+	FCriticalSection Section;
+	// Min of the data chunks
+	TSet<FIntVector> Chunks;
+};
+
 UCLASS()
 class UVoxelDefaultLODSubsystemProxy : public UVoxelLODSubsystemProxy
 {
@@ -49,10 +58,22 @@ private:
 	struct FVoxelInvokerInfo
 	{
 		FIntVector LocalPosition{ForceInit};
+		// Where the invoker is going to be in voxel.lod.InvokerPredictionTime seconds, relative to LocalPosition
+		FIntVector PredictedOffset{ForceInit};
 		FVoxelInvokerSettings Settings;
 	};
+	// Only rebuilt when the invoker components change, so that the invokers order is stable and the render octree can refit its invokers tree
 	TMap<TWeakObjectPtr<UVoxelInvokerComponentBase>, FVoxelInvokerInfo> InvokerComponentsInfos;
-	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> SortedInvokerComponents;
+	// Speculative invokers given to the last octree update. Only replaced when the predictions moved, as any change dirties the octree
+	TArray<FVoxelInvokerSettings> PredictedInvokers;
+
+	// Cancels the previous data prefetch when the predictions change
+	FVoxelCancelCounter PrefetchCancelCounter;
+	// Bounds given to the last prefetch task, to only cancel it if the predictions changed
+	TArray<FVoxelIntBox> QueuedBoundsToPrefetch;
+	// Bounds given to the prefetch tasks, cleared once no invoker is around them anymore
+	TArray<FVoxelIntBox> PrefetchedBounds;
+	const TVoxelSharedRef<FVoxelInvokersPrefetchedChunks> PrefetchedChunks = MakeVoxelShared<FVoxelInvokersPrefetchedChunks>();
 
 	bool bAsyncTaskWorking = false;
 	bool bLODUpdateQueued = true;
@@ -61,6 +82,7 @@ private:
 
 	void UpdateInvokers();
 	void UpdateLODs();
+	void PrefetchData(const TArray<FVoxelIntBox>& BoundsToPrefetch, const TArray<FVoxelIntBox>& InvokersBounds);
 
 	void ClearInvokerComponents();
 };
\ No newline at end of file
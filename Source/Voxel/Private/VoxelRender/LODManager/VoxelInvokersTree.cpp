@@ -0,0 +1,223 @@
+// Copyright 2021 Phyronnaz
+
+#include "VoxelInvokersTree.h"
+#include "VoxelMinimal.h"
+
+void FVoxelInvokersTree::Update(const TArray<FVoxelInvokerSettings>& Invokers)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	for (int32 TypeIndex = 0; TypeIndex < 3; TypeIndex++)
+	{
+		const EVoxelInvokerBoundsType Type = EVoxelInvokerBoundsType(TypeIndex);
+		FTree& Tree = Trees[TypeIndex];
+
+		if (!Refit(Tree, Invokers, Type))
+		{
+			Build(Tree, Invokers, Type);
+		}
+	}
+}
+
+bool FVoxelInvokersTree::Intersect(EVoxelInvokerBoundsType Type, const FVoxelIntBox& Bounds, int32 MaxLODToSet) const
+{
+	const TArray<FNode>& Nodes = Trees[int32(Type)].Nodes;
+	if (Nodes.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(false)];
+		if (Node.MinLODToSet >= MaxLODToSet || !Node.Bounds.Intersect(Bounds))
+		{
+			continue;
+		}
+		if (Node.ChildIndex == -1)
+		{
+			return true;
+		}
+
+		Stack.Add(Node.ChildIndex);
+		Stack.Add(Node.ChildIndex + 1);
+	}
+
+	return false;
+}
+
+bool FVoxelInvokersTree::IntersectBruteForce(const TArray<FVoxelInvokerSettings>& Invokers, EVoxelInvokerBoundsType Type, const FVoxelIntBox& Bounds, int32 MaxLODToSet)
+{
+	for (const FVoxelInvokerSettings& Invoker : Invokers)
+	{
+		if (IsUsedFor(Invoker, Type) &&
+			(Type != EVoxelInvokerBoundsType::LOD || Invoker.LODToSet < MaxLODToSet) &&
+			GetBounds(Invoker, Type).Intersect(Bounds))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelInvokersTree::Build(FTree& Tree, const TArray<FVoxelInvokerSettings>& Invokers, EVoxelInvokerBoundsType Type)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	Tree.Nodes.Reset();
+	Tree.InvokerIndices.Reset();
+	Tree.BuiltVolume = 0;
+
+	for (int32 Index = 0; Index < Invokers.Num(); Index++)
+	{
+		if (IsUsedFor(Invokers[Index], Type))
+		{
+			Tree.InvokerIndices.Add(Index);
+		}
+	}
+
+	if (Tree.InvokerIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// A binary tree with N leaves has 2N - 1 nodes
+	Tree.Nodes.Reserve(2 * Tree.InvokerIndices.Num() - 1);
+	Tree.Nodes.AddDefaulted();
+
+	TArray<int32> SortedIndices = Tree.InvokerIndices;
+	BuildNode(Tree, SortedIndices, Invokers, Type, 0);
+
+	Tree.BuiltVolume = GetVolume(Tree);
+}
+
+bool FVoxelInvokersTree::Refit(FTree& Tree, const TArray<FVoxelInvokerSettings>& Invokers, EVoxelInvokerBoundsType Type)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	// Can only refit if the same invokers are used
+	int32 NumUsed = 0;
+	for (int32 Index = 0; Index < Invokers.Num(); Index++)
+	{
+		if (IsUsedFor(Invokers[Index], Type))
+		{
+			if (!Tree.InvokerIndices.IsValidIndex(NumUsed) || Tree.InvokerIndices[NumUsed] != Index)
+			{
+				return false;
+			}
+			NumUsed++;
+		}
+	}
+	if (NumUsed != Tree.InvokerIndices.Num())
+	{
+		return false;
+	}
+	if (NumUsed == 0)
+	{
+		return true;
+	}
+
+	for (int32 NodeIndex = Tree.Nodes.Num() - 1; NodeIndex >= 0; NodeIndex--)
+	{
+		FNode& Node = Tree.Nodes[NodeIndex];
+		if (Node.ChildIndex == -1)
+		{
+			const FVoxelInvokerSettings& Invoker = Invokers[Node.InvokerIndex];
+			Node.Bounds = GetBounds(Invoker, Type);
+			Node.MinLODToSet = Type == EVoxelInvokerBoundsType::LOD ? Invoker.LODToSet : MIN_int32;
+		}
+		else
+		{
+			const FNode& ChildA = Tree.Nodes[Node.ChildIndex];
+			const FNode& ChildB = Tree.Nodes[Node.ChildIndex + 1];
+			Node.Bounds = ChildA.Bounds.Union(ChildB.Bounds);
+			Node.MinLODToSet = FMath::Min(ChildA.MinLODToSet, ChildB.MinLODToSet);
+		}
+	}
+
+	// Rebuild if the invokers moved too much since the tree was built
+	return GetVolume(Tree) <= 2 * Tree.BuiltVolume;
+}
+
+int32 FVoxelInvokersTree::BuildNode(FTree& Tree, TArrayView<int32> Invokers, const TArray<FVoxelInvokerSettings>& AllInvokers, EVoxelInvokerBoundsType Type, int32 NodeIndex)
+{
+	check(Invokers.Num() > 0);
+
+	if (Invokers.Num() == 1)
+	{
+		const FVoxelInvokerSettings& Invoker = AllInvokers[Invokers[0]];
+
+		FNode& Node = Tree.Nodes[NodeIndex];
+		Node.Bounds = GetBounds(Invoker, Type);
+		Node.MinLODToSet = Type == EVoxelInvokerBoundsType::LOD ? Invoker.LODToSet : MIN_int32;
+		Node.ChildIndex = -1;
+		Node.InvokerIndex = Invokers[0];
+		return NodeIndex;
+	}
+
+	// Use doubled centers to stay in integers
+	const auto GetCenter = [&](int32 InvokerIndex, int32 Axis)
+	{
+		const FVoxelIntBox& Bounds = GetBounds(AllInvokers[InvokerIndex], Type);
+		return int64(Bounds.Min[Axis]) + int64(Bounds.Max[Axis]);
+	};
+
+	// Split along the axis with the biggest spread of centers
+	int32 SplitAxis = 0;
+	int64 BiggestSpread = -1;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		int64 Min = MAX_int64;
+		int64 Max = MIN_int64;
+		for (const int32 InvokerIndex : Invokers)
+		{
+			const int64 Center = GetCenter(InvokerIndex, Axis);
+			Min = FMath::Min(Min, Center);
+			Max = FMath::Max(Max, Center);
+		}
+		if (Max - Min > BiggestSpread)
+		{
+			BiggestSpread = Max - Min;
+			SplitAxis = Axis;
+		}
+	}
+
+	Invokers.Sort([&](int32 A, int32 B) { return GetCenter(A, SplitAxis) < GetCenter(B, SplitAxis); });
+
+	const int32 ChildIndex = Tree.Nodes.Num();
+	Tree.Nodes.AddDefaulted(2);
+
+	const int32 Half = Invokers.Num() / 2;
+	BuildNode(Tree, Invokers.Slice(0, Half), AllInvokers, Type, ChildIndex);
+	BuildNode(Tree, Invokers.Slice(Half, Invokers.Num() - Half), AllInvokers, Type, ChildIndex + 1);
+
+	// Nodes might have been reallocated
+	FNode& Node = Tree.Nodes[NodeIndex];
+	const FNode& ChildA = Tree.Nodes[ChildIndex];
+	const FNode& ChildB = Tree.Nodes[ChildIndex + 1];
+	Node.Bounds = ChildA.Bounds.Union(ChildB.Bounds);
+	Node.MinLODToSet = FMath::Min(ChildA.MinLODToSet, ChildB.MinLODToSet);
+	Node.ChildIndex = ChildIndex;
+	Node.InvokerIndex = -1;
+	return NodeIndex;
+}
+
+double FVoxelInvokersTree::GetVolume(const FTree& Tree)
+{
+	double Volume = 0;
+	for (const FNode& Node : Tree.Nodes)
+	{
+		Volume +=
+			(double(Node.Bounds.Max.X) - Node.Bounds.Min.X) *
+			(double(Node.Bounds.Max.Y) - Node.Bounds.Min.Y) *
+			(double(Node.Bounds.Max.Z) - Node.Bounds.Min.Z);
+	}
+	return Volume;
+}
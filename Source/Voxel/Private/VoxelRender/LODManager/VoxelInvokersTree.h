@@ -0,0 +1,77 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelIntBox.h"
+#include "VoxelInvokerSettings.h"
+
+enum class EVoxelInvokerBoundsType : uint8
+{
+	LOD,
+	Collisions,
+	Navmesh
+};
+
+// Bounding volume hierarchy over the invokers bounds, so that render octree chunks don't have to check every invoker
+// When the invokers only moved, the hierarchy is refit instead of being rebuilt
+class FVoxelInvokersTree
+{
+public:
+	FVoxelInvokersTree() = default;
+
+	void Update(const TArray<FVoxelInvokerSettings>& Invokers);
+
+	// Is there an invoker using Type whose bounds intersect Bounds?
+	// For LOD, only invokers with LODToSet < MaxLODToSet are considered
+	bool Intersect(EVoxelInvokerBoundsType Type, const FVoxelIntBox& Bounds, int32 MaxLODToSet = MAX_int32) const;
+
+	// Same as Intersect, by iterating all the invokers
+	static bool IntersectBruteForce(const TArray<FVoxelInvokerSettings>& Invokers, EVoxelInvokerBoundsType Type, const FVoxelIntBox& Bounds, int32 MaxLODToSet = MAX_int32);
+
+	FORCEINLINE static bool IsUsedFor(const FVoxelInvokerSettings& Invoker, EVoxelInvokerBoundsType Type)
+	{
+		switch (Type)
+		{
+		default: checkVoxelSlow(false);
+		case EVoxelInvokerBoundsType::LOD: return Invoker.bUseForLOD;
+		case EVoxelInvokerBoundsType::Collisions: return Invoker.bUseForCollisions;
+		case EVoxelInvokerBoundsType::Navmesh: return Invoker.bUseForNavmesh;
+		}
+	}
+	FORCEINLINE static const FVoxelIntBox& GetBounds(const FVoxelInvokerSettings& Invoker, EVoxelInvokerBoundsType Type)
+	{
+		switch (Type)
+		{
+		default: checkVoxelSlow(false);
+		case EVoxelInvokerBoundsType::LOD: return Invoker.LODBounds;
+		case EVoxelInvokerBoundsType::Collisions: return Invoker.CollisionsBounds;
+		case EVoxelInvokerBoundsType::Navmesh: return Invoker.NavmeshBounds;
+		}
+	}
+
+private:
+	struct FNode
+	{
+		FVoxelIntBox Bounds;
+		int32 MinLODToSet = 0;
+		// If -1, this is a leaf. Else the children are ChildIndex and ChildIndex + 1
+		int32 ChildIndex = -1;
+		int32 InvokerIndex = -1;
+	};
+	struct FTree
+	{
+		// Children are always after their parent
+		TArray<FNode> Nodes;
+		// Indices of the invokers in the tree, sorted
+		TArray<int32> InvokerIndices;
+		// Sum of the volume of the nodes when the tree was built, to know when refitting made it too loose
+		double BuiltVolume = 0;
+	};
+	FTree Trees[3];
+
+	static void Build(FTree& Tree, const TArray<FVoxelInvokerSettings>& Invokers, EVoxelInvokerBoundsType Type);
+	static bool Refit(FTree& Tree, const TArray<FVoxelInvokerSettings>& Invokers, EVoxelInvokerBoundsType Type);
+	static int32 BuildNode(FTree& Tree, TArrayView<int32> Invokers, const TArray<FVoxelInvokerSettings>& AllInvokers, EVoxelInvokerBoundsType Type, int32 NodeIndex);
+	static double GetVolume(const FTree& Tree);
+};
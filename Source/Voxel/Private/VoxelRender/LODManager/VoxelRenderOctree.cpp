@@ -4,6 +4,7 @@
 #include "VoxelDebug/VoxelDebugManager.h"
 #include "VoxelMessages.h"
 #include "Async/Async.h"
+#include "Misc/ScopeLock.h"
 
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Voxel Render Octrees Count"), STAT_VoxelRenderOctreesCount, STATGROUP_VoxelCounters);
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelRenderOctreesMemory);
@@ -14,6 +15,25 @@ static TAutoConsoleVariable<int32> CVarMaxRenderOctreeChunks(
 	TEXT("Max render octree chunks. Allows to stop the creation of the octree before it gets too big & freezes your computer"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarIncrementalRenderOctree(
+	TEXT("voxel.renderer.IncrementalRenderOctree"),
+	1,
+	TEXT("If true, the render octree will be updated in place and only around the invokers that changed, instead of being cloned and entirely recomputed"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCheckIncrementalRenderOctree(
+	TEXT("voxel.renderer.CheckIncrementalRenderOctree"),
+	0,
+	TEXT("If true, each incremental render octree update will also be done as a full update on a copy of the octree, and their chunk updates will be compared. Slow, for debugging only"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarParallelRenderOctreeDepth(
+	TEXT("voxel.renderer.ParallelRenderOctreeDepth"),
+	2,
+	TEXT("The chunks in the top N levels of the render octree update their children in parallel, splitting the octree into up to 8^N subtrees. ")
+	TEXT("Neighbors across subtree borders are fixed up afterwards. 0 to build the render octree on a single thread"),
+	ECVF_Default);
+
 static TAutoConsoleVariable<int32> CVarLogRenderOctreeBuildTime(
 	TEXT("voxel.renderer.LogRenderOctreeBuildTime"),
 	0,
@@ -37,6 +57,7 @@ void FVoxelRenderOctreeAsyncBuilder::Init(const FVoxelRenderOctreeSettings& InOc
 	VOXEL_FUNCTION_COUNTER();
 
 	OctreeSettings = InOctreeSettings;
+	OctreeSettings.PendingBounds = MoveTemp(PendingBounds);
 	OldOctree = InOctree;
 
 	SetIsDone(false);
@@ -71,6 +92,39 @@ void FVoxelRenderOctreeAsyncBuilder::ReportBuildTime()
 	}
 }
 
+static bool AreChunkUpdatesEqual(TArray<FVoxelChunkUpdate> A, TArray<FVoxelChunkUpdate> B)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	if (A.Num() != B.Num())
+	{
+		LOG_VOXEL(Warning, TEXT("Render octree check: %d chunk updates vs %d"), A.Num(), B.Num());
+		return false;
+	}
+
+	// Only the chunk updates themselves matter, not the order they were gathered in
+	const auto SortById = [](const FVoxelChunkUpdate& X, const FVoxelChunkUpdate& Y) { return X.Id < Y.Id; };
+	A.Sort(SortById);
+	B.Sort(SortById);
+
+	for (int32 Index = 0; Index < A.Num(); Index++)
+	{
+		const FVoxelChunkUpdate& X = A[Index];
+		const FVoxelChunkUpdate& Y = B[Index];
+		if (X.Id != Y.Id ||
+			X.LOD != Y.LOD ||
+			X.Bounds != Y.Bounds ||
+			X.OldSettings != Y.OldSettings ||
+			X.NewSettings != Y.NewSettings)
+		{
+			LOG_VOXEL(Warning, TEXT("Render octree check: chunk update %llu LOD %d %s differs from chunk update %llu LOD %d %s"),
+				X.Id, X.LOD, *X.Bounds.ToString(), Y.Id, Y.LOD, *Y.Bounds.ToString());
+			return false;
+		}
+	}
+	return true;
+}
+
 void FVoxelRenderOctreeAsyncBuilder::DoWork()
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
@@ -78,36 +132,191 @@ void FVoxelRenderOctreeAsyncBuilder::DoWork()
 	LOG_TIME_IMPL("Waiting in thread pool", Counter);
 
 	double WorkStartTime = FPlatformTime::Seconds();
-	
+
+	const bool bUseIncrementalUpdates = CVarIncrementalRenderOctree.GetValueOnAnyThread() != 0;
+
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Resetting arrays");
+		ChunkUpdates.Reset();
+		NewOctree.Reset();
+		LOG_TIME("Resetting arrays");
+	}
+
+	if (!OldOctree.IsValid())
+	{
+		OldOctreeSettings.Reset();
+	}
+
+	TVoxelSharedPtr<FVoxelRenderOctree> Octree;
+	if (bUseIncrementalUpdates && 
+		OldOctree.IsValid() &&
+		OctreeToDelete.IsValid() && 
+		OctreeToDelete.IsUnique() &&
+		OldOctreeSettings.IsSet() && 
+		OctreeToDeleteSettings.IsSet() &&
+		bOldOctreeUpdatedIncrementally)
+	{
+		// OctreeToDelete is one update late: replay that update on it, instead of cloning OldOctree
+		// The updates are deterministic, so this gives the same octree with the same chunk ids
+		// Only done for incremental updates: replaying a full update is more expensive than a clone
+		VOXEL_ASYNC_SCOPE_COUNTER("Replaying previous update");
+
+		Octree = MoveTemp(OctreeToDelete);
+
+		bool bReplayed = false;
+		FVoxelRenderOctreeDirtyBounds DirtyBounds;
+		if (DirtyBounds.Init(OctreeToDeleteSettings.GetValue(), OldOctreeSettings.GetValue()))
+		{
+			TArray<FVoxelChunkUpdate> UnusedChunkUpdates;
+			UpdateOctree(*Octree, OldOctreeSettings.GetValue(), &DirtyBounds, UnusedChunkUpdates);
+
+			// The counters can match while the chunks differ, eg one subdivision offset by one merge: compare the chunks themselves
+			// Still much cheaper than a clone, as nothing is allocated
+			bReplayed =
+				!Octree->IsCanceled() &&
+				Octree->UpdateIndex == OldOctree->UpdateIndex &&
+				Octree->GetRootIdCounter() == OldOctree->GetRootIdCounter() &&
+				Octree->CurrentChunksCount.GetValue() == OldOctree->CurrentChunksCount.GetValue() &&
+				Octree->HasSameChunks(*OldOctree);
+		}
+
+		if (!bReplayed)
+		{
+			LOG_VOXEL(Verbose, TEXT("Failed to replay the previous render octree update, cloning it instead"));
+			OctreeToDelete = MoveTemp(Octree);
+		}
+		LOG_TIME("Replaying previous update");
+	}
+	OctreeToDeleteSettings.Reset();
+
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("Deleting previous octree");
 		OctreeToDelete.Reset();
 		LOG_TIME("Deleting previous octree");
 	}
 
+	if (!Octree.IsValid())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Cloning octree");
+		Octree = OldOctree.IsValid() ? MakeVoxelShared<FVoxelRenderOctree>(*OldOctree) : MakeVoxelShared<FVoxelRenderOctree>(OctreeSettings.ChunkSize, OctreeDepth);
+		LOG_TIME("Cloning octree");
+	}
+
+	FVoxelRenderOctreeDirtyBounds DirtyBounds;
+	const bool bIncremental = bUseIncrementalUpdates && OldOctreeSettings.IsSet() && DirtyBounds.Init(OldOctreeSettings.GetValue(), OctreeSettings);
+	Log += "; Incremental: " + FString(bIncremental ? "true" : "false");
+
+	TVoxelSharedPtr<FVoxelRenderOctree> FullUpdateOctree;
+	if (bIncremental && CVarCheckIncrementalRenderOctree.GetValueOnAnyThread())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Cloning octree for the full update check");
+		FullUpdateOctree = MakeVoxelShared<FVoxelRenderOctree>(*Octree);
+	}
+
+	UpdateOctree(*Octree, OctreeSettings, bIncremental ? &DirtyBounds : nullptr, ChunkUpdates, &PendingBounds);
+
+	if (FullUpdateOctree.IsValid())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Checking incremental update");
+		TArray<FVoxelChunkUpdate> FullChunkUpdates;
+		UpdateOctree(*FullUpdateOctree, OctreeSettings, nullptr, FullChunkUpdates);
+		if (!Octree->IsCanceled() && !FullUpdateOctree->IsCanceled())
+		{
+			ensureMsgf(AreChunkUpdatesEqual(ChunkUpdates, FullChunkUpdates), TEXT("Incremental render octree update differs from the full update"));
+			ensureMsgf(Octree->GetRootIdCounter() == FullUpdateOctree->GetRootIdCounter(), TEXT("Incremental render octree update assigned different chunk ids"));
+		}
+		LOG_TIME("Checking incremental update");
+	}
+
+	NewOctree = Octree;
+	Log += "; Pending chunks: " + FString::FromInt(PendingBounds.Num());
+
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Sort By LODs");
+		// Make sure that LOD 0 chunks are processed first
+		ChunkUpdates.Sort([](const auto& A, const auto& B) { return A.LOD < B.LOD; });
+		LOG_TIME("Sort By LODs");
+	}
+
+	if (OldOctree.IsValid())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Find previous chunks");
+		for (auto& ChunkUpdate : ChunkUpdates)
+		{
+			if (ChunkUpdate.NewSettings.bVisible && !ChunkUpdate.OldSettings.bVisible)
+			{
+				OldOctree->GetVisibleChunksOverlappingBounds(ChunkUpdate.Bounds, ChunkUpdate.PreviousChunks);
+			}
+		}
+	}
+	LOG_TIME("Find previous chunks");
+
+	NumberOfChunks = NewOctree->CurrentChunksCount.GetValue();
+	bTooManyChunks = NewOctree->IsCanceled();
+
+	if (bTooManyChunks)
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Resetting arrays");
-		ChunkUpdates.Reset();
 		NewOctree.Reset();
-		LOG_TIME("Resetting arrays");
+		PendingBounds.Reset();
+	}
+	else
+	{
+		// The game thread will give us OldOctree back through OctreeToDelete
+		if (OldOctree.IsValid())
+		{
+			OctreeToDeleteSettings = OldOctreeSettings;
+		}
+		OldOctreeSettings = OctreeSettings;
+		bOldOctreeUpdatedIncrementally = bIncremental;
 	}
+
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Deleting old octree");
+		OldOctree.Reset();
+		LOG_TIME("Deleting old octree");
+	}
+
+	LOG_TIME_IMPL("Total time working", WorkStartTime);
+}
+
+bool FVoxelRenderOctreeAsyncBuilder::UpdateOctree(
+	FVoxelRenderOctree& Octree,
+	FVoxelRenderOctreeSettings Settings, 
+	const FVoxelRenderOctreeDirtyBounds* DirtyBounds,
+	TArray<FVoxelChunkUpdate>& OutChunkUpdates,
+	TArray<FVoxelIntBox>* OutPendingBounds)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	Settings.ParallelDepth = FMath::Max(0, CVarParallelRenderOctreeDepth.GetValueOnAnyThread());
+
+	FVoxelRenderOctreePendingBounds NewPendingBounds;
+	Settings.NewPendingBounds = &NewPendingBounds;
 	
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Cloning octree");
-		NewOctree = OldOctree.IsValid() ? MakeVoxelShared<FVoxelRenderOctree>(*OldOctree) : MakeVoxelShared<FVoxelRenderOctree>(OctreeSettings.ChunkSize, OctreeDepth);
-		LOG_TIME("Cloning octree");
+		VOXEL_ASYNC_SCOPE_COUNTER("Update invokers tree");
+		InvokersTree.Update(Settings.Invokers);
+		Settings.InvokersTree = &InvokersTree;
+		LOG_TIME("Update invokers tree");
 	}
 
+	if (DirtyBounds)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("MarkChunksToUpdate");
+		Octree.MarkChunksToUpdate(*DirtyBounds);
+		LOG_TIME("MarkChunksToUpdate");
+	}
+	else
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("ResetDivisionType");
-		NewOctree->ResetDivisionType();
+		Octree.ResetDivisionType();
 		LOG_TIME("ResetDivisionType");
 	}
 
 	bool bChanged;
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("UpdateSubdividedByDistance");
-		bChanged = NewOctree->UpdateSubdividedByDistance(OctreeSettings);
+		bChanged = Octree.UpdateSubdividedByDistance(Settings);
 		LOG_TIME("UpdateSubdividedByDistance");
 		Log += "; Need to recompute neighbors: " + FString(bChanged ? "true" : "false");
 	}
@@ -115,82 +324,258 @@ void FVoxelRenderOctreeAsyncBuilder::DoWork()
 	if (bChanged)
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("UpdateSubdividedByNeighbors");
-		int32 UpdateSubdividedByNeighborsCounter = 0;
-		while (NewOctree->UpdateSubdividedByNeighbors(OctreeSettings)) { UpdateSubdividedByNeighborsCounter++; }
+		const int32 UpdateSubdividedByNeighborsCounter = Octree.UpdateSubdividedByNeighbors(Settings);
 		LOG_TIME("UpdateSubdividedByNeighbors");
 		Log += "; Iterations: " + FString::FromInt(UpdateSubdividedByNeighborsCounter);
 	}
 	else
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("ReuseOldNeighbors");
-		NewOctree->ReuseOldNeighbors();
+		Octree.ReuseOldNeighbors();
 	}
 	
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("UpdateSubdividedByOthers");
-		NewOctree->UpdateSubdividedByOthers(OctreeSettings);
+		Octree.UpdateSubdividedByOthers(Settings);
 		LOG_TIME("UpdateSubdividedByOthers");
 	}
+
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("AssignChunkIds");
+		Octree.AssignChunkIds();
+		LOG_TIME("AssignChunkIds");
+	}
 	
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("DeleteChunks");
-		NewOctree->DeleteChunks(ChunkUpdates);
+		Octree.DeleteChunks(Settings, OutChunkUpdates);
 		LOG_TIME("DeleteChunks");
 	}
 	
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("GetUpdates");
-		NewOctree->GetUpdates(NewOctree->UpdateIndex + 1, bChanged, OctreeSettings, ChunkUpdates);
+		Octree.GetUpdates(Octree.UpdateIndex + 1, bChanged, Settings, OutChunkUpdates);
 		LOG_TIME("GetUpdates");
 	}
-	
+
+	if (OutPendingBounds)
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Sort By LODs");
-		// Make sure that LOD 0 chunks are processed first
-		ChunkUpdates.Sort([](const auto& A, const auto& B) { return A.LOD < B.LOD; });
-		LOG_TIME("Sort By LODs");
+		*OutPendingBounds = MoveTemp(NewPendingBounds.Bounds);
 	}
 
-	if (OldOctree.IsValid())
+	return bChanged;
+}
+
+#undef LOG_TIME
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int32 FVoxelRenderOctreeSettings::GetHysteresis(int32 Height) const
+{
+	if (LODHysteresis.Num() == 0)
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Find previous chunks");
-		for (auto& ChunkUpdate : ChunkUpdates)
+		return 0;
+	}
+
+	const float Fraction = LODHysteresis[FMath::Min(Height, LODHysteresis.Num() - 1)];
+	// Clamp to avoid overflows when extending the chunk bounds
+	return int32(FMath::Min<double>(Fraction * double(int64(ChunkSize) << Height), MAX_int32 / 4));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+inline bool AreInvokersEqual(const FVoxelInvokerSettings& A, const FVoxelInvokerSettings& B)
+{
+	return
+		A.bUseForLOD == B.bUseForLOD &&
+		A.LODToSet == B.LODToSet &&
+		A.LODBounds == B.LODBounds &&
+		A.bUseForCollisions == B.bUseForCollisions &&
+		A.CollisionsBounds == B.CollisionsBounds &&
+		A.bUseForNavmesh == B.bUseForNavmesh &&
+		A.NavmeshBounds == B.NavmeshBounds;
+}
+
+bool FVoxelRenderOctreeDirtyBounds::Init(const FVoxelRenderOctreeSettings& OldSettings, const FVoxelRenderOctreeSettings& NewSettings)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	LODBounds.Reset();
+	OthersBounds.Reset();
+	MaxHysteresis = 0;
+
+	if (OldSettings.ChunkSize != NewSettings.ChunkSize ||
+		OldSettings.MinLOD != NewSettings.MinLOD ||
+		OldSettings.MaxLOD != NewSettings.MaxLOD ||
+		OldSettings.WorldBounds != NewSettings.WorldBounds ||
+		OldSettings.ChunksCullingLOD != NewSettings.ChunksCullingLOD ||
+		OldSettings.bEnableRender != NewSettings.bEnableRender ||
+		OldSettings.bEnableTransitions != NewSettings.bEnableTransitions ||
+		OldSettings.bInvertTransitions != NewSettings.bInvertTransitions ||
+		OldSettings.bEnableCollisions != NewSettings.bEnableCollisions ||
+		OldSettings.bComputeVisibleChunksCollisions != NewSettings.bComputeVisibleChunksCollisions ||
+		OldSettings.VisibleChunksCollisionsMaxLOD != NewSettings.VisibleChunksCollisionsMaxLOD ||
+		OldSettings.bEnableNavmesh != NewSettings.bEnableNavmesh ||
+		OldSettings.bComputeVisibleChunksNavmesh != NewSettings.bComputeVisibleChunksNavmesh ||
+		OldSettings.VisibleChunksNavmeshMaxLOD != NewSettings.VisibleChunksNavmeshMaxLOD ||
+		OldSettings.LODHysteresis != NewSettings.LODHysteresis ||
+		OldSettings.MinChunkLifetime != NewSettings.MinChunkLifetime)
+	{
+		return false;
+	}
+
+	for (const float Hysteresis : NewSettings.LODHysteresis)
+	{
+		MaxHysteresis = FMath::Max(MaxHysteresis, Hysteresis);
+	}
+
+	// The chunks kept back by the last update need to be updated even if no invoker moved
+	LODBounds.Append(NewSettings.PendingBounds);
+
+	const auto AddInvoker = [&](const FVoxelInvokerSettings& Invoker)
+	{
+		if (Invoker.bUseForLOD)
 		{
-			if (ChunkUpdate.NewSettings.bVisible && !ChunkUpdate.OldSettings.bVisible)
+			LODBounds.Add(Invoker.LODBounds);
+		}
+		if (Invoker.bUseForCollisions)
+		{
+			OthersBounds.Add(Invoker.CollisionsBounds);
+		}
+		if (Invoker.bUseForNavmesh)
+		{
+			OthersBounds.Add(Invoker.NavmeshBounds);
+		}
+	};
+
+	// Invokers are not sorted: match them by value
+	TArray<bool> IsNewInvokerMatched;
+	IsNewInvokerMatched.SetNumZeroed(NewSettings.Invokers.Num());
+	for (const FVoxelInvokerSettings& OldInvoker : OldSettings.Invokers)
+	{
+		bool bMatched = false;
+		for (int32 Index = 0; Index < NewSettings.Invokers.Num(); Index++)
+		{
+			if (!IsNewInvokerMatched[Index] && AreInvokersEqual(OldInvoker, NewSettings.Invokers[Index]))
 			{
-				OldOctree->GetVisibleChunksOverlappingBounds(ChunkUpdate.Bounds, ChunkUpdate.PreviousChunks);
+				IsNewInvokerMatched[Index] = true;
+				bMatched = true;
+				break;
 			}
 		}
+		if (!bMatched)
+		{
+			AddInvoker(OldInvoker);
+		}
 	}
-	LOG_TIME("Find previous chunks");
-	
+	for (int32 Index = 0; Index < NewSettings.Invokers.Num(); Index++)
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Deleting old octree");
-		OldOctree.Reset();
-		LOG_TIME("Deleting old octree");
+		if (!IsNewInvokerMatched[Index])
+		{
+			AddInvoker(NewSettings.Invokers[Index]);
+		}
 	}
 
-	NumberOfChunks = NewOctree->CurrentChunksCount;
-	bTooManyChunks = NewOctree->IsCanceled();
+	return true;
+}
 
-	if (bTooManyChunks)
+bool FVoxelRenderOctreeDirtyBounds::NeedsUpdate(const FVoxelIntBox& Bounds, uint32 Size) const
+{
+	// Chunk subdivisions can be forced by neighbors up to Size / 2 away, and transitions depend on chunks up to 4 * Size away
+	// Subdivisions by distance can also be kept by invokers up to MaxHysteresis * Size away
+	// Use int64 as this might not fit in an int32 for big chunks
+	const int64 Distance = (5 + FMath::CeilToInt(MaxHysteresis)) * int64(Size);
+	for (const FVoxelIntBox& LODBound : LODBounds)
 	{
-		NewOctree.Reset();
+		if (int64(Bounds.Min.X) - Distance < LODBound.Max.X && LODBound.Min.X < int64(Bounds.Max.X) + Distance &&
+			int64(Bounds.Min.Y) - Distance < LODBound.Max.Y && LODBound.Min.Y < int64(Bounds.Max.Y) + Distance &&
+			int64(Bounds.Min.Z) - Distance < LODBound.Max.Z && LODBound.Min.Z < int64(Bounds.Max.Z) + Distance)
+		{
+			return true;
+		}
 	}
 
-	LOG_TIME_IMPL("Total time working", WorkStartTime);
-}
+	// Collisions & navmesh don't change the visible chunks
+	for (const FVoxelIntBox& OthersBound : OthersBounds)
+	{
+		if (Bounds.Intersect(OthersBound))
+		{
+			return true;
+		}
+	}
 
-#undef LOG_TIME
+	return false;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+inline bool IsVisibleParent(FVoxelRenderOctree::EDivisionType DivisionType)
+{
+	return DivisionType == FVoxelRenderOctree::EDivisionType::ByDistance || DivisionType == FVoxelRenderOctree::EDivisionType::ByNeighbors;
+}
+
 #define CHECK_MAX_CHUNKS_COUNT_IMPL(ReturnValue) if (IsCanceled()) { return ReturnValue; }
 #define CHECK_MAX_CHUNKS_COUNT() CHECK_MAX_CHUNKS_COUNT_IMPL(;)
 #define CHECK_MAX_CHUNKS_COUNT_BOOL() CHECK_MAX_CHUNKS_COUNT_IMPL(false)
 
+FORCEINLINE bool FVoxelRenderOctree::AreChildrenUpdatedInParallel(const FVoxelRenderOctreeSettings& Settings) const
+{
+	return Root->Height - Height < Settings.ParallelDepth;
+}
+
+template<typename T>
+FORCEINLINE void FVoxelRenderOctree::IterateChildren(const FVoxelRenderOctreeSettings& Settings, T Lambda)
+{
+	ChildrenArray& Children = GetChildren();
+	if (AreChildrenUpdatedInParallel(Settings))
+	{
+		ParallelFor(8, [&](int32 Index)
+		{
+			Lambda(Children[Index], Index);
+		});
+	}
+	else
+	{
+		for (int32 Index = 0; Index < 8; Index++)
+		{
+			Lambda(Children[Index], Index);
+		}
+	}
+}
+
+template<typename T>
+FORCEINLINE void FVoxelRenderOctree::IterateChildren(const FVoxelRenderOctreeSettings& Settings, TArray<FVoxelChunkUpdate>& ChunkUpdates, T Lambda)
+{
+	ChildrenArray& Children = GetChildren();
+	if (AreChildrenUpdatedInParallel(Settings))
+	{
+		TArray<FVoxelChunkUpdate> ChildrenChunkUpdates[8];
+		ParallelFor(8, [&](int32 Index)
+		{
+			Lambda(Children[Index], ChildrenChunkUpdates[Index]);
+		});
+		for (TArray<FVoxelChunkUpdate>& ChildChunkUpdates : ChildrenChunkUpdates)
+		{
+			ChunkUpdates.Append(MoveTemp(ChildChunkUpdates));
+		}
+	}
+	else
+	{
+		for (auto& Child : Children)
+		{
+			Lambda(Child, ChunkUpdates);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 FVoxelRenderOctree::FVoxelRenderOctree(uint32 ChunkSize, uint8 LOD)
 	: TSimpleVoxelOctree(ChunkSize, LOD)
 	, Root(this)
@@ -199,7 +584,8 @@ FVoxelRenderOctree::FVoxelRenderOctree(uint32 ChunkSize, uint8 LOD)
 {
 	check(LOD > 0);
 	check(ChunkId <= Root->RootIdCounter);
-	Root->CurrentChunksCount++;
+	Root->CurrentChunksCount.Increment();
+	ChunkSettings.bNeedsUpdate = true;
 
 	INC_DWORD_STAT_BY(STAT_VoxelRenderOctreesCount, 1);
 	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelRenderOctreesMemory, sizeof(FVoxelRenderOctree));
@@ -214,7 +600,7 @@ FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree& Source)
 	, UpdateIndex(Source.UpdateIndex)
 {
 	check(ChunkId <= Root->RootIdCounter);
-	Root->CurrentChunksCount++;
+	Root->CurrentChunksCount.Increment();
 	ChunkSettings = Source.ChunkSettings;
 	if (Source.HasChildren())
 	{
@@ -229,12 +615,13 @@ FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree& Source)
 FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree& Parent, uint8 ChildIndex)
 	: TSimpleVoxelOctree(Parent, ChildIndex)
 	, Root(Parent.Root)
-	, ChunkId(GetId())
+	, ChunkId(0)
 	, OctreeBounds(GetBounds())
 	, UpdateIndex(Parent.UpdateIndex)
 {
-	check(ChunkId <= Root->RootIdCounter);
-	Root->CurrentChunksCount++;
+	// Might be called from multiple threads: the id is set by AssignChunkIds
+	Root->CurrentChunksCount.Increment();
+	ChunkSettings.bNeedsUpdate = true;
 
 	INC_DWORD_STAT_BY(STAT_VoxelRenderOctreesCount, 1);
 	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelRenderOctreesMemory, sizeof(FVoxelRenderOctree));
@@ -248,7 +635,7 @@ FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree& Parent, uint8 C
 	, OctreeBounds(GetBounds())
 	, UpdateIndex(Parent.UpdateIndex)
 {
-	Root->CurrentChunksCount++;
+	Root->CurrentChunksCount.Increment();
 
 	auto& Source = SourceChildren[ChildIndex];
 	ChunkSettings = Source.ChunkSettings;
@@ -263,7 +650,7 @@ FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree& Parent, uint8 C
 
 FVoxelRenderOctree::~FVoxelRenderOctree()
 {
-	Root->CurrentChunksCount--;
+	Root->CurrentChunksCount.Decrement();
 	DEC_DWORD_STAT_BY(STAT_VoxelRenderOctreesCount, 1);
 	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelRenderOctreesMemory, sizeof(FVoxelRenderOctree));
 }
@@ -274,6 +661,7 @@ void FVoxelRenderOctree::ResetDivisionType()
 {
 	ChunkSettings.OldDivisionType = ChunkSettings.DivisionType;
 	ChunkSettings.DivisionType = EDivisionType::Uninitialized;
+	ChunkSettings.bNeedsUpdate = true;
 
 	if (!!HasChildren())
 	{
@@ -284,11 +672,59 @@ void FVoxelRenderOctree::ResetDivisionType()
 	}
 }
 
+void FVoxelRenderOctree::MarkChunksToUpdate(const FVoxelRenderOctreeDirtyBounds& DirtyBounds)
+{
+	// NeedsUpdate is true for all the parents of a chunk if it's true for that chunk, so we can stop here
+	if (!DirtyBounds.NeedsUpdate(OctreeBounds, Size()))
+	{
+		return;
+	}
+
+	ChunkSettings.OldDivisionType = ChunkSettings.DivisionType;
+	ChunkSettings.DivisionType = EDivisionType::Uninitialized;
+	ChunkSettings.bNeedsUpdate = true;
+
+	if (!!HasChildren())
+	{
+		for (auto& Child : GetChildren())
+		{
+			Child.MarkChunksToUpdate(DirtyBounds);
+		}
+	}
+}
+
 bool FVoxelRenderOctree::UpdateSubdividedByDistance(const FVoxelRenderOctreeSettings& Settings)
 {
 	CHECK_MAX_CHUNKS_COUNT_BOOL();
+
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		// Neither this chunk nor its children can change
+		return false;
+	}
+
+	const bool bWasSubdivided = ChunkSettings.OldDivisionType == EDivisionType::ByDistance;
+	bool bSubdivide = ShouldSubdivideByDistance(Settings);
+	if (bSubdivide != bWasSubdivided)
+	{
+		if (Settings.Time < ChunkSettings.DivisionChangeTime + Settings.MinChunkLifetime)
+		{
+			// Changed too recently: keep it as it is, and update it again later
+			bSubdivide = bWasSubdivided;
+
+			if (Settings.NewPendingBounds)
+			{
+				FScopeLock Lock(&Settings.NewPendingBounds->Section);
+				Settings.NewPendingBounds->Bounds.Add(OctreeBounds);
+			}
+		}
+		else
+		{
+			ChunkSettings.DivisionChangeTime = Settings.Time;
+		}
+	}
 	
-	if (ShouldSubdivideByDistance(Settings))
+	if (bSubdivide)
 	{
 		ChunkSettings.DivisionType = EDivisionType::ByDistance;
 		
@@ -297,12 +733,17 @@ bool FVoxelRenderOctree::UpdateSubdividedByDistance(const FVoxelRenderOctreeSett
 			CreateChildren();
 		}
 		
+		bool ChildrenChanged[8] = {};
+		IterateChildren(Settings, [&](FVoxelRenderOctree& Child, int32 Index)
+		{
+			ChildrenChanged[Index] = Child.UpdateSubdividedByDistance(Settings);
+		});
+
 		bool bChanged = ChunkSettings.OldDivisionType != EDivisionType::ByDistance;
-		for (auto& Child : GetChildren())
+		for (const bool bChildChanged : ChildrenChanged)
 		{
-			bChanged |= Child.UpdateSubdividedByDistance(Settings);
+			bChanged |= bChildChanged;
 		}
-	
 		return bChanged;
 	}
 	else
@@ -311,13 +752,37 @@ bool FVoxelRenderOctree::UpdateSubdividedByDistance(const FVoxelRenderOctreeSett
 	}
 }
 
-bool FVoxelRenderOctree::UpdateSubdividedByNeighbors(const FVoxelRenderOctreeSettings& Settings)
+int32 FVoxelRenderOctree::UpdateSubdividedByNeighbors(const FVoxelRenderOctreeSettings& Settings)
+{
+	check(Root == this);
+
+	int32 Iterations = 0;
+	while (true)
+	{
+		while (UpdateSubdividedByNeighborsInSubtree(Settings, nullptr)) { Iterations++; }
+
+		// Subdividing chunks on a border can in turn require subdividing chunks inside the subtrees
+		if (Settings.ParallelDepth == 0 || !UpdateSubdividedByNeighborsAtSubtreeBorders(Settings, nullptr))
+		{
+			break;
+		}
+		Iterations++;
+	}
+	return Iterations;
+}
+
+bool FVoxelRenderOctree::UpdateSubdividedByNeighborsInSubtree(const FVoxelRenderOctreeSettings& Settings, const FVoxelRenderOctree* Subtree)
 {
 	CHECK_MAX_CHUNKS_COUNT_BOOL();
 
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		return false;
+	}
+
 	bool bShouldContinue = false;
 
-	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized && ShouldSubdivideByNeighbors(Settings))
+	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized && ShouldSubdivideByNeighbors(Settings, Subtree))
 	{
 		ChunkSettings.DivisionType = EDivisionType::ByNeighbors;
 		
@@ -331,17 +796,75 @@ bool FVoxelRenderOctree::UpdateSubdividedByNeighbors(const FVoxelRenderOctreeSet
 
 	if (ChunkSettings.DivisionType != EDivisionType::Uninitialized)
 	{
-		for (auto& Child : GetChildren())
+		const bool bParallel = AreChildrenUpdatedInParallel(Settings);
+
+		bool ChildrenShouldContinue[8] = {};
+		IterateChildren(Settings, [&](FVoxelRenderOctree& Child, int32 Index)
+		{
+			// Other threads are updating the chunks outside of Child
+			ChildrenShouldContinue[Index] = Child.UpdateSubdividedByNeighborsInSubtree(Settings, bParallel ? &Child : Subtree);
+		});
+
+		for (const bool bChildShouldContinue : ChildrenShouldContinue)
 		{
-			bShouldContinue |= Child.UpdateSubdividedByNeighbors(Settings);
+			bShouldContinue |= bChildShouldContinue;
 		}
 	}
 
 	return bShouldContinue;
 }
 
+bool FVoxelRenderOctree::UpdateSubdividedByNeighborsAtSubtreeBorders(const FVoxelRenderOctreeSettings& Settings, const FVoxelRenderOctree* Subtree)
+{
+	CHECK_MAX_CHUNKS_COUNT_BOOL();
+
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		return false;
+	}
+
+	// The neighbors of the chunks strictly inside their subtree were all checked by UpdateSubdividedByNeighborsInSubtree
+	if (Subtree &&
+		OctreeBounds.Min.X != Subtree->OctreeBounds.Min.X && OctreeBounds.Max.X != Subtree->OctreeBounds.Max.X &&
+		OctreeBounds.Min.Y != Subtree->OctreeBounds.Min.Y && OctreeBounds.Max.Y != Subtree->OctreeBounds.Max.Y &&
+		OctreeBounds.Min.Z != Subtree->OctreeBounds.Min.Z && OctreeBounds.Max.Z != Subtree->OctreeBounds.Max.Z)
+	{
+		return false;
+	}
+
+	bool bChanged = false;
+
+	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized && ShouldSubdivideByNeighbors(Settings, nullptr))
+	{
+		ChunkSettings.DivisionType = EDivisionType::ByNeighbors;
+
+		if (!HasChildren())
+		{
+			CreateChildren();
+		}
+
+		bChanged = true;
+	}
+
+	if (ChunkSettings.DivisionType != EDivisionType::Uninitialized)
+	{
+		const bool bParallel = AreChildrenUpdatedInParallel(Settings);
+		for (auto& Child : GetChildren())
+		{
+			bChanged |= Child.UpdateSubdividedByNeighborsAtSubtreeBorders(Settings, bParallel ? &Child : Subtree);
+		}
+	}
+
+	return bChanged;
+}
+
 void FVoxelRenderOctree::ReuseOldNeighbors()
 {
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		return;
+	}
+
 	if (ChunkSettings.OldDivisionType == EDivisionType::ByNeighbors)
 	{
 		ChunkSettings.DivisionType = EDivisionType::ByNeighbors;
@@ -360,6 +883,11 @@ void FVoxelRenderOctree::UpdateSubdividedByOthers(const FVoxelRenderOctreeSettin
 {
 	CHECK_MAX_CHUNKS_COUNT();
 
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		return;
+	}
+
 	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized && ShouldSubdivideByOthers(Settings))
 	{
 		ChunkSettings.DivisionType = EDivisionType::ByOthers;
@@ -372,17 +900,45 @@ void FVoxelRenderOctree::UpdateSubdividedByOthers(const FVoxelRenderOctreeSettin
 
 	if (ChunkSettings.DivisionType != EDivisionType::Uninitialized)
 	{
-		for (auto& Child : GetChildren())
+		IterateChildren(Settings, [&](FVoxelRenderOctree& Child, int32 Index)
 		{
 			Child.UpdateSubdividedByOthers(Settings);
+		});
+	}
+}
+
+void FVoxelRenderOctree::AssignChunkIds()
+{
+	// New chunks and their parents always need an update
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		return;
+	}
+
+	if (ChunkId == 0)
+	{
+		ChunkId = GetId();
+	}
+
+	if (!!HasChildren())
+	{
+		for (auto& Child : GetChildren())
+		{
+			Child.AssignChunkIds();
 		}
 	}
 }
 
-void FVoxelRenderOctree::DeleteChunks(TArray<FVoxelChunkUpdate>& ChunkUpdates)
+void FVoxelRenderOctree::DeleteChunks(const FVoxelRenderOctreeSettings& Settings, TArray<FVoxelChunkUpdate>& ChunkUpdates)
 {
 	CHECK_MAX_CHUNKS_COUNT();
 
+	if (!ChunkSettings.bNeedsUpdate)
+	{
+		// Chunks that don't need an update keep their division type: if they are uninitialized, they have no children already
+		return;
+	}
+
 	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized)
 	{		
 		if (HasChildren())
@@ -391,7 +947,7 @@ void FVoxelRenderOctree::DeleteChunks(TArray<FVoxelChunkUpdate>& ChunkUpdates)
 			{
 				ensure(Child.ChunkSettings.DivisionType == EDivisionType::Uninitialized);
 				
-				Child.DeleteChunks(ChunkUpdates);
+				Child.DeleteChunks(Settings, ChunkUpdates);
 				
 				if (Child.ChunkSettings.Settings.HasRenderChunk())
 				{
@@ -413,10 +969,10 @@ void FVoxelRenderOctree::DeleteChunks(TArray<FVoxelChunkUpdate>& ChunkUpdates)
 	}
 	else
 	{
-		for (auto& Child : GetChildren())
+		IterateChildren(Settings, ChunkUpdates, [&](FVoxelRenderOctree& Child, TArray<FVoxelChunkUpdate>& ChildChunkUpdates)
 		{
-			Child.DeleteChunks(ChunkUpdates);
-		}
+			Child.DeleteChunks(Settings, ChildChunkUpdates);
+		});
 	}
 }
 
@@ -431,8 +987,14 @@ void FVoxelRenderOctree::GetUpdates(
 {
 	CHECK_MAX_CHUNKS_COUNT();
 
-	UpdateIndex++;
-	check(UpdateIndex == InUpdateIndex);
+	check(UpdateIndex < InUpdateIndex);
+	UpdateIndex = InUpdateIndex;
+
+	// The children visibility only depends on our division type
+	const bool bChildrenVisibilityChanged =
+		ChunkSettings.bNeedsUpdate &&
+		IsVisibleParent(ChunkSettings.OldDivisionType) != IsVisibleParent(ChunkSettings.DivisionType);
+	ChunkSettings.bNeedsUpdate = false;
 
 	if (!OctreeBounds.Intersect(Settings.WorldBounds))
 	{
@@ -464,30 +1026,26 @@ void FVoxelRenderOctree::GetUpdates(
 			bChildrenVisible = false;
 		}
 
-		for (auto& Child : GetChildren())
+		IterateChildren(Settings, ChunkUpdates, [&](FVoxelRenderOctree& Child, TArray<FVoxelChunkUpdate>& ChildChunkUpdates)
 		{
-			Child.GetUpdates(UpdateIndex, bRecomputeTransitionMasks, Settings, ChunkUpdates, bChildrenVisible);
-		}
+			// Skip the chunks that can't have changed
+			if (Child.ChunkSettings.bNeedsUpdate || bChildrenVisibilityChanged)
+			{
+				Child.GetUpdates(InUpdateIndex, bRecomputeTransitionMasks, Settings, ChildChunkUpdates, bChildrenVisible);
+			}
+		});
 	}
 
 	NewSettings.bEnableCollisions =
 		Settings.bEnableCollisions &&
-		((Height == 0 &&
-			IsInvokerInRange(Settings.Invokers,
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForCollisions; },
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.CollisionsBounds; })
-		 )
+		((Height == 0 && IsInvokerInRange(Settings, EVoxelInvokerBoundsType::Collisions))
 		 ||
 		 (NewSettings.bVisible && Settings.bComputeVisibleChunksCollisions && Height <= Settings.VisibleChunksCollisionsMaxLOD)
 	    );
 		
 	NewSettings.bEnableNavmesh = 
 		Settings.bEnableNavmesh &&
-		((Height == 0 &&
-			IsInvokerInRange(Settings.Invokers,
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForNavmesh; },
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.NavmeshBounds; })
-		)
+		((Height == 0 && IsInvokerInRange(Settings, EVoxelInvokerBoundsType::Navmesh))
 		||
 		(NewSettings.bVisible && Settings.bComputeVisibleChunksNavmesh && Height <= Settings.VisibleChunksNavmeshMaxLOD)
 		);
@@ -542,6 +1100,34 @@ void FVoxelRenderOctree::GetUpdates(
 	ChunkSettings.Settings = NewSettings;
 }
 
+bool FVoxelRenderOctree::HasSameChunks(const FVoxelRenderOctree& Other) const
+{
+	if (ChunkId != Other.ChunkId ||
+		Height != Other.Height ||
+		OctreeBounds != Other.OctreeBounds ||
+		UpdateIndex != Other.UpdateIndex ||
+		ChunkSettings.Settings != Other.ChunkSettings.Settings ||
+		ChunkSettings.DivisionType != Other.ChunkSettings.DivisionType ||
+		ChunkSettings.OldDivisionType != Other.ChunkSettings.OldDivisionType ||
+		ChunkSettings.DivisionChangeTime != Other.ChunkSettings.DivisionChangeTime ||
+		HasChildren() != Other.HasChildren())
+	{
+		return false;
+	}
+
+	if (HasChildren())
+	{
+		for (int32 Index = 0; Index < 8; Index++)
+		{
+			if (!GetChildren()[Index].HasSameChunks(Other.GetChildren()[Index]))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 void FVoxelRenderOctree::GetChunksToUpdateForBounds(const FVoxelIntBox& Bounds, TArray<uint64>& ChunksToUpdate, const FVoxelOnChunkUpdate& OnChunkUpdate) const
 {
 	if (!OctreeBounds.Intersect(Bounds))
@@ -588,7 +1174,7 @@ void FVoxelRenderOctree::GetVisibleChunksOverlappingBounds(const FVoxelIntBox& B
 
 FORCEINLINE bool FVoxelRenderOctree::IsCanceled() const
 {
-	return Root->CurrentChunksCount >= CVarMaxRenderOctreeChunks.GetValueOnAnyThread();
+	return Root->CurrentChunksCount.GetValue() >= CVarMaxRenderOctreeChunks.GetValueOnAnyThread();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -616,19 +1202,22 @@ bool FVoxelRenderOctree::ShouldSubdivideByDistance(const FVoxelRenderOctreeSetti
 		return true;
 	}
 
-	for (auto& Invoker : Settings.Invokers)
+	if (ChunkSettings.OldDivisionType == EDivisionType::ByDistance)
 	{
-		if (Invoker.bUseForLOD && OctreeBounds.Intersect(Invoker.LODBounds) && Height > Invoker.LODToSet)
+		// Only merge back once the invokers are further away than the hysteresis
+		const int32 Hysteresis = Settings.GetHysteresis(Height);
+		if (Hysteresis > 0)
 		{
-			return true;
+			return IsInvokerInRange(Settings, EVoxelInvokerBoundsType::LOD, OctreeBounds.Extend(Hysteresis), Height);
 		}
 	}
 
-	return false;
+	// Height > Invoker.LODToSet
+	return IsInvokerInRange(Settings, EVoxelInvokerBoundsType::LOD, Height);
 }
 
 
-bool FVoxelRenderOctree::ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSettings& Settings) const
+bool FVoxelRenderOctree::ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSettings& Settings, const FVoxelRenderOctree* Subtree) const
 {
 	if (Height == 0)
 	{
@@ -643,7 +1232,7 @@ bool FVoxelRenderOctree::ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSett
 		const auto Direction = EVoxelDirectionFlag::Type(1 << DirectionIndex);
 		for (int32 Index = 0; Index < 4; Index++) // Iterate the 4 adjacent subdivided chunks
 		{
-			const FVoxelRenderOctree* AdjacentChunk = GetVisibleAdjacentChunk(Direction, Index);
+			const FVoxelRenderOctree* AdjacentChunk = GetVisibleAdjacentChunk(Direction, Index, Subtree);
 			if (!AdjacentChunk)
 			{
 				continue;
@@ -679,15 +1268,11 @@ bool FVoxelRenderOctree::ShouldSubdivideByOthers(const FVoxelRenderOctreeSetting
 		return false;
 	}
 
-	if (Settings.bEnableCollisions && IsInvokerInRange(Settings.Invokers,
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForCollisions; },
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.CollisionsBounds; }))
+	if (Settings.bEnableCollisions && IsInvokerInRange(Settings, EVoxelInvokerBoundsType::Collisions))
 	{
 		return true;
 	}
-	if (Settings.bEnableNavmesh && IsInvokerInRange(Settings.Invokers,
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForNavmesh; },
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.NavmeshBounds; }))
+	if (Settings.bEnableNavmesh && IsInvokerInRange(Settings, EVoxelInvokerBoundsType::Navmesh))
 	{
 		return true;
 	}
@@ -697,12 +1282,7 @@ bool FVoxelRenderOctree::ShouldSubdivideByOthers(const FVoxelRenderOctreeSetting
 
 ///////////////////////////////////////////////////////////////////////////////
 
-inline bool IsVisibleParent(const FVoxelRenderOctree* Chunk)
-{
-	return Chunk->ChunkSettings.DivisionType == FVoxelRenderOctree::EDivisionType::ByDistance || Chunk->ChunkSettings.DivisionType == FVoxelRenderOctree::EDivisionType::ByNeighbors;
-}
-
-const FVoxelRenderOctree* FVoxelRenderOctree::GetVisibleAdjacentChunk(EVoxelDirectionFlag::Type Direction, int32 Index) const
+const FVoxelRenderOctree* FVoxelRenderOctree::GetVisibleAdjacentChunk(EVoxelDirectionFlag::Type Direction, int32 Index, const FVoxelRenderOctree* Subtree) const
 {
 	const int32 HalfSize = Size() / 2;
 	const int32 HalfHalfSize = Size() / 4;
@@ -750,11 +1330,13 @@ const FVoxelRenderOctree* FVoxelRenderOctree::GetVisibleAdjacentChunk(EVoxelDire
 		break;
 	}
 
-	if (Root->OctreeBounds.Contains(P))
+	// The parents of a subtree are visible parents, so starting from it gives the same chunk as starting from the root
+	const FVoxelRenderOctree* Start = Subtree ? Subtree : Root;
+	if (Start->OctreeBounds.Contains(P))
 	{
-		const FVoxelRenderOctree* Ptr = Root;
+		const FVoxelRenderOctree* Ptr = Start;
 
-		while (IsVisibleParent(Ptr))
+		while (IsVisibleParent(Ptr->ChunkSettings.DivisionType))
 		{
 			Ptr = &Ptr->GetChild(P);
 		}
@@ -769,20 +1351,21 @@ const FVoxelRenderOctree* FVoxelRenderOctree::GetVisibleAdjacentChunk(EVoxelDire
 	}
 }
 
-template<typename T1, typename T2>
-bool FVoxelRenderOctree::IsInvokerInRange(const TArray<FVoxelInvokerSettings>& Invokers, T1 SelectInvoker, T2 GetInvokerBounds) const
+bool FVoxelRenderOctree::IsInvokerInRange(const FVoxelRenderOctreeSettings& Settings, EVoxelInvokerBoundsType Type, int32 MaxLODToSet) const
 {
-	for (auto& Invoker : Invokers)
+	return IsInvokerInRange(Settings, Type, OctreeBounds, MaxLODToSet);
+}
+
+bool FVoxelRenderOctree::IsInvokerInRange(const FVoxelRenderOctreeSettings& Settings, EVoxelInvokerBoundsType Type, const FVoxelIntBox& Bounds, int32 MaxLODToSet) const
+{
+	if (Settings.InvokersTree)
 	{
-		if (SelectInvoker(Invoker))
-		{
-			if (OctreeBounds.Intersect(GetInvokerBounds(Invoker)))
-			{
-				return true;
-			}
-		}
+		return Settings.InvokersTree->Intersect(Type, Bounds, MaxLODToSet);
+	}
+	else
+	{
+		return FVoxelInvokersTree::IntersectBruteForce(Settings.Invokers, Type, Bounds, MaxLODToSet);
 	}
-	return false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -790,4 +1373,201 @@ bool FVoxelRenderOctree::IsInvokerInRange(const TArray<FVoxelInvokerSettings>& I
 uint64 FVoxelRenderOctree::GetId()
 {
 	return ++Root->RootIdCounter;
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+struct FVoxelRenderOctreeBenchmarkResult
+{
+	// Average time per frame, in seconds
+	double Time = 0;
+	int32 NumChunkUpdates = 0;
+	int32 NumChunks = 0;
+	bool bCanceled = false;
+};
+
+// Runs the same moving invokers through two octrees updated with different settings, and checks frame by frame that they give the same chunk updates
+// Returns false if the chunk updates differ
+static bool BenchmarkRenderOctree(
+	int32 NumInvokers, 
+	int32 Depth, 
+	const bool (&bUseInvokersTree)[2], 
+	const int32 (&ParallelDepth)[2], 
+	FVoxelRenderOctreeBenchmarkResult (&Results)[2])
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	constexpr int32 ChunkSize = 32;
+	constexpr int32 NumFrames = 16;
+
+	FVoxelRenderOctreeSettings Settings{};
+	Settings.ChunkSize = ChunkSize;
+	Settings.MinLOD = 0;
+	Settings.MaxLOD = Depth;
+	Settings.WorldBounds = FVoxelIntBox(-(ChunkSize << (Depth - 1)), ChunkSize << (Depth - 1));
+	Settings.ChunksCullingLOD = 0;
+	Settings.bEnableRender = true;
+	Settings.bEnableTransitions = true;
+	Settings.bInvertTransitions = false;
+	Settings.bEnableCollisions = true;
+	Settings.bComputeVisibleChunksCollisions = false;
+	Settings.VisibleChunksCollisionsMaxLOD = 0;
+	Settings.bEnableNavmesh = false;
+	Settings.bComputeVisibleChunksNavmesh = false;
+	Settings.VisibleChunksNavmeshMaxLOD = 0;
+
+	// Same invokers for all the runs with the same world size. Spread them over half the world
+	const int32 Spread = ChunkSize << (Depth - 3);
+	FRandomStream Stream(NumInvokers);
+	TArray<FIntVector> Positions;
+	TArray<FIntVector> Velocities;
+	for (int32 Index = 0; Index < NumInvokers; Index++)
+	{
+		Positions.Add(FIntVector(Stream.RandRange(-Spread, Spread), Stream.RandRange(-Spread, Spread), Stream.RandRange(-256, 256)));
+		Velocities.Add(FIntVector(Stream.RandRange(-16, 16), Stream.RandRange(-16, 16), 0));
+	}
+
+	FVoxelInvokersTree InvokersTree;
+	TVoxelSharedPtr<FVoxelRenderOctree> Octrees[2];
+	TArray<FVoxelChunkUpdate> ChunkUpdates[2];
+	for (int32 Run = 0; Run < 2; Run++)
+	{
+		Octrees[Run] = MakeVoxelShared<FVoxelRenderOctree>(ChunkSize, Depth);
+		Results[Run] = {};
+	}
+
+	bool bSameResults = true;
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		Settings.Invokers.Reset();
+		for (int32 Index = 0; Index < NumInvokers; Index++)
+		{
+			const FIntVector Position = Positions[Index] + Velocities[Index] * Frame;
+
+			FVoxelInvokerSettings Invoker;
+			Invoker.bUseForLOD = true;
+			Invoker.LODToSet = 0;
+			Invoker.LODBounds = FVoxelIntBox(Position).Extend(256);
+			Invoker.bUseForCollisions = true;
+			Invoker.CollisionsBounds = FVoxelIntBox(Position).Extend(64);
+			Settings.Invokers.Add(Invoker);
+		}
+
+		for (int32 Run = 0; Run < 2; Run++)
+		{
+			FVoxelRenderOctree& Octree = *Octrees[Run];
+
+			const double StartTime = FPlatformTime::Seconds();
+
+			if (bUseInvokersTree[Run])
+			{
+				InvokersTree.Update(Settings.Invokers);
+				Settings.InvokersTree = &InvokersTree;
+			}
+			else
+			{
+				Settings.InvokersTree = nullptr;
+			}
+			Settings.ParallelDepth = ParallelDepth[Run];
+
+			Octree.ResetDivisionType();
+			const bool bChanged = Octree.UpdateSubdividedByDistance(Settings);
+			if (bChanged)
+			{
+				Octree.UpdateSubdividedByNeighbors(Settings);
+			}
+			else
+			{
+				Octree.ReuseOldNeighbors();
+			}
+			Octree.UpdateSubdividedByOthers(Settings);
+			Octree.AssignChunkIds();
+
+			ChunkUpdates[Run].Reset();
+			Octree.DeleteChunks(Settings, ChunkUpdates[Run]);
+			Octree.GetUpdates(Octree.UpdateIndex + 1, bChanged, Settings, ChunkUpdates[Run]);
+
+			Results[Run].Time += FPlatformTime::Seconds() - StartTime;
+			Results[Run].NumChunkUpdates += ChunkUpdates[Run].Num();
+			Results[Run].bCanceled |= Octree.IsCanceled();
+		}
+
+		if (Results[0].bCanceled || Results[1].bCanceled)
+		{
+			break;
+		}
+
+		// Compare the chunks (ids, LODs, bounds and settings) and not only their count
+		if (!AreChunkUpdatesEqual(ChunkUpdates[0], ChunkUpdates[1]))
+		{
+			LOG_VOXEL(Warning, TEXT("Render octree benchmark: different chunk updates at frame %d"), Frame);
+			bSameResults = false;
+		}
+	}
+
+	for (int32 Run = 0; Run < 2; Run++)
+	{
+		Results[Run].Time /= NumFrames;
+		Results[Run].NumChunks = Octrees[Run]->CurrentChunksCount.GetValue();
+	}
+	return bSameResults;
+}
+
+static FAutoConsoleCommand CmdBenchmarkRenderOctree(
+	TEXT("voxel.renderer.BenchmarkRenderOctree"),
+	TEXT("Benchmark full render octree updates with 1, 50 and 500 moving invokers, with and without the invokers tree"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const int32 ParallelDepth = FMath::Max(0, CVarParallelRenderOctreeDepth.GetValueOnGameThread());
+		for (const int32 NumInvokers : { 1, 50, 500 })
+		{
+			// 0: brute force, 1: invokers tree
+			FVoxelRenderOctreeBenchmarkResult Results[2];
+			const bool bSameResults = BenchmarkRenderOctree(NumInvokers, 12, { false, true }, { ParallelDepth, ParallelDepth }, Results);
+			ensureMsgf(bSameResults, TEXT("The invokers tree gave different chunks than the brute force invokers check"));
+
+			LOG_VOXEL(Log, TEXT("Render octree update with %d invokers: %fms without invokers tree, %fms with invokers tree (%d chunk updates)"),
+				NumInvokers,
+				Results[0].Time * 1000,
+				Results[1].Time * 1000,
+				Results[1].NumChunkUpdates);
+		}
+	}));
+
+static FAutoConsoleCommand CmdBenchmarkRenderOctreeBuild(
+	TEXT("voxel.renderer.BenchmarkRenderOctreeBuild"),
+	TEXT("Benchmark full render octree updates on a single thread and in parallel (see voxel.renderer.ParallelRenderOctreeDepth), for several world sizes and invokers counts"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const int32 ParallelDepth = FMath::Max(1, CVarParallelRenderOctreeDepth.GetValueOnGameThread());
+		for (const int32 Depth : { 10, 12, 14 })
+		{
+			for (const int32 NumInvokers : { 1, 10, 100 })
+			{
+				// 0: single thread, 1: parallel
+				FVoxelRenderOctreeBenchmarkResult Results[2];
+				const bool bSameResults = BenchmarkRenderOctree(NumInvokers, Depth, { true, true }, { 0, ParallelDepth }, Results);
+
+				if (Results[0].bCanceled || Results[1].bCanceled)
+				{
+					LOG_VOXEL(Warning, TEXT("Render octree build with depth %d and %d invokers: canceled, increase voxel.renderer.MaxRenderOctreeChunks"), Depth, NumInvokers);
+					continue;
+				}
+
+				// Both builds must give the same chunks with the same ids
+				ensureMsgf(bSameResults, TEXT("The parallel render octree build gave different chunks than the single threaded one"));
+
+				LOG_VOXEL(Log, TEXT("Render octree build with depth %d (world size %d) and %d invokers: %fms on a single thread, %fms in parallel with depth %d (%d chunks, %d chunk updates)"),
+					Depth,
+					32 << Depth,
+					NumInvokers,
+					Results[0].Time * 1000,
+					Results[1].Time * 1000,
+					ParallelDepth,
+					Results[1].NumChunks,
+					Results[1].NumChunkUpdates);
+			}
+		}
+	}));
@@ -9,6 +9,7 @@
 #include "VoxelSimpleOctree.h"
 #include "VoxelAsyncWork.h"
 #include "VoxelInvokerSettings.h"
+#include "VoxelInvokersTree.h"
 #include "VoxelRender/VoxelChunkToUpdate.h"
 
 #include "HAL/ThreadSafeBool.h"
@@ -20,6 +21,13 @@ class FVoxelDebugManager;
 DECLARE_MULTICAST_DELEGATE_OneParam(FVoxelOnChunkUpdate, FVoxelIntBox);
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Render Octrees Memory"), STAT_VoxelRenderOctreesMemory, STATGROUP_VoxelMemory, VOXEL_API);
 
+// Chunks whose distance subdivision was kept back by MinChunkLifetime during an update
+struct FVoxelRenderOctreePendingBounds
+{
+	FCriticalSection Section;
+	TArray<FVoxelIntBox> Bounds;
+};
+
 struct FVoxelRenderOctreeSettings
 {
 	int32 ChunkSize;
@@ -28,6 +36,12 @@ struct FVoxelRenderOctreeSettings
 	FVoxelIntBox WorldBounds;
 
 	TArray<FVoxelInvokerSettings> Invokers;
+	// Acceleration structure over Invokers, set by the builder. If null, all the invokers are iterated
+	const FVoxelInvokersTree* InvokersTree = nullptr;
+	// The chunks in the top ParallelDepth levels update their children in parallel. Set by the builder
+	int32 ParallelDepth = 0;
+	// Where the chunks kept back by MinChunkLifetime are added. Set by the builder
+	FVoxelRenderOctreePendingBounds* NewPendingBounds = nullptr;
 
 	int32 ChunksCullingLOD;
 
@@ -42,6 +56,33 @@ struct FVoxelRenderOctreeSettings
 	bool bEnableNavmesh;
 	bool bComputeVisibleChunksNavmesh;
 	int32 VisibleChunksNavmeshMaxLOD;
+
+	// Per chunk height, as a fraction of the chunk size. The last element is used for the higher heights. Empty to disable
+	TArray<float> LODHysteresis;
+	// Min time between two changes of the distance subdivision of a chunk, in seconds
+	float MinChunkLifetime = 0;
+	// Time of the update, set by the LOD manager so that updates can be replayed
+	double Time = 0;
+	// Bounds of the chunks kept back by MinChunkLifetime in the previous update, to update again
+	TArray<FVoxelIntBox> PendingBounds;
+
+	// Returns the hysteresis distance for chunks of that height, in voxels
+	int32 GetHysteresis(int32 Height) const;
+};
+
+// Bounds of the invokers that changed between two updates
+struct FVoxelRenderOctreeDirtyBounds
+{
+	TArray<FVoxelIntBox> LODBounds;
+	TArray<FVoxelIntBox> OthersBounds;
+	// Max LOD hysteresis, as a fraction of the chunk size: chunks further away might still be affected by LODBounds
+	float MaxHysteresis = 0;
+
+	// Returns false if settings other than the invokers changed, in which case the whole octree needs to be updated
+	bool Init(const FVoxelRenderOctreeSettings& OldSettings, const FVoxelRenderOctreeSettings& NewSettings);
+
+	// Whether a chunk might get different settings. The render octree is left untouched outside of these chunks
+	bool NeedsUpdate(const FVoxelIntBox& Bounds, uint32 Size) const;
 };
 
 class FVoxelRenderOctreeAsyncBuilder : public FVoxelAsyncWork
@@ -55,6 +96,7 @@ public:
 	TVoxelSharedPtr<FVoxelRenderOctree> OldOctree;
 
 	// We don't want to do the deletion on the game thread
+	// If possible, this octree is updated in place to become the next NewOctree instead of cloning OldOctree
 	TVoxelSharedPtr<FVoxelRenderOctree> OctreeToDelete;
 
 	FVoxelRenderOctreeAsyncBuilder(uint8 OctreeDepth, const FVoxelIntBox& WorldBounds);
@@ -63,16 +105,39 @@ public:
 	void Init(const FVoxelRenderOctreeSettings& OctreeSettings, TVoxelSharedPtr<FVoxelRenderOctree> Octree);
 	void ReportBuildTime();
 
+	// Whether some chunks were kept back by MinChunkLifetime and need another update
+	bool HasPendingChunks() const
+	{
+		return PendingBounds.Num() > 0;
+	}
+
 private:
 	//~ Begin FVoxelAsyncWork Interface
 	virtual void DoWork() override;
 	//~ End FVoxelAsyncWork Interface
 
+	// If DirtyBounds is null, the whole octree is updated. Returns whether the octree structure changed
+	// If OutPendingBounds is null, the chunks kept back by MinChunkLifetime are discarded
+	bool UpdateOctree(
+		FVoxelRenderOctree& Octree, 
+		FVoxelRenderOctreeSettings Settings, 
+		const FVoxelRenderOctreeDirtyBounds* DirtyBounds, 
+		TArray<FVoxelChunkUpdate>& OutChunkUpdates,
+		TArray<FVoxelIntBox>* OutPendingBounds = nullptr);
+
 private:
 	const uint8 OctreeDepth;
 	const FVoxelIntBox WorldBounds;
 
 	FVoxelRenderOctreeSettings OctreeSettings{};
+	FVoxelInvokersTree InvokersTree;
+	// Chunks kept back by MinChunkLifetime in the last update, given to the next one
+	TArray<FVoxelIntBox> PendingBounds;
+
+	// Settings used to build OldOctree and OctreeToDelete, to replay the last update on OctreeToDelete
+	TOptional<FVoxelRenderOctreeSettings> OldOctreeSettings;
+	TOptional<FVoxelRenderOctreeSettings> OctreeToDeleteSettings;
+	bool bOldOctreeUpdatedIncrementally = false;
 
 	bool bTooManyChunks = false;
 	double Counter = 0;
@@ -88,7 +153,8 @@ private:
 	
 public:
 	FVoxelRenderOctree* const Root;
-	const uint64 ChunkId;
+	// New chunks get their id in AssignChunkIds, so that ids don't depend on the order the chunks were created in
+	uint64 ChunkId;
 	const FVoxelIntBox OctreeBounds;
 
 	enum class EDivisionType : uint8
@@ -104,12 +170,17 @@ public:
 		FVoxelChunkSettings Settings{};
 		EDivisionType DivisionType = EDivisionType::Uninitialized;
 		EDivisionType OldDivisionType = EDivisionType::Uninitialized;
+		// Settings time of the last time this chunk was subdivided or merged by distance, used for MinChunkLifetime
+		double DivisionChangeTime = -MAX_dbl;
+		// Set on new chunks and on the chunks marked for update, cleared by GetUpdates
+		bool bNeedsUpdate = false;
 	}; 
 	FChunkSettings ChunkSettings;
-	int32 CurrentChunksCount = 0;
+	FThreadSafeCounter CurrentChunksCount;
 	uint64 UpdateIndex = 0;
 
 	inline const FVoxelChunkSettings& GetSettings() const { return ChunkSettings.Settings; }
+	inline uint64 GetRootIdCounter() const { return Root->RootIdCounter; }
 
 	FVoxelRenderOctree(uint32 ChunkSize, uint8 LOD);
 	explicit FVoxelRenderOctree(const FVoxelRenderOctree& Source);
@@ -120,11 +191,16 @@ public:
 	~FVoxelRenderOctree();
 
 	void ResetDivisionType();
+	// Only reset the chunks that might be affected by DirtyBounds. The passes below skip the other chunks
+	void MarkChunksToUpdate(const FVoxelRenderOctreeDirtyBounds& DirtyBounds);
 	bool UpdateSubdividedByDistance(const FVoxelRenderOctreeSettings& Settings);
-	bool UpdateSubdividedByNeighbors(const FVoxelRenderOctreeSettings& Settings);
+	// Subdivides chunks until no chunk is more than one LOD above its neighbors. Returns the number of iterations
+	int32 UpdateSubdividedByNeighbors(const FVoxelRenderOctreeSettings& Settings);
 	void ReuseOldNeighbors();
 	void UpdateSubdividedByOthers(const FVoxelRenderOctreeSettings& Settings);
-	void DeleteChunks(TArray<FVoxelChunkUpdate>& ChunkUpdates);
+	// Must be called after the subdivision passes and before DeleteChunks
+	void AssignChunkIds();
+	void DeleteChunks(const FVoxelRenderOctreeSettings& Settings, TArray<FVoxelChunkUpdate>& ChunkUpdates);
 
 	void GetUpdates(
 		uint32 InUpdateIndex,
@@ -133,6 +209,9 @@ public:
 		TArray<FVoxelChunkUpdate>& ChunkUpdates, 
 		bool bVisible = true);
 
+	// Whether both octrees have the same chunks, with the same ids and settings
+	bool HasSameChunks(const FVoxelRenderOctree& Other) const;
+
 	void GetChunksToUpdateForBounds(const FVoxelIntBox& Bounds, TArray<uint64>& ChunksToUpdate, const FVoxelOnChunkUpdate& OnChunkUpdate) const;
 	void GetVisibleChunksOverlappingBounds(const FVoxelIntBox& Bounds, TArray<uint64, TInlineAllocator<8>>& VisibleChunks) const;
 
@@ -140,13 +219,27 @@ public:
 
 private:
 	bool ShouldSubdivideByDistance(const FVoxelRenderOctreeSettings& Settings) const;
-	bool ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSettings& Settings) const;
+	bool ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSettings& Settings, const FVoxelRenderOctree* Subtree) const;
 	bool ShouldSubdivideByOthers(const FVoxelRenderOctreeSettings& Settings) const;
-	
-	const FVoxelRenderOctree* GetVisibleAdjacentChunk(EVoxelDirectionFlag::Type Direction, int32 Index) const;
 
-	template<typename T1, typename T2>
-	bool IsInvokerInRange(const TArray<FVoxelInvokerSettings>& Invokers, T1 SelectInvoker, T2 GetInvokerBounds) const;
+	// When the children are updated in parallel, each child is the root of a subtree that only looks at its own chunks
+	// The neighbors across subtree borders are then checked by UpdateSubdividedByNeighborsAtSubtreeBorders
+	bool UpdateSubdividedByNeighborsInSubtree(const FVoxelRenderOctreeSettings& Settings, const FVoxelRenderOctree* Subtree);
+	bool UpdateSubdividedByNeighborsAtSubtreeBorders(const FVoxelRenderOctreeSettings& Settings, const FVoxelRenderOctree* Subtree);
+
+	// If Subtree is not null, returns null for the chunks outside of it
+	const FVoxelRenderOctree* GetVisibleAdjacentChunk(EVoxelDirectionFlag::Type Direction, int32 Index, const FVoxelRenderOctree* Subtree = nullptr) const;
+
+	// For LOD, only the invokers with LODToSet < MaxLODToSet are considered
+	bool IsInvokerInRange(const FVoxelRenderOctreeSettings& Settings, EVoxelInvokerBoundsType Type, int32 MaxLODToSet = MAX_int32) const;
+	bool IsInvokerInRange(const FVoxelRenderOctreeSettings& Settings, EVoxelInvokerBoundsType Type, const FVoxelIntBox& Bounds, int32 MaxLODToSet) const;
 
 	uint64 GetId();
+
+	bool AreChildrenUpdatedInParallel(const FVoxelRenderOctreeSettings& Settings) const;
+	template<typename T>
+	void IterateChildren(const FVoxelRenderOctreeSettings& Settings, T Lambda);
+	// Children updated in parallel add their chunk updates to their own array, which are then appended in order
+	template<typename T>
+	void IterateChildren(const FVoxelRenderOctreeSettings& Settings, TArray<FVoxelChunkUpdate>& ChunkUpdates, T Lambda);
 };
\ No newline at end of file
@@ -24,7 +24,7 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelGreedyCubicMesher::CreateFullChunkImpl(FV
 
 	TArray<uint8> TextureData;
 	TArray<FVoxelIntBox> CollisionCubes;
-	CreateGeometryTemplate(Times, Indices, Vertices, &TextureData, &CollisionCubes);
+	CreateGeometryTemplate(Times, Indices, Vertices, bOnlyCollisionCubes ? nullptr : &TextureData, &CollisionCubes);
 
 	TArray<FBox> ActualCollisionCubes;
 	if (CollisionCubes.Num() > 0)
@@ -40,6 +40,15 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelGreedyCubicMesher::CreateFullChunkImpl(FV
     }
 
 	UnlockData();
+
+	if (bOnlyCollisionCubes)
+	{
+		// Skip the render buffers entirely
+		const auto Chunk = MakeVoxelShared<FVoxelChunkMesh>();
+		Chunk->SetIsSingle(true);
+		Chunk->CreateSingleBuffers().CollisionCubes = MoveTemp(ActualCollisionCubes);
+		return Chunk;
+	}
 	
 	return MESHER_TIME_INLINE(CreateChunk, FVoxelMesherUtilities::CreateChunkFromVertices(
 		Settings,
@@ -146,7 +155,16 @@ void FVoxelGreedyCubicMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, T
 		}
 	}
 
-	for (int32 Direction = 0; Direction < 6; Direction++)
+	bool bHasFaces = false;
+	for (int32 Direction = 0; Direction < 6 && !bHasFaces; Direction++)
+	{
+		for (int32 Word = 0; Word < FVoxelUtilities::DivideCeil(NumVoxels, TVoxelStaticBitArray<NumVoxels>::NumBitsPerWord) && !bHasFaces; Word++)
+		{
+			bHasFaces = FacesBitArrays[Direction].GetInternal(Word) != 0;
+		}
+	}
+
+	for (int32 Direction = 0; Direction < 6 && !bOnlyCollisionCubes; Direction++)
 	{
 		TArray<FCubicQuad, TFixedAllocator<NumVoxels>> Quads;
 		MESHER_TIME_INLINE(GreedyMeshing, GreedyMeshing2D<MESHER_CHUNK_SIZE>(FacesBitArrays[Direction], Quads));
@@ -159,8 +177,8 @@ void FVoxelGreedyCubicMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, T
 		}
 	}
 
-	// If Indices is empty, then we don't need to create any collision for this chunk (it's entirely inside the surface)
-	if (CollisionCubes && Settings.bSimpleCubicCollision && Indices.Num() > 0)
+	// If there are no faces, then we don't need to create any collision for this chunk (it's entirely inside the surface)
+	if (CollisionCubes && Settings.bSimpleCubicCollision && bHasFaces)
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("CollisionCubes");
 		MESHER_TIME_SCOPE(CollisionCubes);
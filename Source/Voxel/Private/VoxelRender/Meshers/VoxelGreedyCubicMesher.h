@@ -13,7 +13,12 @@ class FVoxelConstDataAccelerator;
 class FVoxelGreedyCubicMesher : public FVoxelMesher
 {
 public:
-	using FVoxelMesher::FVoxelMesher;
+	// If bOnlyCollisionCubes is true, no triangle is created: the chunk only holds the collision cubes built from the voxel occupancy
+	FVoxelGreedyCubicMesher(int32 LOD, const FIntVector& ChunkPosition, const IVoxelRenderer& Renderer, const FVoxelData& Data, bool bOnlyCollisionCubes = false)
+		: FVoxelMesher(LOD, ChunkPosition, Renderer, Data)
+		, bOnlyCollisionCubes(bOnlyCollisionCubes)
+	{
+	}
 	
 protected:
 	virtual FVoxelIntBox GetBoundsToCheckIsEmptyOn() const override final;
@@ -22,6 +27,7 @@ protected:
 	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices) override final;
 
 private:
+	const bool bOnlyCollisionCubes;
 	TUniquePtr<FVoxelConstDataAccelerator> Accelerator;
 	
 	template<typename T>
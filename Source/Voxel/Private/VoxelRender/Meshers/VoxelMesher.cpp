@@ -17,6 +17,31 @@ static TAutoConsoleVariable<int32> CVarDoNotSkipEmptyChunks(
 	TEXT("If true, all chunks will be computed"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarSkipEmptyChunksFromSamples(
+	TEXT("voxel.mesher.SkipEmptyChunksFromSamples"),
+	1,
+	TEXT("If true, chunks that range analysis can't skip are sampled on a coarse lattice, and skipped if the generator Lipschitz constant proves there's no surface"),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Chunks Sampled For Surface"), STAT_VoxelChunksSampledForSurface, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Chunks Skipped From Samples"), STAT_VoxelChunksSkippedFromSamples, STATGROUP_VoxelCounters);
+
+static FThreadSafeCounter64 GVoxelNumChunksSampledForSurface;
+static FThreadSafeCounter64 GVoxelNumChunksSkippedFromSamples;
+
+static FAutoConsoleCommand CmdLogSkipEmptyChunksFromSamplesStats(
+	TEXT("voxel.mesher.LogSkipEmptyChunksFromSamplesStats"),
+	TEXT("Log how many dense chunk evaluations were avoided by voxel.mesher.SkipEmptyChunksFromSamples, and reset the stats"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const int64 NumSampled = GVoxelNumChunksSampledForSurface.Set(0);
+		const int64 NumSkipped = GVoxelNumChunksSkippedFromSamples.Set(0);
+		LOG_VOXEL(Log, TEXT("%lld chunks not skipped by range analysis; %lld of them skipped from samples (%.1f%% of their dense evaluations avoided)"),
+			NumSampled,
+			NumSkipped,
+			100. * NumSkipped / FMath::Max<int64>(1, NumSampled));
+	}));
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -274,7 +299,23 @@ void FVoxelMesherBase::LockData()
 bool FVoxelMesherBase::IsEmpty() const
 {
 	const FVoxelIntBox Bounds = GetBoundsToCheckIsEmptyOn();
-	const bool bIsEmpty = CVarDoNotSkipEmptyChunks.GetValueOnAnyThread() != 0 ? false : Data.IsEmpty(Bounds, LOD);
+	bool bIsEmpty = CVarDoNotSkipEmptyChunks.GetValueOnAnyThread() != 0 ? false : Data.IsEmpty(Bounds, LOD);
+
+	if (!bIsEmpty &&
+		CVarDoNotSkipEmptyChunks.GetValueOnAnyThread() == 0 &&
+		CVarSkipEmptyChunksFromSamples.GetValueOnAnyThread() != 0)
+	{
+		INC_DWORD_STAT(STAT_VoxelChunksSampledForSurface);
+		GVoxelNumChunksSampledForSurface.Increment();
+
+		bIsEmpty = Data.IsEmptyFromSamples(Bounds, LOD);
+
+		if (bIsEmpty)
+		{
+			INC_DWORD_STAT(STAT_VoxelChunksSkippedFromSamples);
+			GVoxelNumChunksSkippedFromSamples.Increment();
+		}
+	}
 
 	if (!bIsTransitions)
 	{
@@ -370,7 +411,7 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesher::CreateFullChunk()
 			if (LOD <= Settings.MaxDistanceFieldLOD)
 			{
 				MESHER_TIME_SCOPE(DistanceField);
-				Chunk->BuildDistanceField(LOD, ChunkPosition, Data, Settings);
+				Chunk->BuildDistanceField(LOD, ChunkPosition, Data, Settings, PreviousDistanceFieldCache, bKeepDistanceFieldCache);
 			}
 		}
 
@@ -7,6 +7,7 @@
 #include "VoxelStatHelpers.h"
 
 struct FVoxelChunkMesh;
+struct FVoxelChunkDistanceFieldCache;
 class FVoxelData;
 class IVoxelRenderer;
 class FVoxelDataLockInfo;
@@ -64,6 +65,11 @@ public:
 	const IVoxelRenderer& Renderer;
 	const bool bIsTransitions;
 
+	// Distance field data of the previous build of this chunk, if any
+	TVoxelSharedPtr<const FVoxelChunkDistanceFieldCache> PreviousDistanceFieldCache;
+	// If true, the distance field data is kept in the chunk for the next build
+	bool bKeepDistanceFieldCache = false;
+
 	FVoxelMesherBase(
 		int32 LOD,
 		const FIntVector& ChunkPosition,
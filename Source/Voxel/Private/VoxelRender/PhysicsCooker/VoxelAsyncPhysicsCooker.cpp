@@ -100,6 +100,56 @@ IVoxelAsyncPhysicsCooker* IVoxelAsyncPhysicsCooker::CreateCooker(UVoxelProcedura
 #endif
 }
 
+bool IVoxelAsyncPhysicsCooker::HasTriangles() const
+{
+	for (auto& Buffer : Buffers)
+	{
+		if (Buffer->GetNumIndices() > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TVoxelSharedPtr<FVoxelSimpleCollisionData> IVoxelAsyncPhysicsCooker::CreateBoxSimpleCollision() const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	int32 NumCubes = 0;
+	for (auto& Buffer : Buffers)
+	{
+		NumCubes += Buffer->CollisionCubes.Num();
+	}
+	if (NumCubes == 0)
+	{
+		return nullptr;
+	}
+
+	const auto SimpleCollisionData = MakeVoxelShared<FVoxelSimpleCollisionData>();
+	SimpleCollisionData->Bounds = FBox(ForceInit);
+
+	TArray<FKBoxElem>& BoxElems = SimpleCollisionData->BoxElems;
+	BoxElems.Reserve(NumCubes);
+	for (auto& Buffer : Buffers)
+	{
+		for (FBox Cube : Buffer->CollisionCubes)
+		{
+			Cube = Cube.TransformBy(LocalToRoot);
+			SimpleCollisionData->Bounds += Cube;
+
+			FKBoxElem& BoxElem = BoxElems.Emplace_GetRef();
+
+			BoxElem.Center = Cube.GetCenter();
+			BoxElem.X = Cube.GetExtent().X * 2;
+			BoxElem.Y = Cube.GetExtent().Y * 2;
+			BoxElem.Z = Cube.GetExtent().Z * 2;
+		}
+	}
+
+	return SimpleCollisionData;
+}
+
 void IVoxelAsyncPhysicsCooker::DoWork()
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
@@ -45,6 +45,10 @@ protected:
 	virtual void CookMesh() = 0;
 	//~ End IVoxelAsyncPhysicsCooker Interface
 
+	bool HasTriangles() const;
+	// Box elements from the buffers collision cubes, in root space. Null if there are no cubes
+	TVoxelSharedPtr<FVoxelSimpleCollisionData> CreateBoxSimpleCollision() const;
+
 protected:
 	//~ Begin FVoxelAsyncWork Interface
 	virtual void DoWork() override;
@@ -2,17 +2,28 @@
 
 #include "VoxelRender/PhysicsCooker/VoxelAsyncPhysicsCooker_Chaos.h"
 #include "VoxelRender/VoxelProcMeshBuffers.h"
+#include "VoxelRender/VoxelProceduralMeshComponent.h"
 #include "VoxelUtilities/VoxelMathUtilities.h"
 
 #include "PhysicsEngine/BodySetup.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
 
 #if WITH_CHAOS
 #include "Chaos/ImplicitObject.h"
 #include "Chaos/CollisionConvexMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
 
+static TAutoConsoleVariable<int32> CVarCollisionSubMeshesPerAxis(
+	TEXT("voxel.collision.SubMeshesPerAxis"),
+	1,
+	TEXT("Chaos only. Collision meshes are split in SubMeshesPerAxis^3 trimeshes, each with its own acceleration structure. "
+		"When a chunk is updated, only the sub-meshes whose triangles changed are cooked again"),
+	ECVF_Default);
+
 FVoxelAsyncPhysicsCooker_Chaos::FVoxelAsyncPhysicsCooker_Chaos(UVoxelProceduralMeshComponent* Component)
 	: IVoxelAsyncPhysicsCooker(Component)
+	, PreviousCookedTriMeshes(Component->CookedChaosTriMeshes)
 {
 }
 
@@ -22,21 +33,29 @@ bool FVoxelAsyncPhysicsCooker_Chaos::Finalize(
 	FVoxelProceduralMeshComponentMemoryUsage& OutMemoryUsage)
 {
 #if TRACK_CHAOS_GEOMETRY
-	for (auto& TriMesh : TriMeshes)
+	// The reused trimeshes are already tracked
+	for (auto& TriMesh : NewTriMeshes)
 	{
 		TriMesh->Track(Chaos::MakeSerializable(TriMesh), "Voxel Mesh");
 	}
 #endif
 
 	// Force trimesh collisions off
-	for (auto& TriMesh : TriMeshes)
+	for (auto& TriMesh : NewTriMeshes)
 	{
 		TriMesh->SetDoCollide(false);
 	}
+
+	if (UVoxelProceduralMeshComponent* ComponentPtr = Component.Get())
+	{
+		ComponentPtr->CookedChaosTriMeshes = CookedTriMeshes;
+	}
 	
 	BodySetup.ChaosTriMeshes = MoveTemp(TriMeshes);
 	BodySetup.bCreatedPhysicsMeshes = true;
 
+	OutSimpleCollisionData = SimpleCollisionData;
+
 	return true;
 }
 
@@ -44,9 +63,12 @@ void FVoxelAsyncPhysicsCooker_Chaos::CookMesh()
 {
 	if (CollisionTraceFlag != ECollisionTraceFlag::CTF_UseComplexAsSimple)
 	{
-		ensure(false);
+		// Only cubic simple collisions are supported
+		ensure(bSimpleCubicCollision);
+		SimpleCollisionData = CreateBoxSimpleCollision();
 	}
-	if (CollisionTraceFlag != ECollisionTraceFlag::CTF_UseSimpleAsComplex)
+	// Occupancy collisions have no triangles
+	if (CollisionTraceFlag != ECollisionTraceFlag::CTF_UseSimpleAsComplex && HasTriangles())
 	{
 		CreateTriMesh();
 	}
@@ -68,97 +90,232 @@ void FVoxelAsyncPhysicsCooker_Chaos::CreateTriMesh()
 		NumVertices += Buffer->GetNumVertices();
 	}
 
-	const auto Process = [&](auto& Triangles)
+	TArray<FVector> Vertices;
+	TArray<FIntVector> Triangles;
+	FBox Bounds(ForceInit);
 	{
-		Chaos::FTriangleMeshImplicitObject::ParticlesType Particles;
+		VOXEL_ASYNC_SCOPE_COUNTER("Copy data from buffers");
 
 		{
-			VOXEL_ASYNC_SCOPE_COUNTER("Copy data from buffers");
+			VOXEL_ASYNC_SCOPE_COUNTER("Allocate");
+			ensure(NumIndices % 3 == 0);
+			Triangles.SetNumUninitialized(NumIndices / 3);
+			Vertices.SetNumUninitialized(NumVertices);
+		}
+
+		int32 IndexIndex = 0;
+		int32 VertexIndex = 0;
+		for (int32 SectionIndex = 0; SectionIndex < Buffers.Num(); SectionIndex++)
+		{
+			auto& Buffer = *Buffers[SectionIndex];
+
+			const int32 VertexOffset = VertexIndex;
 
 			{
-				VOXEL_ASYNC_SCOPE_COUNTER("Allocate");
-				ensure(NumIndices % 3 == 0);
-				Triangles.SetNumUninitialized(NumIndices / 3);
-				Particles.AddParticles(NumVertices);
+				VOXEL_ASYNC_SCOPE_COUNTER("Copy vertices");
+				
+				auto& PositionBuffer = Buffer.VertexBuffers.PositionVertexBuffer;
+				for (uint32 Index = 0; Index < PositionBuffer.GetNumVertices(); Index++)
+				{
+					const FVector Position = FVector(PositionBuffer.VertexPosition(Index));
+					FVoxelUtilities::Get(Vertices, VertexIndex++) = Position;
+					Bounds += Position;
+				}
 			}
 
-			int32 IndexIndex = 0;
-			int32 VertexIndex = 0;
-			for (int32 SectionIndex = 0; SectionIndex < Buffers.Num(); SectionIndex++)
 			{
-				auto& Buffer = *Buffers[SectionIndex];
+				VOXEL_ASYNC_SCOPE_COUNTER("Copy triangles");
+				
+				auto& IndexBuffer = Buffer.IndexBuffer;
 
-				const int32 VertexOffset = VertexIndex;
+				ensure(IndexBuffer.GetNumIndices() % 3 == 0);
+				const int32 NumTriangles = IndexBuffer.GetNumIndices() / 3;
 
+				const auto Lambda = [&](const auto* RESTRICT Data)
 				{
-					VOXEL_ASYNC_SCOPE_COUNTER("Copy vertices");
-					
-					auto& PositionBuffer = Buffer.VertexBuffers.PositionVertexBuffer;
-					for (uint32 Index = 0; Index < PositionBuffer.GetNumVertices(); Index++)
+					for (int32 Index = 0; Index < NumTriangles; Index++)
 					{
-						Particles.X(VertexIndex++) = PositionBuffer.VertexPosition(Index);
+						checkVoxelSlow(3 * Index + 2 < IndexBuffer.GetNumIndices());
+
+						FVoxelUtilities::Get(Triangles, IndexIndex++) = FIntVector(
+							int32(Data[3 * Index + 2]) + VertexOffset,
+							int32(Data[3 * Index + 1]) + VertexOffset,
+							int32(Data[3 * Index + 0]) + VertexOffset);
 					}
+				};
+				if (IndexBuffer.Is32Bit())
+				{
+					Lambda(IndexBuffer.GetData_32());
 				}
-
+				else
 				{
-					VOXEL_ASYNC_SCOPE_COUNTER("Copy triangles");
-					
-					auto& IndexBuffer = Buffer.IndexBuffer;
-
-					ensure(IndexBuffer.GetNumIndices() % 3 == 0);
-					const int32 NumTriangles = IndexBuffer.GetNumIndices() / 3;
-
-					const auto Lambda = [&](const auto* RESTRICT Data)
-					{
-						for (int32 Index = 0; Index < NumTriangles; Index++)
-						{
-							checkVoxelSlow(3 * Index + 2 < IndexBuffer.GetNumIndices());
-
-							const Chaos::TVector<int32, 3> Triangle{
-									int32(Data[3 * Index + 2]) + VertexOffset,
-									int32(Data[3 * Index + 1]) + VertexOffset,
-									int32(Data[3 * Index + 0]) + VertexOffset
-							};
-
-							FVoxelUtilities::Get(Triangles, IndexIndex++) = Triangle;
-
-	#if VOXEL_DEBUG
-							const auto A = Particles.X(Triangle.X);
-							const auto B = Particles.X(Triangle.Y);
-							const auto C = Particles.X(Triangle.Z);
-							ensure(Chaos::FConvexBuilder::IsValidTriangle(A, B, C));
-	#endif
-						}
-					};
-					if (IndexBuffer.Is32Bit())
-					{
-						Lambda(IndexBuffer.GetData_32());
-					}
-					else
-					{
-						Lambda(IndexBuffer.GetData_16());
-					}
+					Lambda(IndexBuffer.GetData_16());
 				}
 			}
-			check(IndexIndex == Triangles.Num());
-			check(VertexIndex == Particles.Size());
 		}
+		check(IndexIndex == Triangles.Num());
+		check(VertexIndex == Vertices.Num());
+	}
 
-		TArray<uint16> MaterialIndices;
-		
-		VOXEL_ASYNC_SCOPE_COUNTER("Build Tri Mesh");
-		TriMeshes.Emplace(new Chaos::FTriangleMeshImplicitObject(MoveTemp(Particles), MoveTemp(Triangles), MoveTemp(MaterialIndices)));
-	};
-	
-	if (NumVertices < TNumericLimits<uint16>::Max())
+	if (Triangles.Num() == 0)
 	{
-		TArray<Chaos::TVec3<uint16>> TrianglesSmallIdx;
-		Process(TrianglesSmallIdx);
+		return;
+	}
+
+	const int32 NumCellsPerAxis = FMath::Clamp(CVarCollisionSubMeshesPerAxis.GetValueOnAnyThread(), 1, 4);
+	const int32 NumCells = NumCellsPerAxis * NumCellsPerAxis * NumCellsPerAxis;
+
+	CookedTriMeshes = MakeVoxelShared<FVoxelCookedChaosTriMeshes>();
+	CookedTriMeshes->NumCellsPerAxis = NumCellsPerAxis;
+	CookedTriMeshes->SubMeshes.SetNum(NumCells);
+
+	// Keep the previous grid if possible, so that the cells are the same
+	const bool bReusePreviousCook = PreviousCookedTriMeshes.IsValid() && PreviousCookedTriMeshes->CanReuseGrid(Bounds, NumCellsPerAxis);
+	if (bReusePreviousCook)
+	{
+		CookedTriMeshes->GridOrigin = PreviousCookedTriMeshes->GridOrigin;
+		CookedTriMeshes->CellSize = PreviousCookedTriMeshes->CellSize;
 	}
 	else
 	{
-		TArray<Chaos::TVec3<int32>> TrianglesLargeIdx;
-		Process(TrianglesLargeIdx);
+		// Add some margin so that small changes of the bounds don't invalidate the grid
+		const FBox GridBounds = Bounds.ExpandBy(Bounds.GetSize().GetMax() / 16 + KINDA_SMALL_NUMBER);
+		CookedTriMeshes->GridOrigin = GridBounds.Min;
+		CookedTriMeshes->CellSize = GridBounds.GetSize() / NumCellsPerAxis;
+	}
+
+	TArray<TArray<int32>> CellsTriangles;
+	CellsTriangles.SetNum(NumCells);
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Split triangles");
+
+		const FVector GridOrigin = CookedTriMeshes->GridOrigin;
+		const FVector CellSize = CookedTriMeshes->CellSize;
+		for (int32 TriangleIndex = 0; TriangleIndex < Triangles.Num(); TriangleIndex++)
+		{
+			const FIntVector& Triangle = Triangles[TriangleIndex];
+			const FVector Centroid = (Vertices[Triangle.X] + Vertices[Triangle.Y] + Vertices[Triangle.Z]) / 3;
+			const FVector Cell = (Centroid - GridOrigin) / CellSize;
+			const int32 X = FMath::Clamp(FMath::FloorToInt(Cell.X), 0, NumCellsPerAxis - 1);
+			const int32 Y = FMath::Clamp(FMath::FloorToInt(Cell.Y), 0, NumCellsPerAxis - 1);
+			const int32 Z = FMath::Clamp(FMath::FloorToInt(Cell.Z), 0, NumCellsPerAxis - 1);
+			CellsTriangles[X + NumCellsPerAxis * Y + NumCellsPerAxis * NumCellsPerAxis * Z].Add(TriangleIndex);
+		}
+	}
+
+	const auto CookCell = [&](int32 CellIndex)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Cook cell");
+
+		const TArray<int32>& CellTriangles = CellsTriangles[CellIndex];
+		if (CellTriangles.Num() == 0)
+		{
+			return;
+		}
+
+		// Remap the vertices used by the cell
+		TMap<int32, int32> VertexRemap;
+		TArray<FVector> CellVertices;
+		TArray<FIntVector> CellIndices;
+		CellIndices.Reserve(CellTriangles.Num());
+		{
+			const auto Remap = [&](int32 Index)
+			{
+				if (const int32* NewIndex = VertexRemap.Find(Index))
+				{
+					return *NewIndex;
+				}
+				return VertexRemap.Add(Index, CellVertices.Add(Vertices[Index]));
+			};
+			for (const int32 TriangleIndex : CellTriangles)
+			{
+				const FIntVector& Triangle = Triangles[TriangleIndex];
+				const int32 A = Remap(Triangle.X);
+				const int32 B = Remap(Triangle.Y);
+				const int32 C = Remap(Triangle.Z);
+				CellIndices.Emplace(A, B, C);
+			}
+		}
+
+		const uint64 Hash = CityHash64WithSeed(
+			reinterpret_cast<const char*>(CellIndices.GetData()),
+			CellIndices.Num() * sizeof(FIntVector),
+			CityHash64(reinterpret_cast<const char*>(CellVertices.GetData()), CellVertices.Num() * sizeof(FVector)));
+
+		auto& SubMesh = CookedTriMeshes->SubMeshes[CellIndex];
+		SubMesh.Hash = Hash;
+
+		if (bReusePreviousCook)
+		{
+			const auto& PreviousSubMesh = PreviousCookedTriMeshes->SubMeshes[CellIndex];
+			if (PreviousSubMesh.TriMesh.IsValid() && PreviousSubMesh.Hash == Hash)
+			{
+				SubMesh.TriMesh = PreviousSubMesh.TriMesh;
+				return;
+			}
+		}
+
+		const auto Process = [&](auto& ChaosTriangles)
+		{
+			Chaos::FTriangleMeshImplicitObject::ParticlesType Particles;
+			Particles.AddParticles(CellVertices.Num());
+			for (int32 Index = 0; Index < CellVertices.Num(); Index++)
+			{
+				Particles.X(Index) = CellVertices[Index];
+			}
+
+			ChaosTriangles.Reserve(CellIndices.Num());
+			for (const FIntVector& Triangle : CellIndices)
+			{
+				ChaosTriangles.Emplace(Triangle.X, Triangle.Y, Triangle.Z);
+				
+#if VOXEL_DEBUG
+				ensure(Chaos::FConvexBuilder::IsValidTriangle(Particles.X(Triangle.X), Particles.X(Triangle.Y), Particles.X(Triangle.Z)));
+#endif
+			}
+
+			TArray<uint16> MaterialIndices;
+			
+			VOXEL_ASYNC_SCOPE_COUNTER("Build Tri Mesh");
+			SubMesh.TriMesh = MakeShareable(new Chaos::FTriangleMeshImplicitObject(MoveTemp(Particles), MoveTemp(ChaosTriangles), MoveTemp(MaterialIndices)));
+		};
+
+		if (CellVertices.Num() < TNumericLimits<uint16>::Max())
+		{
+			TArray<Chaos::TVec3<uint16>> TrianglesSmallIdx;
+			Process(TrianglesSmallIdx);
+		}
+		else
+		{
+			TArray<Chaos::TVec3<int32>> TrianglesLargeIdx;
+			Process(TrianglesLargeIdx);
+		}
+	};
+
+	// Each cell has its own BVH, so they can be built in parallel
+	ParallelFor(NumCells, CookCell, NumCells == 1);
+
+	int32 NumReusedSubMeshes = 0;
+	for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+	{
+		const auto& TriMesh = CookedTriMeshes->SubMeshes[CellIndex].TriMesh;
+		if (!TriMesh.IsValid())
+		{
+			continue;
+		}
+
+		TriMeshes.Add(TriMesh);
+
+		if (bReusePreviousCook && PreviousCookedTriMeshes->SubMeshes[CellIndex].TriMesh == TriMesh)
+		{
+			NumReusedSubMeshes++;
+		}
+		else
+		{
+			NewTriMeshes.Add(TriMesh);
+		}
 	}
+
+	LOG_VOXEL(VeryVerbose, TEXT("Chaos collision cooking: %d sub-meshes cooked, %d reused"), NewTriMeshes.Num(), NumReusedSubMeshes);
 }
 #endif
\ No newline at end of file
@@ -13,6 +13,31 @@ namespace Chaos
 
 class IPhysXCooking;
 
+struct FVoxelCookedChaosTriMeshes
+{
+	// The collision mesh is split in a grid of NumCellsPerAxis^3 cells, by triangle centroid
+	FVector GridOrigin = FVector::ZeroVector;
+	FVector CellSize = FVector::ZeroVector;
+	int32 NumCellsPerAxis = 0;
+
+	struct FSubMesh
+	{
+		uint64 Hash = 0;
+		// Null if the cell is empty
+		TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe> TriMesh;
+	};
+	TArray<FSubMesh> SubMeshes;
+
+	bool CanReuseGrid(const FBox& Bounds, int32 InNumCellsPerAxis) const
+	{
+		const FBox Grid(GridOrigin, GridOrigin + CellSize * NumCellsPerAxis);
+		return
+			NumCellsPerAxis == InNumCellsPerAxis &&
+			Grid.IsInsideOrOn(Bounds.Min) &&
+			Grid.IsInsideOrOn(Bounds.Max);
+	}
+};
+
 class FVoxelAsyncPhysicsCooker_Chaos : public IVoxelAsyncPhysicsCooker
 {
 	GENERATED_VOXEL_ASYNC_WORK_BODY(FVoxelAsyncPhysicsCooker_Chaos)
@@ -32,6 +57,12 @@ protected:
 private:
 	void CreateTriMesh();
 
+	const TVoxelSharedPtr<const FVoxelCookedChaosTriMeshes> PreviousCookedTriMeshes;
+	TVoxelSharedPtr<FVoxelCookedChaosTriMeshes> CookedTriMeshes;
+	TVoxelSharedPtr<FVoxelSimpleCollisionData> SimpleCollisionData;
+	
 	TArray<TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>> TriMeshes;
+	// Trimeshes cooked by this cooker, ie not reused from the previous one
+	TArray<TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>> NewTriMeshes;
 };
 #endif
\ No newline at end of file
@@ -73,7 +73,8 @@ void FVoxelAsyncPhysicsCooker_PhysX::CookMesh()
 	{
 		CreateSimpleCollision();
 	}
-	if (CollisionTraceFlag != ECollisionTraceFlag::CTF_UseSimpleAsComplex)
+	// Occupancy collisions have no triangles
+	if (CollisionTraceFlag != ECollisionTraceFlag::CTF_UseSimpleAsComplex && HasTriangles())
 	{
 		CreateTriMesh();
 	}
@@ -219,6 +220,13 @@ void FVoxelAsyncPhysicsCooker_PhysX::CreateTriMesh()
 void FVoxelAsyncPhysicsCooker_PhysX::CreateSimpleCollision()
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	if (bSimpleCubicCollision)
+	{
+		// Checked before the vertices, as occupancy collision buffers only have cubes
+		CookResult.SimpleCollisionData = CreateBoxSimpleCollision();
+		return;
+	}
 	
 	if (Buffers.Num() == 1 && Buffers[0]->GetNumVertices() < 4) return;
 
@@ -227,27 +235,6 @@ void FVoxelAsyncPhysicsCooker_PhysX::CreateSimpleCollision()
 	FVoxelSimpleCollisionData& SimpleCollisionData = *CookResult.SimpleCollisionData;
 	SimpleCollisionData.Bounds = FBox(ForceInit);
 
-	if (bSimpleCubicCollision)
-	{
-	    VOXEL_ASYNC_SCOPE_COUNTER("BoxElems");
-        TArray<FKBoxElem>& BoxElems = SimpleCollisionData.BoxElems;
-        for (auto& Buffer : Buffers)
-        {
-            for (FBox Cube : Buffer->CollisionCubes)
-            {
-                Cube = Cube.TransformBy(LocalToRoot);
-                SimpleCollisionData.Bounds += Cube;
-
-                FKBoxElem& BoxElem = BoxElems.Emplace_GetRef();
-
-				BoxElem.Center = Cube.GetCenter();
-				BoxElem.X = Cube.GetExtent().X * 2;
-				BoxElem.Y = Cube.GetExtent().Y * 2;
-				BoxElem.Z = Cube.GetExtent().Z * 2;
-			}
-		}
-	}
-	else
     {
 		VOXEL_ASYNC_SCOPE_COUNTER("ConvexElems");
         TArray<FKConvexElem>& ConvexElems = SimpleCollisionData.ConvexElems;
@@ -18,12 +18,145 @@
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelRenderer);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Mesher Tasks Started"), STAT_VoxelMesherTasksStarted, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Mesher Tasks Canceled"), STAT_VoxelMesherTasksCanceled, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Mesher Tasks Wasted"), STAT_VoxelMesherTasksWasted, STATGROUP_VoxelCounters);
+
 static TAutoConsoleVariable<int32> CVarFreezeRenderer(
 	TEXT("voxel.renderer.FreezeRenderer"),
 	0,
 	TEXT("Stops renderer tick"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarCancelOutdatedTasksOnEdit(
+	TEXT("voxel.renderer.CancelOutdatedTasksOnEdit"),
+	0,
+	TEXT("If true, meshing tasks of edited chunks that were started before the edit are canceled, so that they are restarted in the edit lane. ")
+	TEXT("Lowers edit latency when the pool is busy, but wastes the work of tasks that were nearly done"),
+	ECVF_Default);
+
+// Time between an edit requesting a chunk update and the new mesh being applied
+// Only accessed on the game thread
+struct FVoxelEditLatencyStats
+{
+	static constexpr int32 MaxSamples = 4096;
+	
+	TArray<double> Samples;
+	int32 NextSampleIndex = 0;
+
+	void AddSample(double Latency)
+	{
+		if (Samples.Num() < MaxSamples)
+		{
+			Samples.Add(Latency);
+		}
+		else
+		{
+			Samples[NextSampleIndex] = Latency;
+			NextSampleIndex = (NextSampleIndex + 1) % MaxSamples;
+		}
+	}
+	void Log() const
+	{
+		if (Samples.Num() == 0)
+		{
+			LOG_VOXEL(Log, TEXT("No edit latency recorded"));
+			return;
+		}
+
+		TArray<double> SortedSamples = Samples;
+		SortedSamples.Sort();
+
+		const auto GetPercentile = [&](double Percentile)
+		{
+			const int32 Index = FMath::Clamp(FMath::FloorToInt(Percentile * (SortedSamples.Num() - 1)), 0, SortedSamples.Num() - 1);
+			return SortedSamples[Index] * 1000;
+		};
+		LOG_VOXEL(Log, TEXT("Edit latency (%d samples): p50: %fms; p90: %fms; p99: %fms; max: %fms"),
+			SortedSamples.Num(),
+			GetPercentile(0.5),
+			GetPercentile(0.9),
+			GetPercentile(0.99),
+			SortedSamples.Last() * 1000);
+	}
+	void Clear()
+	{
+		Samples.Reset();
+		NextSampleIndex = 0;
+	}
+};
+
+static FVoxelEditLatencyStats GVoxelEditLatencyStats;
+
+static FAutoConsoleCommand CmdLogEditLatency(
+	TEXT("voxel.renderer.LogEditLatency"),
+	TEXT("Log the percentiles of the time between an edit and its chunks being updated. Also see voxel.renderer.ClearEditLatency"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		GVoxelEditLatencyStats.Log();
+	}));
+
+static FAutoConsoleCommand CmdClearEditLatency(
+	TEXT("voxel.renderer.ClearEditLatency"),
+	TEXT("Clear the recorded edit latencies. Also see voxel.renderer.LogEditLatency"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		GVoxelEditLatencyStats.Clear();
+		LOG_VOXEL(Log, TEXT("Edit latency cleared"));
+	}));
+
+// Mesher tasks that didn't end up on screen, to tune the LOD hysteresis & min chunk lifetime
+// Only accessed on the game thread
+struct FVoxelMesherTaskStats
+{
+	int64 NumStarted = 0;
+	// Canceled before being done: they might still have been running
+	int64 NumCanceled = 0;
+	// Canceled once done: their result was thrown away
+	int64 NumWasted = 0;
+
+	void Log() const
+	{
+		if (NumStarted == 0)
+		{
+			LOG_VOXEL(Log, TEXT("No mesher task recorded"));
+			return;
+		}
+
+		LOG_VOXEL(Log, TEXT("Mesher tasks: %lld started; %lld canceled (%.1f%%); %lld wasted (%.1f%%)"),
+			NumStarted,
+			NumCanceled,
+			100. * NumCanceled / NumStarted,
+			NumWasted,
+			100. * NumWasted / NumStarted);
+	}
+	void Clear()
+	{
+		NumStarted = 0;
+		NumCanceled = 0;
+		NumWasted = 0;
+	}
+};
+
+static FVoxelMesherTaskStats GVoxelMesherTaskStats;
+
+static FAutoConsoleCommand CmdLogMesherTasks(
+	TEXT("voxel.renderer.LogMesherTasks"),
+	TEXT("Log the number of mesher tasks started, canceled and wasted. Also see voxel.renderer.ClearMesherTasks"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		GVoxelMesherTaskStats.Log();
+	}));
+
+static FAutoConsoleCommand CmdClearMesherTasks(
+	TEXT("voxel.renderer.ClearMesherTasks"),
+	TEXT("Clear the recorded mesher tasks. Also see voxel.renderer.LogMesherTasks"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		GVoxelMesherTaskStats.Clear();
+		LOG_VOXEL(Log, TEXT("Mesher tasks cleared"));
+	}));
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -119,6 +252,19 @@ int32 FVoxelDefaultRenderer::UpdateChunks(
 	{
 		auto& Chunk = ChunksMap.FindChecked(ChunkId);
 		Chunk.PendingUpdates.Add({ Time, FinishDelegate });
+		// Tasks started before the edit are outdated and might be waiting behind lots of LOD tasks:
+		// optionally cancel them so that they are restarted in the edit lane
+		if (CVarCancelOutdatedTasksOnEdit.GetValueOnGameThread() != 0)
+		{
+			if (Chunk.Tasks.MainTask.IsValid() && Chunk.Tasks.MainTask->TaskType != EVoxelTaskType::EditChunksMeshing)
+			{
+				CancelTask(Chunk.Tasks.MainTask);
+			}
+			if (Chunk.Tasks.TransitionsTask.IsValid() && Chunk.Tasks.TransitionsTask->TaskType != EVoxelTaskType::EditChunksMeshing)
+			{
+				CancelTask(Chunk.Tasks.TransitionsTask);
+			}
+		}
 		// Trigger tasks if not already triggered: if they are, they will trigger new ones when their callback will be processed in Tick
 		StartTask<EMainOrTransitions::Main, EIfTaskExists::DoNothing>(Chunk);
 		StartTask<EMainOrTransitions::Transitions, EIfTaskExists::DoNothing>(Chunk);
@@ -731,6 +877,10 @@ void FVoxelDefaultRenderer::Tick(float)
 
 	const double Time = FPlatformTime::Seconds();
 	const double MaxTime = Time + Settings.MeshUpdatesBudget * 0.001f;
+
+	// Only record ticks with mesh updates, to not dilute the rate with idle time
+	const int64 NumAppliedChunks = GVoxelMeshUpdateRateStats.NumAppliedChunks;
+	const bool bHasCallbacks = !TasksCallbacksQueue.IsEmpty() || !EditTasksCallbacksQueue.IsEmpty();
 	
 	{
 		VOXEL_SCOPE_COUNTER("MeshHandler Tick");
@@ -741,7 +891,12 @@ void FVoxelDefaultRenderer::Tick(float)
 	ProcessMeshUpdates(MaxTime);
 	FlushQueuedTasks();
 
-	if (!OnWorldLoadedFired && UpdateIndex > 0 && TaskCount.GetValue() == 0 && TasksCallbacksQueue.IsEmpty())
+	if (bHasCallbacks || GVoxelMeshUpdateRateStats.NumAppliedChunks != NumAppliedChunks)
+	{
+		GVoxelMeshUpdateRateStats.TotalTime += FPlatformTime::Seconds() - Time;
+	}
+
+	if (!OnWorldLoadedFired && UpdateIndex > 0 && TaskCount.GetValue() == 0 && TasksCallbacksQueue.IsEmpty() && EditTasksCallbacksQueue.IsEmpty())
 	{
 		RuntimeData->OnWorldLoaded.Broadcast();
 		OnWorldLoadedFired = true;
@@ -749,7 +904,7 @@ void FVoxelDefaultRenderer::Tick(float)
 
 	UpdateAllocatedSize();
 
-	GetSubsystemChecked<FVoxelDebugManager>().ReportMeshTasksCallbacksQueueNum(TasksCallbacksQueue.Num());
+	GetSubsystemChecked<FVoxelDebugManager>().ReportMeshTasksCallbacksQueueNum(TasksCallbacksQueue.Num() + EditTasksCallbacksQueue.Num());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -813,8 +968,13 @@ void FVoxelDefaultRenderer::StartTask(FChunk& Chunk)
 		}
 	}
 	
+	// Pending updates are only added by edits: if we have any, the player is waiting for this task
+	const bool bIsEditTask = Chunk.PendingUpdates.Num() > 0;
+	
 	const auto TaskType =
-		Chunk.Settings.bVisible
+		bIsEditTask
+		? EVoxelTaskType::EditChunksMeshing
+		: Chunk.Settings.bVisible
 		? Chunk.Settings.bEnableCollisions
 		? EVoxelTaskType::VisibleCollisionsChunksMeshing
 		: EVoxelTaskType::VisibleChunksMeshing
@@ -830,7 +990,23 @@ void FVoxelDefaultRenderer::StartTask(FChunk& Chunk)
 		MainOrTransitions == EMainOrTransitions::Transitions,
 		MainOrTransitions == EMainOrTransitions::Transitions ? Chunk.Settings.TransitionsMask : 0,
 		TaskType);
-	QueuedTasks[Chunk.Settings.bVisible][Chunk.Settings.bEnableCollisions].Emplace(Task.Get());
+
+	INC_DWORD_STAT(STAT_VoxelMesherTasksStarted);
+	GVoxelMesherTaskStats.NumStarted++;
+
+	if (MainOrTransitions == EMainOrTransitions::Main && Chunk.BuiltData.MainChunk.IsValid())
+	{
+		Task->PreviousDistanceFieldCache = Chunk.BuiltData.MainChunk->GetDistanceFieldCache();
+	}
+
+	if (bIsEditTask)
+	{
+		QueuedEditTasks.Emplace(Task.Get());
+	}
+	else
+	{
+		QueuedTasks[Chunk.Settings.bVisible][Chunk.Settings.bEnableCollisions].Emplace(Task.Get());
+	}
 }
 
 void FVoxelDefaultRenderer::CancelTasks(FChunk& Chunk)
@@ -1120,6 +1296,7 @@ void FVoxelDefaultRenderer::CheckPendingUpdates(FChunk& Chunk)
 		}
 		if (PendingUpdate.WantedUpdateTime < FMath::Min(Chunk.BuiltData.MainChunkCreationTime, Chunk.BuiltData.TransitionsChunkCreationTime))
 		{
+			GVoxelEditLatencyStats.AddSample(FPlatformTime::Seconds() - PendingUpdate.WantedUpdateTime);
 			PendingUpdate.OnUpdateFinished.Broadcast(Chunk.Bounds);
 			Chunk.PendingUpdates.RemoveAtSwap(Index);
 			Index--;
@@ -1196,109 +1373,127 @@ void FVoxelDefaultRenderer::ProcessMeshUpdates(double MaxTime)
 	VOXEL_FUNCTION_COUNTER();
 	
 	FVoxelTaskCallback Callback;
+	
+	{
+		VOXEL_SCOPE_COUNTER("Edit Tasks");
+		// Meshes of edited chunks have their own budget, and are always applied first
+		const double EditMaxTime = FPlatformTime::Seconds() + Settings.EditMeshUpdatesBudget * 0.001f;
+		while ( // First check the time, else dequeued elements aren't processed!
+			FPlatformTime::Seconds() < EditMaxTime &&
+			EditTasksCallbacksQueue.Dequeue(Callback))
+		{
+			ProcessMeshUpdate(Callback);
+		}
+	}
+	
 	while ( // First check the time, else dequeued elements aren't processed!
 		FPlatformTime::Seconds() < MaxTime &&
 		TasksCallbacksQueue.Dequeue(Callback))
 	{
-		FChunk* Chunk = ChunksMap.Find(Callback.ChunkId);
-		if (!Chunk) continue;
-
-		auto& Tasks = Chunk->Tasks;
-		auto& Task = Callback.bIsTransitionTask ? Tasks.TransitionsTask : Tasks.MainTask;
-		if (!Task.IsValid() || Task->TaskId != Callback.TaskId) continue; // If task was canceled
-		if (!ensure(Task->IsDone())) continue; // Must be done if we're in the callback
+		ProcessMeshUpdate(Callback);
+	}
+}
 
-		// Move built data
-		auto& BuiltData = Chunk->BuiltData;
-		const auto PreviousBuiltData = BuiltData;
-		if (Callback.bIsTransitionTask)
-		{
-			ensure(Task->TransitionsMask == Chunk->Settings.TransitionsMask); // Should have been canceled
-			BuiltData.TransitionsMask = Task->TransitionsMask;
-			BuiltData.TransitionsChunk = Task->Chunk;
-			BuiltData.TransitionsChunkCreationTime = Task->CreationTime;
-		}
-		else
-		{
-			BuiltData.MainChunk = Task->Chunk;
-			BuiltData.MainChunkCreationTime = Task->CreationTime;
-		}
+void FVoxelDefaultRenderer::ProcessMeshUpdate(const FVoxelTaskCallback& Callback)
+{
+	FChunk* Chunk = ChunksMap.Find(Callback.ChunkId);
+	if (!Chunk) return;
+
+	auto& Tasks = Chunk->Tasks;
+	auto& Task = Callback.bIsTransitionTask ? Tasks.TransitionsTask : Tasks.MainTask;
+	if (!Task.IsValid() || Task->TaskId != Callback.TaskId) return; // If task was canceled
+	if (!ensure(Task->IsDone())) return; // Must be done if we're in the callback
+
+	// Move built data
+	auto& BuiltData = Chunk->BuiltData;
+	const auto PreviousBuiltData = BuiltData;
+	if (Callback.bIsTransitionTask)
+	{
+		ensure(Task->TransitionsMask == Chunk->Settings.TransitionsMask); // Should have been canceled
+		BuiltData.TransitionsMask = Task->TransitionsMask;
+		BuiltData.TransitionsChunk = Task->Chunk;
+		BuiltData.TransitionsChunkCreationTime = Task->CreationTime;
+	}
+	else
+	{
+		BuiltData.MainChunk = Task->Chunk;
+		BuiltData.MainChunkCreationTime = Task->CreationTime;
+	}
 
-		// Finally, delete the task
-		Task.Reset();
+	// Finally, delete the task
+	Task.Reset();
 
-		// Do nothing while the main chunk isn't valid - we don't want to have unneeded updates for transitions then main
-		if (BuiltData.MainChunk.IsValid())
+	// Do nothing while the main chunk isn't valid - we don't want to have unneeded updates for transitions then main
+	if (BuiltData.MainChunk.IsValid())
+	{
+		auto& MeshId = Chunk->MeshId;
+		const auto Update = [&]()
 		{
-			auto& MeshId = Chunk->MeshId;
-			const auto Update = [&]()
+			if (!MeshId.IsValid())
 			{
-				if (!MeshId.IsValid())
-				{
-					MeshId = MeshHandler->AddChunk(Chunk->LOD, Chunk->Bounds.Min);
-				}
-				MeshHandler->UpdateChunk(MeshId, Chunk->Settings, *BuiltData.MainChunk, BuiltData.TransitionsChunk.Get(), BuiltData.TransitionsMask);
-
-				if (Settings.bStaticWorld)
-				{
-					// Free up memory ASAP
-					BuiltData.MainChunk.Reset();
-					BuiltData.TransitionsChunk.Reset();
-				}
-			};
-
-			const bool bTransitionsChunkIsBuilt =
-				BuiltData.TransitionsChunk.IsValid() ||
-				Chunk->Settings.TransitionsMask == 0 ||
-				Settings.RenderType == EVoxelRenderType::SurfaceNets;
+				MeshId = MeshHandler->AddChunk(Chunk->LOD, Chunk->Bounds.Min);
+			}
+			MeshHandler->UpdateChunk(MeshId, Chunk->Settings, *BuiltData.MainChunk, BuiltData.TransitionsChunk.Get(), BuiltData.TransitionsMask);
 
-			if (BuiltData.MainChunk->IsEmpty() && (!BuiltData.TransitionsChunk.IsValid() || BuiltData.TransitionsChunk->IsEmpty()))
+			if (Settings.bStaticWorld)
 			{
-				// Both empty, remove mesh if existing
-				if (MeshId.IsValid())
-				{
-					MeshHandler->RemoveChunk(MeshId);
-					MeshId = {};
-				}
+				// Free up memory ASAP
+				BuiltData.MainChunk.Reset();
+				BuiltData.TransitionsChunk.Reset();
 			}
-			else
-			{
-				Update();
-				
-				ensure(MeshId.IsValid());
+		};
 
-				// Dither in if first update
-				// If first load and LOD 0, don't dither as it doesn't look nice to have the world dithering under the player
-				if (Settings.bDitherChunks &&
-					!PreviousBuiltData.MainChunk.IsValid() && 
-					!(UpdateIndex == 1 && Chunk->LOD == 0))
-				{
-					// Can be a first update if:
-					// - we are a showed new chunks that's dithering in
-					// - we are a hidden chunk that's updated for the first time. If so don't dither in
-					ensure(Chunk->GetState() == EChunkState::Hidden || Chunk->GetState() == EChunkState::DitheringIn);
-					if (Chunk->GetState() == EChunkState::DitheringIn)
-					{
-						DitherInChunk(*Chunk, Chunk->PreviousChunks);
-					}
-				}
-			}
+		const bool bTransitionsChunkIsBuilt =
+			BuiltData.TransitionsChunk.IsValid() ||
+			Chunk->Settings.TransitionsMask == 0 ||
+			Settings.RenderType == EVoxelRenderType::SurfaceNets;
 
-			// Dither out/remove previous chunks only once transitions are built too
-			// Note: bTransitionsChunkIsBuilt is always true for surface nets
-			if (bTransitionsChunkIsBuilt)
+		if (BuiltData.MainChunk->IsEmpty() && (!BuiltData.TransitionsChunk.IsValid() || BuiltData.TransitionsChunk->IsEmpty()))
+		{
+			// Both empty, remove mesh if existing
+			if (MeshId.IsValid())
 			{
-				ClearPreviousChunks(*Chunk);
+				MeshHandler->RemoveChunk(MeshId);
+				MeshId = {};
 			}
 		}
 		else
 		{
-			ensure(!Chunk->MeshId.IsValid());
+			Update();
+			
+			ensure(MeshId.IsValid());
+
+			// Dither in if first update
+			// If first load and LOD 0, don't dither as it doesn't look nice to have the world dithering under the player
+			if (Settings.bDitherChunks &&
+				!PreviousBuiltData.MainChunk.IsValid() && 
+				!(UpdateIndex == 1 && Chunk->LOD == 0))
+			{
+				// Can be a first update if:
+				// - we are a showed new chunks that's dithering in
+				// - we are a hidden chunk that's updated for the first time. If so don't dither in
+				ensure(Chunk->GetState() == EChunkState::Hidden || Chunk->GetState() == EChunkState::DitheringIn);
+				if (Chunk->GetState() == EChunkState::DitheringIn)
+				{
+					DitherInChunk(*Chunk, Chunk->PreviousChunks);
+				}
+			}
 		}
 
-		// Start new tasks as needed
-		CheckPendingUpdates(*Chunk);
+		// Dither out/remove previous chunks only once transitions are built too
+		// Note: bTransitionsChunkIsBuilt is always true for surface nets
+		if (bTransitionsChunkIsBuilt)
+		{
+			ClearPreviousChunks(*Chunk);
+		}
 	}
+	else
+	{
+		ensure(!Chunk->MeshId.IsValid());
+	}
+
+	// Start new tasks as needed
+	CheckPendingUpdates(*Chunk);
 }
 
 void FVoxelDefaultRenderer::FlushQueuedTasks()
@@ -1327,6 +1522,13 @@ void FVoxelDefaultRenderer::FlushQueuedTasks()
 	Flush(false, true);
 	Flush(true, false);
 	Flush(true, true);
+
+	if (QueuedEditTasks.Num() > 0)
+	{
+		TaskCount.Add(QueuedEditTasks.Num());
+		GetSubsystemChecked<FVoxelPool>().QueueTasks(EVoxelTaskType::EditChunksMeshing, QueuedEditTasks);
+		QueuedEditTasks.Reset();
+	}
 }
 
 void FVoxelDefaultRenderer::DestroyChunk(FChunk& Chunk)
@@ -1376,11 +1578,26 @@ void FVoxelDefaultRenderer::CancelTask(TVoxelAsyncWorkPtr<FVoxelMesherAsyncWork>
 	{
 		// If IsDone, QueueChunkCallback_AnyThread was called
 		ensure(TaskCount.Decrement() >= 0);
+
+		INC_DWORD_STAT(STAT_VoxelMesherTasksCanceled);
+		GVoxelMesherTaskStats.NumCanceled++;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_VoxelMesherTasksWasted);
+		GVoxelMesherTaskStats.NumWasted++;
 	}
 }
 
-void FVoxelDefaultRenderer::QueueChunkCallback_AnyThread(uint64 TaskId, uint64 ChunkId, bool bIsTransitionTask)
+void FVoxelDefaultRenderer::QueueChunkCallback_AnyThread(uint64 TaskId, uint64 ChunkId, bool bIsTransitionTask, bool bIsEditTask)
 {
 	ensure(TaskCount.Decrement() >= 0);
-	TasksCallbacksQueue.Enqueue({TaskId, ChunkId, bIsTransitionTask});
+	if (bIsEditTask)
+	{
+		EditTasksCallbacksQueue.Enqueue({TaskId, ChunkId, bIsTransitionTask});
+	}
+	else
+	{
+		TasksCallbacksQueue.Enqueue({TaskId, ChunkId, bIsTransitionTask});
+	}
 }
\ No newline at end of file
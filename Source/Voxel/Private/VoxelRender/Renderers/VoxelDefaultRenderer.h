@@ -172,6 +172,8 @@ private:
 	TArray<FChunkToShow> ChunksToShow;
 
 	TArray<IVoxelQueuedWork*> QueuedTasks[2][2]; // [bVisible][bHasCollisions]
+	// Tasks started to fulfill a pending update, ie caused by an edit. Scheduled in the thread pool low latency lane
+	TArray<IVoxelQueuedWork*> QueuedEditTasks;
 
 	enum class EIfTaskExists : uint8
 	{
@@ -213,7 +215,7 @@ private:
 	void UpdateAllocatedSize();
 
 public:
-	void QueueChunkCallback_AnyThread(uint64 TaskId, uint64 ChunkId, bool bIsTransitionTask);
+	void QueueChunkCallback_AnyThread(uint64 TaskId, uint64 ChunkId, bool bIsTransitionTask, bool bIsEditTask);
 
 private:
 	struct FVoxelTaskCallback
@@ -223,6 +225,10 @@ private:
 		bool bIsTransitionTask;
 	};
 	TVoxelQueueWithNum<FVoxelTaskCallback, EQueueMode::Mpsc> TasksCallbacksQueue;
+	// Callbacks of edit tasks, processed before TasksCallbacksQueue with their own budget
+	TVoxelQueueWithNum<FVoxelTaskCallback, EQueueMode::Mpsc> EditTasksCallbacksQueue;
+
+	void ProcessMeshUpdate(const FVoxelTaskCallback& Callback);
 
 	void CancelTask(TVoxelAsyncWorkPtr<FVoxelMesherAsyncWork>& Task);
 };
\ No newline at end of file
@@ -66,17 +66,32 @@ void FVoxelMesherAsyncWork::DoWork()
 	if (IsCanceled()) return;
 	if (!Data.IsValid()) return; // Happens when the renderer is still canceling tasks
 
-	const auto Mesher = GetMesher(
-		ChunkPosition,
-		*PinnedRenderer,
-		*Data,
-		LOD,
-		bIsTransitionTask,
-		TransitionsMask);
+	const bool bOccupancyCollision = PinnedRenderer->Settings.bOccupancyCollision && !bIsTransitionTask;
+	
+	TUniquePtr<FVoxelMesherBase> Mesher;
+	if (bOccupancyCollision)
+	{
+		// Occupancy collisions don't need any triangle: build the cubes directly, whatever the render type is
+		Mesher = MakeUnique<FVoxelGreedyCubicMesher>(LOD, ChunkPosition, *PinnedRenderer, *Data, true);
+	}
+	else
+	{
+		Mesher = GetMesher(
+			ChunkPosition,
+			*PinnedRenderer,
+			*Data,
+			LOD,
+			bIsTransitionTask,
+			TransitionsMask);
+	}
+
+	// Edited chunks are likely to be edited again: keep their distance field data to only recompute what the next edits change
+	Mesher->PreviousDistanceFieldCache = PreviousDistanceFieldCache;
+	Mesher->bKeepDistanceFieldCache = TaskType == EVoxelTaskType::EditChunksMeshing;
 
 	CreationTime = FPlatformTime::Seconds();
 
-	if (PinnedRenderer->Settings.bRenderWorld)
+	if (PinnedRenderer->Settings.bRenderWorld || bOccupancyCollision)
 	{
 		const auto MesherChunk = Mesher->CreateFullChunk();
 		if (MesherChunk.IsValid())
@@ -115,7 +130,7 @@ void FVoxelMesherAsyncWork::PostDoWork()
 	auto RendererPtr = Renderer.Pin();
 	if (ensure(RendererPtr.IsValid()))
 	{
-		RendererPtr->QueueChunkCallback_AnyThread(TaskId, ChunkId, bIsTransitionTask);
+		RendererPtr->QueueChunkCallback_AnyThread(TaskId, ChunkId, bIsTransitionTask, TaskType == EVoxelTaskType::EditChunksMeshing);
 	}
 }
 
@@ -20,7 +20,8 @@ public:
 	static FVoxelBasicMeshMergeWork* Create(
 		FVoxelRendererBasicMeshHandler& Handler,
 		FVoxelRendererBasicMeshHandler::FChunkInfoRef ChunkInfoRef,
-		FVoxelChunkMeshesToBuild&& MeshesToBuild)
+		FVoxelChunkMeshesToBuild&& MeshesToBuild,
+		const TVoxelSharedPtr<const FDistanceFieldVolumeData>& DistanceFieldVolumeData)
 	{
 		auto* ChunkInfo = Handler.GetChunkInfo(ChunkInfoRef);
 		check(ChunkInfo);
@@ -29,7 +30,8 @@ public:
 			ChunkInfo->Position,
 			Handler,
 			ChunkInfo->UpdateIndex.ToSharedRef(),
-			MoveTemp(MeshesToBuild));
+			MoveTemp(MeshesToBuild),
+			DistanceFieldVolumeData);
 	}
 
 private:
@@ -39,6 +41,7 @@ private:
 	const TVoxelWeakPtr<FVoxelRendererBasicMeshHandler> Handler;
 
 	const FVoxelChunkMeshesToBuild MeshesToBuild;
+	const TVoxelSharedPtr<const FDistanceFieldVolumeData> DistanceFieldVolumeData;
 	const TVoxelSharedRef<FThreadSafeCounter> UpdateIndexPtr;
 	const int32 UpdateIndex;
 
@@ -47,13 +50,15 @@ private:
 		const FIntVector& Position,
 		FVoxelRendererBasicMeshHandler& Handler,
 		const TVoxelSharedRef<FThreadSafeCounter>& UpdateIndexPtr,
-		FVoxelChunkMeshesToBuild&& MeshesToBuild)
+		FVoxelChunkMeshesToBuild&& MeshesToBuild,
+		const TVoxelSharedPtr<const FDistanceFieldVolumeData>& DistanceFieldVolumeData)
 		: FVoxelAsyncWork(STATIC_FNAME("FVoxelBasicMeshMergeWork"), EVoxelTaskType::MeshMerge, EPriority::Null, true)
 		, ChunkInfoRef(Ref)
 		, Position(Position)
 		, Settings(Handler.Renderer.Settings)
 		, Handler(StaticCastSharedRef<FVoxelRendererBasicMeshHandler>(Handler.AsShared()))
 		, MeshesToBuild(MoveTemp(MeshesToBuild))
+		, DistanceFieldVolumeData(DistanceFieldVolumeData)
 		, UpdateIndexPtr(UpdateIndexPtr)
 		, UpdateIndex(UpdateIndexPtr->GetValue())
 	{
@@ -77,7 +82,7 @@ private:
 		if (HandlerPinned.IsValid())
 		{
 			// Queue callback
-			HandlerPinned->MeshMergeCallback(ChunkInfoRef, UpdateIndex, MoveTemp(BuiltMeshes));
+			HandlerPinned->MeshMergeCallback(ChunkInfoRef, UpdateIndex, MoveTemp(BuiltMeshes), DistanceFieldVolumeData);
 		}
 	}
 };
@@ -137,14 +142,18 @@ void FVoxelRendererBasicMeshHandler::ApplyAction(const FAction& Action)
 			ChunkInfo.DitheringInfo);
 
 		// Start a task to asynchronously build them
-		auto* Task = FVoxelBasicMeshMergeWork::Create(*this, { Action.ChunkId, ChunkInfo.UniqueId }, MoveTemp(MeshesToBuild));
+		// The distance field was built by the mesher task, and is applied with the built meshes
+		auto* Task = FVoxelBasicMeshMergeWork::Create(
+			*this,
+			{ Action.ChunkId, ChunkInfo.UniqueId },
+			MoveTemp(MeshesToBuild),
+			MainChunk.GetDistanceFieldVolumeData());
 		Renderer.GetSubsystemChecked<FVoxelPool>().QueueTask(Task);
 
 		FAction NewAction;
 		NewAction.Action = EAction::UpdateChunk;
 		NewAction.ChunkId = Action.ChunkId;
 		NewAction.UpdateChunk().AfterCall.UpdateIndex = ChunkInfo.UpdateIndex->GetValue();
-		NewAction.UpdateChunk().AfterCall.DistanceFieldVolumeData = Action.UpdateChunk().InitialCall.MainChunk->GetDistanceFieldVolumeData();
 		ActionQueue.Enqueue(NewAction);
 			
 		if (Renderer.Settings.RenderType == EVoxelRenderType::SurfaceNets)
@@ -253,6 +262,7 @@ void FVoxelRendererBasicMeshHandler::FlushActionQueue(double MaxTime)
 					// Stored built data is outdated, clear it to save memory
 					ensure(ChunkInfo.BuiltData.BuiltMeshes.IsValid());
 					ChunkInfo.BuiltData.BuiltMeshes.Reset();
+					ChunkInfo.BuiltData.DistanceFieldVolumeData.Reset();
 					ChunkInfo.BuiltData.UpdateIndex = -1;
 				}
 
@@ -261,6 +271,7 @@ void FVoxelRendererBasicMeshHandler::FlushActionQueue(double MaxTime)
 
 			// Move to clear the built data value
 			const auto BuiltMeshes = MoveTemp(ChunkInfo.BuiltData.BuiltMeshes);
+			const auto DistanceFieldVolumeData = MoveTemp(ChunkInfo.BuiltData.DistanceFieldVolumeData);
 			ChunkInfo.MeshUpdateIndex = ChunkInfo.BuiltData.UpdateIndex;
 			ChunkInfo.BuiltData.UpdateIndex = -1;
 
@@ -282,7 +293,9 @@ void FVoxelRendererBasicMeshHandler::FlushActionQueue(double MaxTime)
 				auto& Mesh = *ChunkInfo.Meshes[MeshIndex];
 				MeshConfig.ApplyTo(Mesh);
 
-				Mesh.SetDistanceFieldData(nullptr);
+				// Use the first mesh to hold the distance field data
+				// Set it directly: clearing it first would update the distance field scene twice
+				Mesh.SetDistanceFieldData(MeshIndex == 0 ? DistanceFieldVolumeData : nullptr);
 				Mesh.ClearSections(EVoxelProcMeshSectionUpdate::DelayUpdate);
 				for (auto& Section : BuiltMesh.Value)
 				{
@@ -302,17 +315,10 @@ void FVoxelRendererBasicMeshHandler::FlushActionQueue(double MaxTime)
 				Mesh.ClearSections(EVoxelProcMeshSectionUpdate::UpdateNow);
 			}
 
-			// Handle distance fields
-			const auto& DistanceFieldVolumeData = Action.UpdateChunk().AfterCall.DistanceFieldVolumeData;
-			if (DistanceFieldVolumeData.IsValid())
-			{
-				// Use the first mesh to hold the distance field data
-				// We should always have at least one mesh, else the chunk should have been removed instead of updated
-				if (ensure(ChunkInfo.Meshes.Num() > 0))
-				{
-					ChunkInfo.Meshes[0]->SetDistanceFieldData(DistanceFieldVolumeData);
-				}
-			}
+			// We should always have at least one mesh, else the chunk should have been removed instead of updated
+			ensure(!DistanceFieldVolumeData.IsValid() || ChunkInfo.Meshes.Num() > 0);
+
+			GVoxelMeshUpdateRateStats.AddAppliedChunk();
 			break;
 		}
 		case EAction::RemoveChunk:
@@ -383,7 +389,7 @@ void FVoxelRendererBasicMeshHandler::FlushActionQueue(double MaxTime)
 	}
 }
 
-void FVoxelRendererBasicMeshHandler::MeshMergeCallback(FChunkInfoRef ChunkInfoRef, int32 UpdateIndex, TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes)
+void FVoxelRendererBasicMeshHandler::MeshMergeCallback(FChunkInfoRef ChunkInfoRef, int32 UpdateIndex, TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes, const TVoxelSharedPtr<const FDistanceFieldVolumeData>& DistanceFieldVolumeData)
 {
-	CallbackQueue.Enqueue({ ChunkInfoRef, FChunkBuiltData{ UpdateIndex,  MoveTemp(BuiltMeshes) } });
+	CallbackQueue.Enqueue({ ChunkInfoRef, FChunkBuiltData{ UpdateIndex, MoveTemp(BuiltMeshes), DistanceFieldVolumeData } });
 }
\ No newline at end of file
@@ -26,6 +26,8 @@ private:
 	{
 		int32 UpdateIndex = -1;
 		TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes;
+		// Carried along the built meshes so that they are applied together
+		TVoxelSharedPtr<const FDistanceFieldVolumeData> DistanceFieldVolumeData;
 	};
 	struct FChunkInfo
 	{
@@ -100,7 +102,7 @@ private:
 
 	void FlushBuiltDataQueue();
 	void FlushActionQueue(double MaxTime);
-	void MeshMergeCallback(FChunkInfoRef ChunkInfoRef, int32 UpdateIndex, TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes);
+	void MeshMergeCallback(FChunkInfoRef ChunkInfoRef, int32 UpdateIndex, TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes, const TVoxelSharedPtr<const FDistanceFieldVolumeData>& DistanceFieldVolumeData);
 
 	friend class FVoxelBasicMeshMergeWork;
 };
\ No newline at end of file
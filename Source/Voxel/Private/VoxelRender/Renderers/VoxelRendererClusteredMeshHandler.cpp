@@ -388,6 +388,8 @@ void FVoxelRendererClusteredMeshHandler::FlushActionQueue(double MaxTime)
 #endif
 				// TODO: No distance fields with merging = on
 			}
+
+			GVoxelMeshUpdateRateStats.AddAppliedChunk();
 			break;
 		}
 		case EAction::RemoveChunk:
@@ -17,6 +17,54 @@ TAutoConsoleVariable<int32> CVarLogActionQueue(
 	TEXT("If true, will log every queued action when processed"),
 	ECVF_Default);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Chunk Meshes Applied"), STAT_VoxelChunkMeshesApplied, STATGROUP_VoxelCounters);
+
+FVoxelMeshUpdateRateStats GVoxelMeshUpdateRateStats;
+
+void FVoxelMeshUpdateRateStats::AddAppliedChunk()
+{
+	check(IsInGameThread());
+	INC_DWORD_STAT(STAT_VoxelChunkMeshesApplied);
+	NumAppliedChunks++;
+}
+
+void FVoxelMeshUpdateRateStats::Log() const
+{
+	if (TotalTime <= 0)
+	{
+		LOG_VOXEL(Log, TEXT("No mesh update recorded"));
+		return;
+	}
+
+	LOG_VOXEL(Log, TEXT("Mesh updates: %lld chunks applied in %fms of game thread time: %f chunks/ms"),
+		NumAppliedChunks,
+		TotalTime * 1000,
+		NumAppliedChunks / (TotalTime * 1000));
+}
+
+void FVoxelMeshUpdateRateStats::Clear()
+{
+	NumAppliedChunks = 0;
+	TotalTime = 0;
+}
+
+static FAutoConsoleCommand CmdLogMeshUpdateRate(
+	TEXT("voxel.renderer.LogMeshUpdateRate"),
+	TEXT("Log the number of chunk meshes applied per millisecond of game thread time spent on mesh updates. Also see voxel.renderer.ClearMeshUpdateRate"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		GVoxelMeshUpdateRateStats.Log();
+	}));
+
+static FAutoConsoleCommand CmdClearMeshUpdateRate(
+	TEXT("voxel.renderer.ClearMeshUpdateRate"),
+	TEXT("Clear the recorded mesh update rate. Also see voxel.renderer.LogMeshUpdateRate"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		GVoxelMeshUpdateRateStats.Clear();
+		LOG_VOXEL(Log, TEXT("Mesh update rate cleared"));
+	}));
+
 IVoxelRendererMeshHandler::IVoxelRendererMeshHandler(IVoxelRenderer& Renderer)
 	: Renderer(Renderer)
 {
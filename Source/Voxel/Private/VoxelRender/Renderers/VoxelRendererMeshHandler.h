@@ -22,6 +22,22 @@ class TAutoConsoleVariable;
 
 extern TAutoConsoleVariable<int32> CVarLogActionQueue;
 
+// Rate at which built chunk meshes are applied to their components, see voxel.renderer.LogMeshUpdateRate
+// Only accessed on the game thread
+struct FVoxelMeshUpdateRateStats
+{
+	// Chunk updates applied to components
+	int64 NumAppliedChunks = 0;
+	// Game thread time spent processing mesher callbacks and applying meshes, in seconds
+	double TotalTime = 0;
+
+	void AddAppliedChunk();
+	void Log() const;
+	void Clear();
+};
+
+extern FVoxelMeshUpdateRateStats GVoxelMeshUpdateRateStats;
+
 class IVoxelRendererMeshHandler : public IVoxelProceduralMeshComponent_PhysicsCallbackHandler
 {
 public:
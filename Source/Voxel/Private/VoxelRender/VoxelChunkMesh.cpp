@@ -17,6 +17,19 @@
 #endif
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelChunkMeshMemory);
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelChunkDistanceFieldCacheMemory);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Distance Field Bricks Recomputed"), STAT_VoxelDistanceFieldBricksRecomputed, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Distance Field Bricks Reused"), STAT_VoxelDistanceFieldBricksReused, STATGROUP_VoxelCounters);
+
+static TAutoConsoleVariable<int32> CVarIncrementalDistanceFields(
+	TEXT("voxel.renderer.IncrementalDistanceFields"),
+	1,
+	TEXT("If true, edited chunks keep their distance field data so that the next edits only recompute the bricks they affect"),
+	ECVF_Default);
+
+// Size of the bricks of low resolution distance field cells recomputed when a chunk is edited
+static constexpr int32 DistanceFieldBrickSize = 4;
 
 #if ENABLE_TESSELLATION
 /**
@@ -122,6 +135,10 @@ void FVoxelChunkMeshBuffers::ComputeBounds()
 	{
 		Bounds += Vertex;
 	}
+	for (auto& Cube : CollisionCubes)
+	{
+		Bounds += Cube;
+	}
 }
 
 void FVoxelChunkMeshBuffers::UpdateStats()
@@ -142,7 +159,13 @@ void FVoxelChunkMeshBuffers::UpdateStats()
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FIntVector& Position, const FVoxelData& Data, const FVoxelRuntimeSettings& Settings)
+void FVoxelChunkMesh::BuildDistanceField(
+	int32 LOD, 
+	const FIntVector& Position, 
+	const FVoxelData& Data, 
+	const FVoxelRuntimeSettings& Settings,
+	TVoxelSharedPtr<const FVoxelChunkDistanceFieldCache> PreviousCache,
+	bool bKeepCache)
 {
 #if VOXEL_ENGINE_VERSION < 500
 	VOXEL_ASYNC_FUNCTION_COUNTER();
@@ -160,38 +183,190 @@ void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FIntVector& Position,
 	const int32 Divisor = FMath::Clamp(Settings.DistanceFieldResolutionDivisor, 1, HighResSize);
 	const int32 Size = FVoxelUtilities::DivideCeil(HighResSize, Divisor);
 
-	const auto GetDistanceField = [&]()
+	static const auto CVarEightBit = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.DistanceFieldBuild.EightBit"));
+	static const auto CVarCompress = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.DistanceFieldBuild.Compress"));
+	
+	const bool bEightBitFixedPoint = CVarEightBit->GetValueOnAnyThread() != 0;
+	const bool bCompress = CVarCompress->GetValueOnAnyThread() != 0;
+
+	const int32 ValuesSize = HighResSize + 2;
+	const int32 NumValues = ValuesSize * ValuesSize * ValuesSize;
+
+	FVoxelValueArray Values;
+	Values.Empty(NumValues);
+	Values.SetNumUninitialized(NumValues);
 	{
-		const int32 ValuesSize = HighResSize + 2;
-		const int32 NumValues = ValuesSize * ValuesSize * ValuesSize;
+		const FIntVector Start = Position - Extension * Step;
+		const FVoxelIntBox Bounds = FVoxelIntBox(Start, Start + HighResSize * Step).Extend(Step); // Extend: See GetSurfacePositionsFromDensities
 
-		FVoxelValueArray Values;
-		Values.Empty(NumValues);
-		Values.SetNumUninitialized(NumValues);
-		{
-			const FIntVector Start = Position - Extension * Step;
-			const FVoxelIntBox Bounds = FVoxelIntBox(Start, Start + HighResSize * Step).Extend(Step); // Extend: See GetSurfacePositionsFromDensities
+		FVoxelReadScopeLock Lock(Data, Bounds, FUNCTION_FNAME);
+		TVoxelQueryZone<FVoxelValue> QueryZone(Bounds, FIntVector(ValuesSize), LOD, Values);
+		Data.Get<FVoxelValue>(QueryZone, LOD);
+	}
 
-			FVoxelReadScopeLock Lock(Data, Bounds, FUNCTION_FNAME);
-			TVoxelQueryZone<FVoxelValue> QueryZone(Bounds, FIntVector(ValuesSize), LOD, Values);
-			Data.Get<FVoxelValue>(QueryZone, LOD);
+	if (CVarIncrementalDistanceFields.GetValueOnAnyThread() == 0)
+	{
+		PreviousCache.Reset();
+		bKeepCache = false;
+	}
+	if (PreviousCache.IsValid() && !(
+		PreviousCache->LOD == LOD &&
+		PreviousCache->Position == Position &&
+		PreviousCache->Extension == Extension &&
+		PreviousCache->Divisor == Divisor &&
+		PreviousCache->bEightBitFixedPoint == bEightBitFixedPoint &&
+		PreviousCache->bCompress == bCompress &&
+		PreviousCache->Values.Num() == NumValues &&
+		PreviousCache->SurfacePositions.Num() == Size * Size * Size &&
+		PreviousCache->VolumeData.IsValid()))
+	{
+		PreviousCache.Reset();
+	}
+
+	if (PreviousCache.IsValid() && PreviousCache->Values == Values)
+	{
+		// The edit didn't change the densities around this chunk
+		INC_DWORD_STAT_BY(STAT_VoxelDistanceFieldBricksReused, FMath::Cube(FVoxelUtilities::DivideCeil(Size, DistanceFieldBrickSize)));
+		DistanceFieldVolumeData = PreviousCache->VolumeData;
+		if (bKeepCache)
+		{
+			DistanceFieldCache = PreviousCache;
 		}
+		return;
+	}
+
+	TArray<float> Distances;
+	TArray<FVector> SurfacePositions;
+	FIntVector SizeVector(HighResSize);
+	
+	FVoxelDistanceFieldUtilities::GetSurfacePositionsFromDensities(SizeVector, Values, Distances, SurfacePositions);
+	FVoxelDistanceFieldUtilities::DownSample(SizeVector, Distances, SurfacePositions, Divisor, false);
+
+	ensure(SizeVector.X == Size);
+
+	FIntVector ChangedMin(MAX_int32);
+	FIntVector ChangedMax(MIN_int32);
+	if (PreviousCache.IsValid())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Find Changed Densities");
 		
-		TArray<float> Distances;
-		TArray<FVector> SurfacePositions;
-		FIntVector SizeVector(HighResSize);
+		for (int32 X = 0; X < ValuesSize; X++)
+		{
+			for (int32 Y = 0; Y < ValuesSize; Y++)
+			{
+				for (int32 Z = 0; Z < ValuesSize; Z++)
+				{
+					const int32 Index = FVoxelUtilities::Get3DIndex(FIntVector(ValuesSize), X, Y, Z);
+#if ONE_BIT_VOXEL_VALUE
+					if (bool(Values[Index]) != bool(PreviousCache->Values[Index]))
+#else
+					if (Values[Index] != PreviousCache->Values[Index])
+#endif
+					{
+						ChangedMin = FVoxelUtilities::ComponentMin(ChangedMin, FIntVector(X, Y, Z));
+						ChangedMax = FVoxelUtilities::ComponentMax(ChangedMax, FIntVector(X, Y, Z));
+					}
+				}
+			}
+		}
+
+		// The values are different, so this should have found a change. If not, do a full rebuild
+		if (!ensure(ChangedMin.X != MAX_int32))
+		{
+			PreviousCache.Reset();
+		}
+	}
+
+	if (PreviousCache.IsValid())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Incremental Jump Flood");
+
+		// The density at D is used by the high res cells D - 2 to D, whose surface positions can be up to one cell away
+		// This is the box containing all the previous and new surface positions that changed, in low res cells
+		const FVector ChangedSurfaceMin = FVector(ChangedMin - FIntVector(3)) / Divisor;
+		const FVector ChangedSurfaceMax = FVector(ChangedMax + FIntVector(1)) / Divisor;
+
+		const FIntVector SizeVector3(Size);
+		const int32 NumBricks = FVoxelUtilities::DivideCeil(Size, DistanceFieldBrickSize);
 		
-		FVoxelDistanceFieldUtilities::GetSurfacePositionsFromDensities(SizeVector, Values, Distances, SurfacePositions);
-		FVoxelDistanceFieldUtilities::DownSample(SizeVector, Distances, SurfacePositions, Divisor, false);
-		FVoxelDistanceFieldUtilities::JumpFlood(SizeVector, SurfacePositions, EVoxelComputeDevice::CPU);
-		FVoxelDistanceFieldUtilities::GetDistancesFromSurfacePositions(SizeVector, SurfacePositions, Distances);
+		// A cell needs to be recomputed if the changes are closer than its previous closest surface position
+		// This includes the cells whose previous closest surface position changed
+		TArray<FIntVector> BricksToUpdate;
+		for (int32 BrickX = 0; BrickX < NumBricks; BrickX++)
+		{
+			for (int32 BrickY = 0; BrickY < NumBricks; BrickY++)
+			{
+				for (int32 BrickZ = 0; BrickZ < NumBricks; BrickZ++)
+				{
+					const FIntVector Brick(BrickX, BrickY, BrickZ);
+					const FIntVector BrickMin = Brick * DistanceFieldBrickSize;
+					const FIntVector BrickMax = FVoxelUtilities::ComponentMin(BrickMin + FIntVector(DistanceFieldBrickSize), SizeVector3) - FIntVector(1);
+
+					// Lower bound of the distance between the brick cells and the changes
+					float SquaredDistanceToChanges = 0.f;
+					for (int32 Axis = 0; Axis < 3; Axis++)
+					{
+						const float Delta = FMath::Max3(ChangedSurfaceMin[Axis] - BrickMax[Axis], BrickMin[Axis] - ChangedSurfaceMax[Axis], 0.f);
+						SquaredDistanceToChanges += Delta * Delta;
+					}
+
+					const auto NeedsUpdate = [&]()
+					{
+						for (int32 X = BrickMin.X; X <= BrickMax.X; X++)
+						{
+							for (int32 Y = BrickMin.Y; Y <= BrickMax.Y; Y++)
+							{
+								for (int32 Z = BrickMin.Z; Z <= BrickMax.Z; Z++)
+								{
+									const FVector PreviousSurfacePosition = FVoxelUtilities::Get3D(PreviousCache->SurfacePositions, SizeVector3, X, Y, Z);
+									if (!FVoxelDistanceFieldUtilities::IsSurfacePositionValid(PreviousSurfacePosition) ||
+										(PreviousSurfacePosition - FVector(X, Y, Z)).SizeSquared() >= SquaredDistanceToChanges)
+									{
+										return true;
+									}
+								}
+							}
+						}
+						return false;
+					};
+					if (NeedsUpdate())
+					{
+						BricksToUpdate.Add(Brick);
+					}
+				}
+			}
+		}
 
-		ensure(SizeVector.X == Size);
+		INC_DWORD_STAT_BY(STAT_VoxelDistanceFieldBricksRecomputed, BricksToUpdate.Num());
+		INC_DWORD_STAT_BY(STAT_VoxelDistanceFieldBricksReused, FMath::Cube(NumBricks) - BricksToUpdate.Num());
 
-		return MoveTemp(Distances);
-	};
+		// The other cells keep their previous closest surface positions, and are used as seeds by the bricks to update
+		TArray<FVector> NewSurfacePositions = PreviousCache->SurfacePositions;
+		for (const FIntVector& Brick : BricksToUpdate)
+		{
+			const FIntVector BrickMin = Brick * DistanceFieldBrickSize;
+			const FIntVector BrickMax = FVoxelUtilities::ComponentMin(BrickMin + FIntVector(DistanceFieldBrickSize), SizeVector3);
+			for (int32 X = BrickMin.X; X < BrickMax.X; X++)
+			{
+				for (int32 Y = BrickMin.Y; Y < BrickMax.Y; Y++)
+				{
+					for (int32 Z = BrickMin.Z; Z < BrickMax.Z; Z++)
+					{
+						FVoxelUtilities::Get3D(NewSurfacePositions, SizeVector3, X, Y, Z) = FVoxelUtilities::Get3D(SurfacePositions, SizeVector3, X, Y, Z);
+					}
+				}
+			}
+		}
+		FVoxelDistanceFieldUtilities::JumpFloodBricks(SizeVector3, NewSurfacePositions, DistanceFieldBrickSize, BricksToUpdate);
 
-	TArray<float> Distances = GetDistanceField();
+		SurfacePositions = MoveTemp(NewSurfacePositions);
+	}
+	else
+	{
+		FVoxelDistanceFieldUtilities::JumpFlood(SizeVector, SurfacePositions, EVoxelComputeDevice::CPU);
+	}
+	
+	FVoxelDistanceFieldUtilities::GetDistancesFromSurfacePositions(SizeVector, SurfacePositions, Distances);
 	
 	float MinVolumeDistance = Distances[0];
 	float MaxVolumeDistance = Distances[0];
@@ -206,9 +381,6 @@ void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FIntVector& Position,
 	
 	const float InvDistanceRange = 1.0f / (MaxVolumeDistance - MinVolumeDistance);
 
-	static const auto CVarEightBit = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.DistanceFieldBuild.EightBit"));
-
-	const bool bEightBitFixedPoint = CVarEightBit->GetValueOnAnyThread() != 0;
 	const int32 FormatSize = bEightBitFixedPoint ? sizeof(uint8) : sizeof(FFloat16);
 
 	TArray<uint8> QuantizedDistanceFieldVolume;
@@ -253,8 +425,6 @@ void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FIntVector& Position,
 	DistanceFieldVolumeData->DistanceMinMax = FVector2D(MinVolumeDistance, MaxVolumeDistance);
 
 	auto& CompressedDistanceFieldVolume = DistanceFieldVolumeData->CompressedDistanceFieldVolume;
-	static const auto CVarCompress = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.DistanceFieldBuild.Compress"));
-	const bool bCompress = CVarCompress->GetValueOnAnyThread() != 0;
 
 	if (bCompress)
 	{
@@ -281,5 +451,21 @@ void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FIntVector& Position,
 	{
 		CompressedDistanceFieldVolume = QuantizedDistanceFieldVolume;
 	}
+
+	if (bKeepCache)
+	{
+		const auto Cache = MakeVoxelShared<FVoxelChunkDistanceFieldCache>();
+		Cache->LOD = LOD;
+		Cache->Position = Position;
+		Cache->Extension = Extension;
+		Cache->Divisor = Divisor;
+		Cache->bEightBitFixedPoint = bEightBitFixedPoint;
+		Cache->bCompress = bCompress;
+		Cache->Values = MoveTemp(Values);
+		Cache->SurfacePositions = MoveTemp(SurfacePositions);
+		Cache->VolumeData = DistanceFieldVolumeData;
+		Cache->UpdateStats();
+		DistanceFieldCache = Cache;
+	}
 #endif
 }
@@ -302,7 +302,8 @@ int32 UVoxelProceduralMeshComponent::AddProcMeshSection(FVoxelProcMeshSectionSet
 
 	ensure(Settings.bSectionVisible || Settings.bEnableCollisions || Settings.bEnableNavmesh);
 	
-	if (Buffers->GetNumIndices() == 0)
+	// Occupancy collision sections have no triangles, only collision cubes
+	if (Buffers->GetNumIndices() == 0 && Buffers->CollisionCubes.Num() == 0)
 	{
 		return -1;
 	}
@@ -717,6 +718,7 @@ void UVoxelProceduralMeshComponent::OnComponentDestroyed(bool bDestroyingHierarc
 
 	// Destroy simple collisions
 	SimpleCollisionHandle.Reset();
+	CookedChaosTriMeshes.Reset();
 	
 	// Clear memory
 	ProcMeshSections.Reset();
@@ -822,6 +824,7 @@ void UVoxelProceduralMeshComponent::UpdateCollision()
 	else
 	{
 		SimpleCollisionHandle.Reset();
+		CookedChaosTriMeshes.Reset();
 		FinishCollisionUpdate();
 	}
 
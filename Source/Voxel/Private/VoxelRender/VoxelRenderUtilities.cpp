@@ -201,6 +201,9 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 		{
 			ProcMeshBuffers.Guids.Add(ChunkBuffers.Guid);
 
+			// Occupancy collision chunks only have cubes
+			NumCollisionCubes += ChunkBuffers.CollisionCubes.Num();
+
 			// Else wrong NumTextureCoordinates gets assigned
 			// Only part of the buffers can be empty; having all of them empty is invalid
 			if (ChunkBuffers.GetNumVertices() == 0) return;
@@ -223,7 +226,6 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 			}
 
 			NumTextureData += ChunkBuffers.TextureData.Num();
-			NumCollisionCubes += ChunkBuffers.CollisionCubes.Num();
 		};
 
 		if (Section.MainChunk.IsValid() && bShowMainChunks)
@@ -236,7 +238,12 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 		}
 	}
 	ensure(NumAdjacencyIndices == 4 * NumIndices || NumAdjacencyIndices == 0); // If false, then some chunks have tessellation enabled and some others don't
-	if (!ensure(NumVertices > 0)) return {};
+	if (NumVertices == 0 && NumCollisionCubes > 0)
+	{
+		ensure(NumTextureCoordinates == -1);
+		NumTextureCoordinates = 0;
+	}
+	if (!ensure(NumVertices > 0 || NumCollisionCubes > 0)) return {};
 	if (!ensure(NumTextureCoordinates >= 0)) return {};
 	
 	auto& PositionBuffer = ProcMeshBuffers.VertexBuffers.PositionVertexBuffer;
@@ -461,6 +468,10 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 	{
 		PositionBuffer.VertexPosition(Index) *= RendererSettings.VoxelSize;
 	}
+	for (FBox& Cube : CollisionCubes)
+	{
+		Cube = Cube.TransformBy(FScaleMatrix(RendererSettings.VoxelSize));
+	}
 	
 	ProcMeshBuffers.LocalBounds = ProcMeshBuffers.LocalBounds.TransformBy(FScaleMatrix(RendererSettings.VoxelSize)).ExpandBy(RendererSettings.BoundsExtension);
 
@@ -60,6 +60,8 @@ void FVoxelRuntimeSettings::SetFromRuntime(const AVoxelRuntimeActor& InRuntime)
 	SET(MinLOD);
 	SET(InvokerDistanceThreshold);
 	SET(MinDelayBetweenLODUpdates);
+	SET(LODHysteresis);
+	SET(MinChunkLifetime);
 	SET(bConstantLOD);
 
 	SET(MaterialConfig);
@@ -123,6 +125,7 @@ void FVoxelRuntimeSettings::SetFromRuntime(const AVoxelRuntimeActor& InRuntime)
 	SET(VisibleChunksCollisionsMaxLOD);
 	SET(bSimpleCubicCollision);
 	SET(SimpleCubicCollisionLODBias);
+	SET(bOccupancyCollision);
 	SET(NumConvexHullsPerAxis);
 	SET(bCleanCollisionMeshes);
 
@@ -133,6 +136,7 @@ void FVoxelRuntimeSettings::SetFromRuntime(const AVoxelRuntimeActor& InRuntime)
 	SET(PriorityCategories);
 	SET(PriorityOffsets);
 	SET(MeshUpdatesBudget);
+	SET(EditMeshUpdatesBudget);
 	SET(EventsTickRate);
 	SET(DataOctreeInitialSubdivisionDepth);
 
@@ -154,6 +158,7 @@ void FVoxelRuntimeSettings::ConfigurePreview()
 	ProcMeshClass = nullptr;
 	bCreateMaterialInstances = false;
 	MeshUpdatesBudget = 1000;
+	EditMeshUpdatesBudget = 1000;
 	bStaticWorld = false;
 	bConstantLOD = false;
 
@@ -210,12 +215,31 @@ void FVoxelRuntimeSettings::Fixup()
 	{
 		bSimpleCubicCollision = false;
 	}
+	if (bRenderWorld || 
+		bEnableNavmesh || // Navmesh needs triangles
+		CollisionTraceFlag == CTF_UseComplexAsSimple)
+	{
+		bOccupancyCollision = false;
+	}
+	if (bOccupancyCollision)
+	{
+		// Occupancy collisions are only made of cubes
+		bSimpleCubicCollision = true;
+		// Nothing is rendered
+		MaxDistanceFieldLOD = -1;
+	}
 
 	FVoxelUtilities::FixupChunkSize(RenderOctreeChunkSize, MESHER_CHUNK_SIZE);
 	RenderOctreeDepth = FMath::Max(1, FVoxelUtilities::ClampDepth(RenderOctreeChunkSize, RenderOctreeDepth));
 	
 	MeshUpdatesBudget = FMath::Max(0.001f, MeshUpdatesBudget);
+	EditMeshUpdatesBudget = FMath::Max(0.001f, EditMeshUpdatesBudget);
 	RenderSharpness = FMath::Max(0, RenderSharpness);
+	for (float& Hysteresis : LODHysteresis)
+	{
+		Hysteresis = FMath::Max(0.f, Hysteresis);
+	}
+	MinChunkLifetime = FMath::Max(0.f, MinChunkLifetime);
 	MergedChunksClusterSize = FMath::RoundUpToPowerOfTwo(FMath::Max(MergedChunksClusterSize, 2));
 	SimpleCubicCollisionLODBias = FMath::Clamp(SimpleCubicCollisionLODBias, 0, 4);
 	TexturePoolTextureSize = FMath::Clamp(TexturePoolTextureSize, 128, 16384);
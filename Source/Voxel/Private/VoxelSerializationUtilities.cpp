@@ -15,7 +15,8 @@ void FVoxelSerializationUtilities::CompressData(
 	const uint8* const UncompressedData, 
 	const int64 UncompressedDataNum, 
 	TArray<uint8>& OutCompressedData,
-	EVoxelCompressionLevel::Type InCompressionLevel)
+	EVoxelCompressionLevel::Type InCompressionLevel,
+	bool bLog)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
@@ -119,6 +120,11 @@ void FVoxelSerializationUtilities::CompressData(
 	const double CompressedSizeMB = double(TotalCompressedSize) / double(1 << 20);
 
 	const double TotalTime = TotalEndTime - TotalStartTime;
+
+	if (!bLog)
+	{
+		return;
+	}
 	
 	LOG_VOXEL(Log, TEXT("Compressed %f MB in %fs (%f MB/s). Compressed Size: %f MB (%f%%). Compression: %fs (%f%%). Num Chunks: %d."), 
 		UncompressedSizeMB, 
@@ -137,33 +143,33 @@ void FVoxelSerializationUtilities::CompressData(FLargeMemoryWriter& Uncompressed
 	CompressData(UncompressedData.GetData(), UncompressedData.Tell(), CompressedData, CompressionLevel);
 }
 
-bool FVoxelSerializationUtilities::DecompressData(const TArray<uint8>& CompressedData, TArray64<uint8>& UncompressedData)
+bool FVoxelSerializationUtilities::DecompressData(const uint8* CompressedData, int64 CompressedDataNum, TArray64<uint8>& UncompressedData, bool bLog)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
 	const double TotalStartTime = FPlatformTime::Seconds();
 	
-	if (CompressedData.Num() == 0)
+	if (CompressedDataNum == 0 || !ensure(CompressedData))
 	{
 		UncompressedData.Empty();
 		return false;
 	}
 
 	int32 Flag;
-	FMemory::Memcpy(&Flag, CompressedData.GetData(), sizeof(Flag));
+	FMemory::Memcpy(&Flag, CompressedData, sizeof(Flag));
 
 	if (Flag == -1)
 	{
 		// New 64 bit archive
 
-		if (!ensure(CompressedData.Num() >= sizeof(FHeader)))
+		if (!ensure(CompressedDataNum >= sizeof(FHeader)))
 		{
 			UncompressedData.Empty();
 			return false;
 		}
 		
 		FHeader Header;
-		FMemory::Memcpy(&Header, CompressedData.GetData(), sizeof(FHeader));
+		FMemory::Memcpy(&Header, CompressedData, sizeof(FHeader));
 
 		check(Header.LegacyFlag == -1);
 		if (!ensureMsgf(Header.Magic == FHeader().Magic, TEXT("Magic was %x"), Header.Magic))
@@ -172,7 +178,7 @@ bool FVoxelSerializationUtilities::DecompressData(const TArray<uint8>& Compresse
 			return false;
 		}
 		
-		if (!ensureMsgf(Header.CompressedSize == CompressedData.Num() - sizeof(FHeader), TEXT("Archive is saying its size is %lld, but it's %lld"), Header.CompressedSize, CompressedData.Num() - sizeof(FHeader)))
+		if (!ensureMsgf(Header.CompressedSize == CompressedDataNum - sizeof(FHeader), TEXT("Archive is saying its size is %lld, but it's %lld"), Header.CompressedSize, CompressedDataNum - sizeof(FHeader)))
 		{
 			UncompressedData.Empty();
 			return false;
@@ -208,7 +214,7 @@ bool FVoxelSerializationUtilities::DecompressData(const TArray<uint8>& Compresse
 			const double StartTime = FPlatformTime::Seconds();
 			const auto Result = uncompress(
 				UncompressedData.GetData() + TotalUncompressedSize, &UncompressedSize, 
-				CompressedData.GetData() + sizeof(FHeader) + TotalCompressedSize, ChunkCompressedSize);
+				CompressedData + sizeof(FHeader) + TotalCompressedSize, ChunkCompressedSize);
 			const double EndTime = FPlatformTime::Seconds();
 
 			if (!ensureMsgf(Result == Z_OK, TEXT("Decompression failed: %d"), Result))
@@ -242,6 +248,11 @@ bool FVoxelSerializationUtilities::DecompressData(const TArray<uint8>& Compresse
 		const double CompressedSizeMB = double(TotalCompressedSize) / double(1 << 20);
 
 		const double TotalTime = TotalEndTime - TotalStartTime;
+
+		if (!bLog)
+		{
+			return true;
+		}
 	
 		LOG_VOXEL(Log, TEXT("Decompressed %f MB in %fs (%f MB/s). Compressed Size: %f MB (%f%%). Decompression: %fs (%f%%). Num Chunks: %d."),
 			UncompressedSizeMB,
@@ -257,13 +268,13 @@ bool FVoxelSerializationUtilities::DecompressData(const TArray<uint8>& Compresse
 	}
 	else
 	{
-		const ECompressionFlags CompressionFlags = ECompressionFlags(CompressedData.Last());
+		const ECompressionFlags CompressionFlags = ECompressionFlags(CompressedData[CompressedDataNum - 1]);
 
 		int32 UncompressedSize;
-		FMemory::Memcpy(&UncompressedSize, CompressedData.GetData(), sizeof(UncompressedSize));
+		FMemory::Memcpy(&UncompressedSize, CompressedData, sizeof(UncompressedSize));
 		UncompressedData.SetNum(UncompressedSize);
-		const uint8* CompressionStart = CompressedData.GetData() + sizeof(UncompressedSize);
-		const int32 CompressionSize = CompressedData.Num() - 1 - sizeof(UncompressedSize);
+		const uint8* CompressionStart = CompressedData + sizeof(UncompressedSize);
+		const int32 CompressionSize = CompressedDataNum - 1 - sizeof(UncompressedSize);
 
 		bool bSuccess = false;
 		ECompressionFlags NewCompressionFlags = (ECompressionFlags)(CompressionFlags & COMPRESS_OptionsFlagsMask);
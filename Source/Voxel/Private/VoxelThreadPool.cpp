@@ -25,6 +25,13 @@ TAutoConsoleVariable<int32> CVarVoxelThreadingNumThreads(
 	TEXT("The number of threads to use to process voxel tasks"),
 	ECVF_Default);
 
+TAutoConsoleVariable<int32> CVarVoxelThreadingNumEditThreads(
+	TEXT("voxel.threading.NumEditThreads"),
+	1,
+	TEXT("The number of additional threads reserved to low latency tasks (meshing of edited chunks). ")
+	TEXT("These threads never process background tasks. If 0, low latency tasks are only prioritized over other tasks"),
+	ECVF_Default);
+
 TAutoConsoleVariable<int32> CVarVoxelThreadingThreadPriority(
 	TEXT("voxel.threading.ThreadPriority"),
 	2,
@@ -61,8 +68,9 @@ static FAutoConsoleCommand CmdClearThreadPoolStats(
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-FVoxelThread::FVoxelThread(FVoxelThreadPool& Pool, const FString& ThreadName, uint32 StackSize, EThreadPriority ThreadPriority)
-	: ThreadName(ThreadName)
+FVoxelThread::FVoxelThread(FVoxelThreadPool& Pool, const FString& ThreadName, uint32 StackSize, EThreadPriority ThreadPriority, bool bIsEditThread)
+	: bIsEditThread(bIsEditThread)
+	, ThreadName(ThreadName)
 	, ThreadPool(Pool)
 	, Event(*FPlatformProcess::GetSynchEventFromPool())
 	, TimeToDie(false)
@@ -172,16 +180,23 @@ void FVoxelThreadPool::AbandonAllTasks()
 		FVoxelScopeLockWithStats Lock(CriticalSection);
 
 		// Clean up all queued objects
+		for (auto& WorkInfo : QueuedLowLatencyWorks)
+		{
+			AbandonWork(*WorkInfo.Work);
+		}
 		for (auto& WorkInfo : QueuedWorks)
 		{
 			AbandonWork(*WorkInfo.Work);
 		}
+		QueuedLowLatencyWorks.Reset();
 		QueuedWorks.Reset();
+		QueuedEditThreads.Reset();
 		QueuedThreads.Reset();
 
 		// Wait for all threads to finish up
 		// Safe because the thread destructor will wait on the runnable
 		// Due to IsAbandoningAllTasks, they can't pick another job either
+		AllEditThreads.Reset();
 		AllThreads.Reset();
 	}
 	check(IsAbandoningAllTasks);
@@ -192,7 +207,7 @@ void FVoxelThreadPool::AbandonAllTasks()
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-TUniquePtr<FVoxelThread> FVoxelThreadPool::CreateThread()
+TUniquePtr<FVoxelThread> FVoxelThreadPool::CreateThread(bool bIsEditThread)
 {
 #if VOXEL_ENGINE_VERSION < 426
 	TRACE_THREAD_GROUP_SCOPE("VoxelThreadPool");
@@ -205,8 +220,29 @@ TUniquePtr<FVoxelThread> FVoxelThreadPool::CreateThread()
 #endif
 
 	static int32 ThreadIndex = 0;
-	const FString Name = FString::Printf(TEXT("Voxel Thread %d"), ThreadIndex++);
-	return MakeUnique<FVoxelThread>(*this, Name, 1024 * 1024, EThreadPriority(FMath::Clamp(CVarVoxelThreadingThreadPriority.GetValueOnGameThread(), 0, 6)));
+	static int32 EditThreadIndex = 0;
+	const FString Name =
+		bIsEditThread
+		? FString::Printf(TEXT("Voxel Edit Thread %d"), EditThreadIndex++)
+		: FString::Printf(TEXT("Voxel Thread %d"), ThreadIndex++);
+	return MakeUnique<FVoxelThread>(*this, Name, 1024 * 1024, EThreadPriority(FMath::Clamp(CVarVoxelThreadingThreadPriority.GetValueOnGameThread(), 0, 6)), bIsEditThread);
+}
+
+void FVoxelThreadPool::WakeupThreads(TArray<TUniquePtr<FVoxelThread>>& Threads, TArray<FVoxelThread*>& SleepingThreads, int32 WantedActiveThreads, bool bIsEditThread)
+{
+	while (Threads.Num() - SleepingThreads.Num() < WantedActiveThreads)
+	{
+		if (SleepingThreads.Num() > 0)
+		{
+			auto* Thread = SleepingThreads.Pop(false);
+			Thread->Wakeup();
+		}
+		else
+		{
+			auto& Thread = Threads.Emplace_GetRef(CreateThread(bIsEditThread));
+			Thread->Wakeup();
+		}
+	}
 }
 
 void FVoxelThreadPool::AbandonWork(IVoxelQueuedWork& Work)
@@ -248,36 +284,55 @@ IVoxelQueuedWork* FVoxelThreadPool::ReturnToPoolOrGetNextJob(FVoxelThread* InQue
 		RecomputePriorities_AssumeLocked();
 	}
 
-	if (QueuedWorks.Num() > 0)
+	// Low latency works are always processed first, by any thread
+	auto& Works =
+		QueuedLowLatencyWorks.Num() > 0 || InQueuedThread->bIsEditThread
+		? QueuedLowLatencyWorks
+		: QueuedWorks;
+	
+	if (Works.Num() > 0)
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("HeapPop");
 		FQueuedWorkInfo WorkInfo;
-		QueuedWorks.HeapPop(WorkInfo, false);
+		Works.HeapPop(WorkInfo, false);
 		WorkInfo.Work->CheckIsValidLowLevel();
 		return WorkInfo.Work;
 	}
 
 	// Sleep thread
-	QueuedThreads.Add(InQueuedThread);
+	if (InQueuedThread->bIsEditThread)
+	{
+		QueuedEditThreads.Add(InQueuedThread);
+	}
+	else
+	{
+		QueuedThreads.Add(InQueuedThread);
+	}
 	return nullptr;
 }
 
 void FVoxelThreadPool::RecomputePriorities_AssumeLocked()
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	RecomputePriorities_AssumeLocked(QueuedLowLatencyWorks);
+	RecomputePriorities_AssumeLocked(QueuedWorks);
+}
 
+void FVoxelThreadPool::RecomputePriorities_AssumeLocked(TArray<FQueuedWorkInfo>& Works)
+{
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("Recompute priorities");
 
-		for (int32 Index = 0; Index < QueuedWorks.Num(); Index++)
+		for (int32 Index = 0; Index < Works.Num(); Index++)
 		{
-			FQueuedWorkInfo& WorkInfo = QueuedWorks.GetData()[Index];
+			FQueuedWorkInfo& WorkInfo = Works.GetData()[Index];
 			WorkInfo.Work->CheckIsValidLowLevel();
 			
 			if (WorkInfo.Work->ShouldAbandon())
 			{
 				AbandonWork(*WorkInfo.Work);
-				QueuedWorks.RemoveAtSwap(Index, 1, false);
+				Works.RemoveAtSwap(Index, 1, false);
 				Index--;
 				continue;
 			}
@@ -291,7 +346,7 @@ void FVoxelThreadPool::RecomputePriorities_AssumeLocked()
 
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("Heapify");
-		QueuedWorks.Heapify();
+		Works.Heapify();
 	}
 }
 
@@ -775,6 +775,7 @@ bool UVoxelBlueprintLibrary::IsVoxelWorldMeshLoading(AVoxelWorld* World)
 		PoolCounters.GetNumTasksForType(EVoxelTaskType::CollisionsChunksMeshing) > 0 ||
 		PoolCounters.GetNumTasksForType(EVoxelTaskType::VisibleChunksMeshing) > 0 ||
 		PoolCounters.GetNumTasksForType(EVoxelTaskType::VisibleCollisionsChunksMeshing) > 0 ||
+		PoolCounters.GetNumTasksForType(EVoxelTaskType::EditChunksMeshing) > 0 ||
 		PoolCounters.GetNumTasksForType(EVoxelTaskType::CollisionCooking) > 0 ||
 		PoolCounters.GetNumTasksForType(EVoxelTaskType::MeshMerge) > 0 ||
 		PoolCounters.GetNumTasksForType(EVoxelTaskType::RenderOctree) > 0;
@@ -283,15 +283,39 @@ void UVoxelDataTools::RoundVoxelsImpl(FVoxelData& Data, const FVoxelIntBox& Boun
 	FVoxelMutableDataAccelerator OctreeAccelerator(Data, Bounds.Extend(2));
 	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
 	{
-		if (Leaf.GetData<FVoxelValue>().IsDirty() && Leaf.GetData<FVoxelValue>().HasAllocation())
+		auto& DataHolder = Leaf.GetData<FVoxelValue>();
+		if (DataHolder.IsDirty() && DataHolder.HasAllocation())
 		{
 			SlowTask.EnterProgressFrame();
 			
 			const FVoxelIntBox LeafBounds = Leaf.GetBounds();
+
+			// Skip leaves that are already rounded without querying their neighbors
+			bool bHasValuesToRound = false;
+			for (int32 Index = 0; Index < VOXELS_PER_DATA_CHUNK && !bHasValuesToRound; Index++)
+			{
+				const FVoxelValue Value = DataHolder.Get(Index);
+				bHasValuesToRound = !Value.IsTotallyEmpty() && !Value.IsTotallyFull();
+			}
+			if (!bHasValuesToRound)
+			{
+				return;
+			}
+
+			// Query the neighbors once for the entire leaf. Rounding doesn't change the sign of the values, so the result is the same
+			const FVoxelIntBox NeighborsBounds = LeafBounds.Extend(2);
+			const FIntVector NeighborsSize = NeighborsBounds.Size();
+			const TArray<FVoxelValue> NeighborsValues = FVoxelDataUtilities::GetValuesUsingRanges(Data, NeighborsBounds);
+			const auto GetNeighborValue = [&](int32 X, int32 Y, int32 Z)
+			{
+				const int32 Index = FVoxelUtilities::Get3DIndex(NeighborsSize, X, Y, Z, NeighborsBounds.Min);
+				return FVoxelUtilities::Get(NeighborsValues, Index);
+			};
+			
 			LeafBounds.Iterate([&](int32 X, int32 Y, int32 Z)
 			{
 				const FVoxelCellIndex Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(LeafBounds.Min, X, Y, Z);
-				const FVoxelValue& Value = Leaf.GetData<FVoxelValue>().Get(Index);
+				const FVoxelValue& Value = DataHolder.Get(Index);
 						
 				if (Value.IsTotallyEmpty() || Value.IsTotallyFull()) return;
 				
@@ -303,7 +327,7 @@ void UVoxelDataTools::RoundVoxelsImpl(FVoxelData& Data, const FVoxelIntBox& Boun
 						for (int32 OtherZ = Z - 2; OtherZ <= Z + 2; OtherZ++)
 						{
 							if (OtherX == X && OtherY == Y && OtherZ == Z) continue;
-							const auto OtherValue = OctreeAccelerator.GetValue(OtherX, OtherY, OtherZ, 0);
+							const auto OtherValue = GetNeighborValue(OtherX, OtherY, OtherZ);
 							if (OtherValue.IsEmpty() != bEmpty) return;
 						}
 					}
@@ -429,14 +453,37 @@ void UVoxelDataTools::GetVoxelsValueAndMaterialImpl(
 	const TArray<FIntVector>& Positions)
 {
 	VOXEL_TOOL_FUNCTION_COUNTER(Positions.Num());
+	
+	// If the positions are dense enough, find the chunks with a single value to not query their values one by one
+	TMap<FIntVector, FVoxelValue> SingleValueChunks;
+	if (Bounds.Count() <= uint64(Positions.Num()) * VOXELS_PER_DATA_CHUNK)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Find single value chunks");
+		FVoxelDataUtilities::IterateValueRangesInBounds(Data, Bounds, [&](const FVoxelIntBox& Block, const TVoxelRange<FVoxelValue>& Range)
+		{
+			if (!Range.IsSingleValue())
+			{
+				return;
+			}
+			
+			// Blocks are aligned on chunks & clamped to Bounds, so all the positions in these chunks are in Block
+			Block.MakeMultipleOfBigger(DATA_CHUNK_SIZE).Iterate(DATA_CHUNK_SIZE, [&](int32 X, int32 Y, int32 Z)
+			{
+				SingleValueChunks.Add(FIntVector(X, Y, Z) / DATA_CHUNK_SIZE, Range.GetSingleValue());
+			});
+		});
+	}
+	
 	const FVoxelMutableDataAccelerator OctreeAccelerator(Data, Bounds);
 	for (auto& Position : Positions)
 	{
 		if (Data.IsInWorld(Position))
 		{
+			const FVoxelValue* SingleValue = SingleValueChunks.Num() > 0 ? SingleValueChunks.Find(FVoxelUtilities::DivideFloor(Position, DATA_CHUNK_SIZE)) : nullptr;
+			
 			FVoxelValueMaterial Voxel;
 			Voxel.Position = Position;
-			Voxel.Value = OctreeAccelerator.GetValue(Position, 0).ToFloat();
+			Voxel.Value = (SingleValue ? *SingleValue : OctreeAccelerator.GetValue(Position, 0)).ToFloat();
 			Voxel.Material = OctreeAccelerator.GetMaterial(Position, 0);
 			Voxels.Add(Voxel);
 		}
@@ -669,6 +716,8 @@ void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightma
 	FVoxelScopedSlowTask LocalSlowTask(LeavesColumns.Num(), VOXEL_LOCTEXT("Finding heights"));
 
 	FVoxelMutableDataAccelerator Accelerator(Data, FVoxelIntBox::Infinite);
+	// Heights are written chunk by chunk: only lock once per heightmap tile
+	typename TVoxelHeightmapAssetSamplerWrapper<T>::FWriter Writer(*Wrapper.Data);
 	for (auto& ColumnsIt : LeavesColumns)
 	{
 		LocalSlowTask.EnterProgressFrame();
@@ -807,7 +856,7 @@ void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightma
 				const FIntPoint HeightmapPosition = GetHeightmapPosition(X, Y);
 				if (!IsInBounds(HeightmapPosition)) continue;
 
-				Wrapper.SetHeight(HeightmapPosition.X, HeightmapPosition.Y, NewHeights[X + DATA_CHUNK_SIZE * Y]);
+				Wrapper.SetHeight(Writer, HeightmapPosition.X, HeightmapPosition.Y, NewHeights[X + DATA_CHUNK_SIZE * Y]);
 			}
 		}
 	}
@@ -0,0 +1,234 @@
+// Copyright 2021 Phyronnaz
+
+#include "VoxelTools/VoxelEditBatcher.h"
+#include "VoxelTools/VoxelToolHelpers.h"
+#include "VoxelRender/IVoxelLODManager.h"
+#include "VoxelData/VoxelData.h"
+#include "VoxelPool.h"
+
+static TAutoConsoleVariable<float> CVarBatchedEditsMergeFactor(
+	TEXT("voxel.tools.BatchedEditsMergeFactor"),
+	2.f,
+	TEXT("Two non-overlapping batches of edits are merged if the volume of their union is less than this times the volume of their edits"),
+	ECVF_Default);
+
+DEFINE_VOXEL_SUBSYSTEM_PROXY(UVoxelEditBatcherSubsystemProxy);
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+class FVoxelEditBatchWork : public IVoxelQueuedWork
+{
+public:
+	const TVoxelWeakPtr<FVoxelEditBatcher> Batcher;
+	const TVoxelWeakPtr<FVoxelData> Data;
+	const EVoxelLockType LockType;
+	const FVoxelIntBox Bounds;
+	const TArray<FVoxelLatentActionAsyncWork*> Works;
+	const TArray<FVoxelIntBox> BoundsToUpdate;
+
+	FVoxelEditBatchWork(
+		const TVoxelWeakPtr<FVoxelEditBatcher>& Batcher,
+		const TVoxelWeakPtr<FVoxelData>& Data,
+		EVoxelLockType LockType,
+		const FVoxelIntBox& Bounds,
+		TArray<FVoxelLatentActionAsyncWork*>&& Works,
+		TArray<FVoxelIntBox>&& BoundsToUpdate)
+		: IVoxelQueuedWork(STATIC_FNAME("Batched Edits"), EVoxelTaskType::AsyncEditFunctions, EPriority::Null)
+		, Batcher(Batcher)
+		, Data(Data)
+		, LockType(LockType)
+		, Bounds(Bounds)
+		, Works(MoveTemp(Works))
+		, BoundsToUpdate(MoveTemp(BoundsToUpdate))
+	{
+	}
+
+	virtual void DoThreadedWork() override
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		const auto PinnedData = Data.Pin();
+		if (!PinnedData.IsValid())
+		{
+			Abandon();
+			return;
+		}
+
+		{
+			VOXEL_SCOPE_COUNTER_FORMAT("%d edits", Works.Num());
+
+			auto LockInfo = PinnedData->Lock(LockType, Bounds, Name);
+			for (FVoxelLatentActionAsyncWork* Work : Works)
+			{
+				// Note: Work might be deleted by the game thread right after this
+				Work->DoThreadedWork();
+			}
+			PinnedData->Unlock(MoveTemp(LockInfo));
+		}
+
+		const auto PinnedBatcher = Batcher.Pin();
+		if (PinnedBatcher.IsValid())
+		{
+			for (const FVoxelIntBox& BoundsToUpdateIt : BoundsToUpdate)
+			{
+				PinnedBatcher->BoundsToUpdate.Enqueue(BoundsToUpdateIt);
+			}
+		}
+
+		delete this;
+	}
+	virtual void Abandon() override
+	{
+		for (FVoxelLatentActionAsyncWork* Work : Works)
+		{
+			Work->Abandon();
+		}
+
+		delete this;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelEditBatcher::Destroy()
+{
+	Super::Destroy();
+
+	StopTicking();
+
+	for (const FQueuedEdit& Edit : QueuedEdits)
+	{
+		Edit.Work->Abandon();
+	}
+	QueuedEdits.Empty();
+}
+
+void FVoxelEditBatcher::QueueEdit(FVoxelLatentActionAsyncWork& Work, EVoxelLockType LockType, const FVoxelIntBox& Bounds, EVoxelUpdateRender UpdateRender)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	if (!ensure(IsTicking()))
+	{
+		Work.Abandon();
+		return;
+	}
+
+	FQueuedEdit Edit;
+	Edit.Work = &Work;
+	Edit.LockType = LockType;
+	Edit.Bounds = Bounds;
+	Edit.bUpdateRender = UpdateRender == EVoxelUpdateRender::UpdateRender;
+	QueuedEdits.Add(Edit);
+}
+
+void FVoxelEditBatcher::Flush()
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	if (QueuedEdits.Num() == 0)
+	{
+		return;
+	}
+
+	struct FBatch
+	{
+		EVoxelLockType LockType;
+		FVoxelIntBox Bounds;
+		uint64 EditsVolume = 0;
+		TArray<int32> Edits;
+	};
+	TArray<FBatch> Batches;
+
+	const float MergeFactor = CVarBatchedEditsMergeFactor.GetValueOnGameThread();
+
+	for (int32 EditIndex = 0; EditIndex < QueuedEdits.Num(); EditIndex++)
+	{
+		const FQueuedEdit& Edit = QueuedEdits[EditIndex];
+
+		FBatch NewBatch;
+		NewBatch.LockType = Edit.LockType;
+		NewBatch.Bounds = Edit.Bounds;
+		NewBatch.EditsVolume = Edit.Bounds.Count();
+		NewBatch.Edits.Add(EditIndex);
+
+		// Overlapping batches are always merged, so that edits on the same voxels are run in order
+		// Overlapping read & write batches are merged too, the result being a write batch
+		bool bMerged;
+		do
+		{
+			bMerged = false;
+			for (int32 BatchIndex = Batches.Num() - 1; BatchIndex >= 0; BatchIndex--)
+			{
+				FBatch& Batch = Batches[BatchIndex];
+
+				const FVoxelIntBox Union = Batch.Bounds.Union(NewBatch.Bounds);
+				if (!Batch.Bounds.Intersect(NewBatch.Bounds) &&
+					(Batch.LockType != NewBatch.LockType || Union.Count() > MergeFactor * (Batch.EditsVolume + NewBatch.EditsVolume)))
+				{
+					continue;
+				}
+
+				if (Batch.LockType != NewBatch.LockType)
+				{
+					NewBatch.LockType = EVoxelLockType::Write;
+				}
+				NewBatch.Bounds = Union;
+				NewBatch.EditsVolume += Batch.EditsVolume;
+				NewBatch.Edits.Append(Batch.Edits);
+				Batches.RemoveAtSwap(BatchIndex);
+				bMerged = true;
+			}
+		}
+		while (bMerged);
+
+		NewBatch.Edits.Sort();
+		Batches.Add(MoveTemp(NewBatch));
+	}
+
+	FVoxelPool& Pool = GetSubsystemChecked<FVoxelPool>();
+	const TVoxelWeakPtr<FVoxelData> Data = GetSubsystemChecked<FVoxelData>().AsShared();
+
+	for (FBatch& Batch : Batches)
+	{
+		TArray<FVoxelLatentActionAsyncWork*> Works;
+		TArray<FVoxelIntBox> BatchBoundsToUpdate;
+		for (const int32 EditIndex : Batch.Edits)
+		{
+			const FQueuedEdit& Edit = QueuedEdits[EditIndex];
+			Works.Add(Edit.Work);
+			if (Edit.bUpdateRender)
+			{
+				BatchBoundsToUpdate.Add(Edit.Bounds);
+			}
+		}
+
+		Pool.QueueTask(new FVoxelEditBatchWork(AsShared(), Data, Batch.LockType, Batch.Bounds, MoveTemp(Works), MoveTemp(BatchBoundsToUpdate)));
+	}
+
+	QueuedEdits.Reset();
+}
+
+void FVoxelEditBatcher::Tick(float DeltaTime)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Flush();
+
+	TArray<FVoxelIntBox> BoundsToUpdateArray;
+	FVoxelIntBox Bounds;
+	while (BoundsToUpdate.Dequeue(Bounds))
+	{
+		BoundsToUpdateArray.Add(Bounds);
+	}
+
+	if (BoundsToUpdateArray.Num() > 0)
+	{
+		GetSubsystemChecked<IVoxelLODManager>().UpdateBounds(BoundsToUpdateArray);
+	}
+}
@@ -3,8 +3,11 @@
 #include "VoxelTools/VoxelProjectionTools.h"
 #include "VoxelTools/VoxelToolHelpers.h"
 #include "VoxelData/VoxelDataAccelerator.h"
+#include "VoxelData/VoxelDataLock.h"
+#include "VoxelData/VoxelDataUtilities.inl"
 
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
 #include "Engine/Engine.h"
 
 struct FHitsBuilder
@@ -30,7 +33,10 @@ struct FHitsBuilder
 
 	inline void Add(AVoxelWorld* World, const FHitResult& Hit, const FVector2D& PlanePosition)
 	{
-		const FVoxelVector LocalPosition = World->GlobalToLocalFloat(Hit.ImpactPoint);
+		Add(World->GlobalToLocalFloat(Hit.ImpactPoint), Hit, PlanePosition);
+	}
+	inline void Add(const FVoxelVector& LocalPosition, const FHitResult& Hit, const FVector2D& PlanePosition)
+	{
 		for (auto& Point : FVoxelUtilities::GetNeighbors(LocalPosition))
 		{
 			const float DistanceSquared = (Point - LocalPosition).SizeSquared();
@@ -182,6 +188,322 @@ public:
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+struct FVoxelMarchedRay
+{
+	FVector Start;
+	FVector End;
+	FVoxelVector LocalStart;
+	FVoxelVector LocalEnd;
+	FVector2D PlanePosition;
+};
+
+class FVoxelRayMarcher
+{
+public:
+	const FVoxelData& Data;
+
+	explicit FVoxelRayMarcher(const FVoxelData& Data)
+		: Data(Data)
+	{
+	}
+
+	// Must not be called under a lock: data chunks are read locked one by one as the ray advances,
+	// so that a long ray doesn't block edits & meshers along it
+	// Time is between 0 and 1, relative to Start & End
+	bool March(const FVoxelVector& Start, const FVoxelVector& End, v_flt& OutTime, FVoxelVector& OutPosition, FVoxelVector& OutNormal)
+	{
+		v_flt MinTime = 0;
+		v_flt MaxTime = 1;
+		if (!ClipToWorld(Start, End - Start, MinTime, MaxTime))
+		{
+			return false;
+		}
+
+		// March the clipped segment, to keep the steps precise when MaxDistance is big
+		const FVoxelVector ClippedStart = Start + (End - Start) * MinTime;
+		const FVoxelVector Delta = (End - Start) * (MaxTime - MinTime);
+
+		bool bHasPreviousValue = false;
+		v_flt PreviousTime = 0;
+		v_flt PreviousValue = 0;
+
+		const bool bHit = IterateCells(ClippedStart, Delta, 0, 1, DATA_CHUNK_SIZE, [&](const FIntVector& Chunk, v_flt ChunkEnterTime, v_flt ChunkExitTime)
+		{
+			// Extend by 2: 1 for the interpolation, 1 for the gradient
+			const FVoxelIntBox LockedBounds = FVoxelIntBox(Chunk * DATA_CHUNK_SIZE, (Chunk + 1) * DATA_CHUNK_SIZE).Extend(2);
+			FVoxelReadScopeLock Lock(Data, LockedBounds, STATIC_FNAME("Ray Marching"));
+
+			// Accelerators cache octree leaves, which can be deleted once unlocked: use a new one for every chunk
+			const FVoxelConstDataAccelerator Accelerator(Data);
+			const auto GetValue = [&](v_flt Time)
+			{
+				return Accelerator.GetFloatValue(ClippedStart + Delta * Time, 0);
+			};
+
+			if (!bHasPreviousValue)
+			{
+				bHasPreviousValue = true;
+				PreviousTime = ChunkEnterTime;
+				PreviousValue = GetValue(ChunkEnterTime);
+			}
+
+			// Computed under this lock: a state kept from a previous pass could be outdated by an edit made since
+			const EChunkState State = GetChunkState(Chunk);
+			if (State != EChunkState::Surface)
+			{
+				// Nothing to hit in there: skip the whole chunk, but keep the real value at its boundary
+				// so that a crossing just after it is refined from actual values
+				PreviousTime = ChunkExitTime;
+				PreviousValue = GetValue(ChunkExitTime);
+				return false;
+			}
+
+			const bool bChunkHit = IterateCells(ClippedStart, Delta, ChunkEnterTime, ChunkExitTime, 1, [&](const FIntVector& Cell, v_flt CellEnterTime, v_flt CellExitTime)
+			{
+				const v_flt Value = GetValue(CellExitTime);
+				if (PreviousValue > 0 && Value <= 0)
+				{
+					OutTime = FindSurface(GetValue, PreviousTime, PreviousValue, CellExitTime, Value);
+					return true;
+				}
+				PreviousTime = CellExitTime;
+				PreviousValue = Value;
+				return false;
+			});
+
+			if (bChunkHit)
+			{
+				// Still locked
+				OutPosition = ClippedStart + Delta * OutTime;
+				OutNormal = FVoxelDataUtilities::GetGradientFromGetFloatValue<v_flt>(Accelerator, OutPosition.X, OutPosition.Y, OutPosition.Z, 0, 1);
+			}
+			return bChunkHit;
+		});
+
+		if (!bHit)
+		{
+			return false;
+		}
+
+		OutTime = MinTime + OutTime * (MaxTime - MinTime);
+		return true;
+	}
+
+private:
+	enum class EChunkState : uint8
+	{
+		Empty,
+		Full,
+		Surface
+	};
+
+	// Chunk must be locked
+	EChunkState GetChunkState(const FIntVector& Chunk) const
+	{
+		// Values are interpolated: also include the next voxels
+		const FVoxelIntBox Bounds = FVoxelIntBox(Chunk * DATA_CHUNK_SIZE, (Chunk + 1) * DATA_CHUNK_SIZE).Extend(1);
+		const TVoxelRange<FVoxelValue> Range = Data.GetValueRange(Bounds, 0);
+
+		if (Range.Min.IsEmpty() != Range.Max.IsEmpty())
+		{
+			return EChunkState::Surface;
+		}
+		else
+		{
+			return Range.Min.IsEmpty() ? EChunkState::Empty : EChunkState::Full;
+		}
+	}
+
+	bool ClipToWorld(const FVoxelVector& Start, const FVoxelVector& Delta, v_flt& MinTime, v_flt& MaxTime) const
+	{
+		const FVoxelVector WorldMin = FVoxelVector(Data.WorldBounds.Min);
+		const FVoxelVector WorldMax = FVoxelVector(Data.WorldBounds.Max - 1);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			if (Delta[Axis] == 0)
+			{
+				if (Start[Axis] < WorldMin[Axis] || Start[Axis] > WorldMax[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			v_flt TimeA = (WorldMin[Axis] - Start[Axis]) / Delta[Axis];
+			v_flt TimeB = (WorldMax[Axis] - Start[Axis]) / Delta[Axis];
+			if (TimeA > TimeB)
+			{
+				Swap(TimeA, TimeB);
+			}
+			MinTime = FMath::Max(MinTime, TimeA);
+			MaxTime = FMath::Min(MaxTime, TimeB);
+		}
+
+		return MinTime <= MaxTime;
+	}
+
+	// DDA over the cells of size CellSize crossed by the ray between MinTime and MaxTime
+	// Lambda(Cell, EnterTime, ExitTime) returns true to stop the iteration
+	template<typename T>
+	static bool IterateCells(const FVoxelVector& Start, const FVoxelVector& Delta, v_flt MinTime, v_flt MaxTime, int32 CellSize, T Lambda)
+	{
+		const FVoxelVector StartPosition = Start + Delta * MinTime;
+
+		FIntVector Cell;
+		FIntVector Step;
+		FVoxelVector NextTime;
+		FVoxelVector TimeStep;
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			Cell[Axis] = FMath::FloorToInt(StartPosition[Axis] / CellSize);
+
+			if (Delta[Axis] > 0)
+			{
+				Step[Axis] = 1;
+				NextTime[Axis] = ((Cell[Axis] + 1) * CellSize - Start[Axis]) / Delta[Axis];
+				TimeStep[Axis] = CellSize / Delta[Axis];
+			}
+			else if (Delta[Axis] < 0)
+			{
+				Step[Axis] = -1;
+				NextTime[Axis] = (Cell[Axis] * CellSize - Start[Axis]) / Delta[Axis];
+				TimeStep[Axis] = -CellSize / Delta[Axis];
+			}
+			else
+			{
+				Step[Axis] = 0;
+				NextTime[Axis] = MAX_flt;
+				TimeStep[Axis] = MAX_flt;
+			}
+		}
+
+		v_flt Time = MinTime;
+		while (Time < MaxTime)
+		{
+			int32 Axis = 0;
+			if (NextTime[1] < NextTime[Axis]) Axis = 1;
+			if (NextTime[2] < NextTime[Axis]) Axis = 2;
+
+			const v_flt ExitTime = FMath::Min(NextTime[Axis], MaxTime);
+			if (Lambda(Cell, Time, ExitTime))
+			{
+				return true;
+			}
+
+			Time = ExitTime;
+			Cell[Axis] += Step[Axis];
+			NextTime[Axis] += TimeStep[Axis];
+		}
+		return false;
+	}
+
+	// Requires ValueA > 0 and ValueB <= 0
+	template<typename T>
+	static v_flt FindSurface(T GetValue, v_flt TimeA, v_flt ValueA, v_flt TimeB, v_flt ValueB)
+	{
+		for (int32 Iteration = 0; Iteration < 8; Iteration++)
+		{
+			const v_flt Time = (TimeA + TimeB) / 2;
+			const v_flt Value = GetValue(Time);
+			if (Value > 0)
+			{
+				TimeA = Time;
+				ValueA = Value;
+			}
+			else
+			{
+				TimeB = Time;
+				ValueB = Value;
+			}
+		}
+		return FMath::Lerp(TimeA, TimeB, ValueA / (ValueA - ValueB));
+	}
+};
+
+// The hits actors are left null, as this can run on any thread: see SetRayMarchingHitsActor
+static TArray<FVoxelProjectionHit> FindProjectionVoxelsByRayMarchingImpl(
+	const FVoxelData& Data,
+	const FVoxelTransform& Transform,
+	v_flt VoxelSize,
+	const TArray<FVoxelMarchedRay>& Rays)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	constexpr int32 RaysPerBatch = 64;
+	const int32 NumBatches = FVoxelUtilities::DivideCeil(Rays.Num(), RaysPerBatch);
+
+	struct FMarchedHit
+	{
+		int32 RayIndex;
+		FVoxelVector Position;
+		FVoxelVector Normal;
+		v_flt Time;
+	};
+	TArray<TArray<FMarchedHit>> BatchHits;
+	BatchHits.SetNum(NumBatches);
+
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("March Rays");
+
+		FVoxelRayMarcher Marcher(Data);
+
+		const int32 RayEnd = FMath::Min((BatchIndex + 1) * RaysPerBatch, Rays.Num());
+		for (int32 RayIndex = BatchIndex * RaysPerBatch; RayIndex < RayEnd; RayIndex++)
+		{
+			const FVoxelMarchedRay& Ray = Rays[RayIndex];
+
+			FMarchedHit Hit;
+			Hit.RayIndex = RayIndex;
+			if (Marcher.March(Ray.LocalStart, Ray.LocalEnd, Hit.Time, Hit.Position, Hit.Normal))
+			{
+				BatchHits[BatchIndex].Add(Hit);
+			}
+		}
+	}, NumBatches == 1);
+
+	VOXEL_ASYNC_SCOPE_COUNTER("Build Hits");
+
+	FHitsBuilder Builder;
+	for (const TArray<FMarchedHit>& Hits : BatchHits)
+	{
+		for (const FMarchedHit& MarchedHit : Hits)
+		{
+			const FVoxelMarchedRay& Ray = Rays[MarchedHit.RayIndex];
+
+			const FVector Location = Transform.TransformPosition(MarchedHit.Position * VoxelSize);
+			const FVector Normal = FVector(Transform.TransformVector(MarchedHit.Normal)).GetSafeNormal();
+
+			FHitResult Hit(ForceInit);
+			Hit.Location = Hit.ImpactPoint = Location;
+			Hit.Normal = Hit.ImpactNormal = Normal;
+			Hit.Time = MarchedHit.Time;
+			Hit.Distance = FVector::Distance(Ray.Start, Location);
+			Hit.TraceStart = Ray.Start;
+			Hit.TraceEnd = Ray.End;
+			Hit.bBlockingHit = true;
+
+			Builder.Add(MarchedHit.Position, Hit, Ray.PlanePosition);
+		}
+	}
+	return Builder.GetHits();
+}
+
+static void SetRayMarchingHitsActor(TArray<FVoxelProjectionHit>& Hits, AVoxelWorld* World)
+{
+	check(IsInGameThread());
+	
+	for (FVoxelProjectionHit& Hit : Hits)
+	{
+		Hit.Hit.UE_5_SWITCH(Actor, HitObjectHandle) = World;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 FCollisionQueryParams FVoxelLineTraceParameters::GetParams() const
 {
 	FCollisionQueryParams Params(STATIC_FNAME("FindProjectionVoxels"), SCENE_QUERY_STAT_ONLY(FindProjectionVoxels), true);
@@ -352,6 +674,125 @@ int32 UVoxelProjectionTools::FindProjectionVoxelsAsync(
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+inline TArray<FVoxelMarchedRay> GenerateMarchedRays(
+	AVoxelWorld* World,
+	const FVector& Position,
+	const FVector& Direction,
+	float Radius,
+	EVoxelProjectionShape Shape,
+	float NumRays,
+	float MaxDistance)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	TArray<FVoxelMarchedRay> Rays;
+	Rays.Reserve(FMath::Max(0, FMath::CeilToInt(NumRays * 1.5f)));
+
+	UVoxelProjectionTools::GenerateRays(Position, Direction, Radius, Shape, NumRays, MaxDistance, [&](const FVector& Start, const FVector& End, const FVector2D& PlanePosition)
+	{
+		Rays.Add({ Start, End, World->GlobalToLocalFloat(Start), World->GlobalToLocalFloat(End), PlanePosition });
+	});
+
+	return Rays;
+}
+
+int32 UVoxelProjectionTools::FindProjectionVoxelsByRayMarching(
+	TArray<FVoxelProjectionHit>& Hits,
+	AVoxelWorld* World,
+	FVector Position,
+	FVector Direction,
+	float Radius,
+	EVoxelProjectionShape Shape,
+	float NumRays,
+	float MaxDistance)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Hits.Reset();
+
+	CHECK_VOXELWORLD_IS_CREATED();
+
+	if (!Direction.Normalize())
+	{
+		FVoxelMessages::Error(FUNCTION_ERROR("Invalid Direction!"));
+		return 0;
+	}
+
+	const TArray<FVoxelMarchedRay> Rays = GenerateMarchedRays(World, Position, Direction, Radius, Shape, NumRays, MaxDistance);
+	if (Rays.Num() == 0)
+	{
+		return 0;
+	}
+
+	const FVoxelTransform Transform = World->GetVoxelTransform();
+	const v_flt VoxelSize = World->GetVoxelSize();
+
+	// Not locked: the marcher locks the chunks it goes through
+	const FVoxelData& Data = World->GetSubsystemChecked<FVoxelData>();
+	Hits = FindProjectionVoxelsByRayMarchingImpl(Data, Transform, VoxelSize, Rays);
+	SetRayMarchingHitsActor(Hits, World);
+
+	return Rays.Num();
+}
+
+int32 UVoxelProjectionTools::FindProjectionVoxelsByRayMarchingAsync(
+	UObject* WorldContextObject,
+	FLatentActionInfo LatentInfo,
+	TArray<FVoxelProjectionHit>& Hits,
+	AVoxelWorld* World,
+	FVector Position,
+	FVector Direction,
+	float Radius,
+	EVoxelProjectionShape Shape,
+	float NumRays,
+	float MaxDistance,
+	bool bHideLatentWarnings)
+{
+	VOXEL_FUNCTION_COUNTER();
+	CHECK_VOXELWORLD_IS_CREATED();
+
+	if (!Direction.Normalize())
+	{
+		FVoxelMessages::Error(FUNCTION_ERROR("Invalid Direction!"));
+		return 0;
+	}
+
+	const TArray<FVoxelMarchedRay> Rays = GenerateMarchedRays(World, Position, Direction, Radius, Shape, NumRays, MaxDistance);
+	if (Rays.Num() == 0)
+	{
+		return 0;
+	}
+
+	const FVoxelTransform Transform = World->GetVoxelTransform();
+	const v_flt VoxelSize = World->GetVoxelSize();
+
+	// Not locked: the marcher locks the chunks it goes through
+	FVoxelToolHelpers::StartAsyncLatentAction_WithWorld_WithValue(
+		WorldContextObject,
+		LatentInfo,
+		World,
+		FUNCTION_FNAME,
+		bHideLatentWarnings,
+		Hits,
+		[=](FVoxelData& Data, TArray<FVoxelProjectionHit>& InHits)
+		{
+			InHits = FindProjectionVoxelsByRayMarchingImpl(Data, Transform, VoxelSize, Rays);
+		},
+		EVoxelUpdateRender::DoNotUpdateRender,
+		{},
+		[&Hits, WeakWorld = MakeWeakObjectPtr(World)]()
+		{
+			// Only called if the latent action is still valid, like the assignment of Hits
+			SetRayMarchingHitsActor(Hits, WeakWorld.Get());
+		});
+
+	return Rays.Num();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 TArray<FIntVector> UVoxelProjectionTools::GetHitsPositions(const TArray<FVoxelProjectionHit>& Hits)
 {
 	VOXEL_FUNCTION_COUNTER();
@@ -5,6 +5,7 @@
 #include "VoxelTools/VoxelHardnessHandler.h"
 #include "VoxelTools/VoxelSurfaceToolsImpl.h"
 #include "VoxelData/VoxelDataAccelerator.h"
+#include "VoxelData/VoxelDataUtilities.inl"
 #include "VoxelUtilities/VoxelRichCurveUtilities.h"
 #include "VoxelUtilities/VoxelDistanceFieldUtilities.h"
 #include "VoxelUtilities/VoxelMiscUtilities.h"
@@ -79,74 +80,141 @@ FVoxelSurfaceEditsVoxels UVoxelSurfaceTools::FindSurfaceVoxelsImpl(
 		bool bOnlyOutputNonEmptyVoxels_Dynamic)
 {
 	VOXEL_TOOL_FUNCTION_COUNTER(Bounds.Count());
+
+	FVoxelSurfaceEditsVoxels EditsVoxels;
+	EditsVoxels.Info.bHasValues = true;
+	EditsVoxels.Info.bHasNormals = bComputeNormals_Dynamic;
 	
 	const FIntVector Size = Bounds.Size();
+	if (Size.X < 3 || Size.Y < 3 || Size.Z < 3)
+	{
+		return EditsVoxels;
+	}
 
-	const TArray<FVoxelValue> Values = Data.GetValues(Bounds);
-	
-	const auto GetValue = [&](int32 X, int32 Y, int32 Z)
+	// Border voxels are only used as neighbors
+	const FVoxelIntBox InnerBounds = Bounds.Extend(-1);
+
+	// Split in blocks aligned on the data chunks, so that single value leaves & generator ranges can be skipped
+	TArray<FVoxelIntBox> Blocks;
 	{
-		checkVoxelSlow(0 <= X && X < Size.X);
-		checkVoxelSlow(0 <= Y && Y < Size.Y);
-		checkVoxelSlow(0 <= Z && Z < Size.Z);
-		const int32 Index = X + Y * Size.X + Z * Size.X * Size.Y;
-		return Values.GetData()[Index];
-	};
+		VOXEL_ASYNC_SCOPE_COUNTER("Subdivide");
+		InnerBounds.Subdivide(DATA_CHUNK_SIZE, Blocks);
+		for (FVoxelIntBox& Block : Blocks)
+		{
+			Block = Block.Overlap(InnerBounds);
+		}
+	}
 
-	TArray<FVoxelSurfaceEditsVoxelBase> OutVoxels;
-	OutVoxels.Reserve(Bounds.Count());
+	// One output per block: peak memory scales with the surface, not the volume
+	TArray<TArray<FVoxelSurfaceEditsVoxelBase>> BlocksVoxels;
+	BlocksVoxels.SetNum(Blocks.Num());
 
 	FVoxelUtilities::StaticBranch(bComputeNormals_Dynamic, bOnlyOutputNonEmptyVoxels_Dynamic, [&](auto bComputeNormals_Static, auto bOnlyOutputNonEmptyVoxels_Static)
 	{
-		for (int32 X = 1; X < Size.X - 1; X++)
+		ParallelFor(Blocks.Num(), [&](int32 BlockIndex)
 		{
-			for (int32 Y = 1; Y < Size.Y - 1; Y++)
+			const FVoxelIntBox& Block = Blocks[BlockIndex];
+			const FVoxelIntBox BlockWithNeighbors = Block.Extend(1);
+			
+			// If all the values have the same sign there can't be any surface voxel
+			// Values outside of the world are clamped by Get, so only trust the range inside it
+			if (Data.WorldBounds.Contains(BlockWithNeighbors) && Data.IsEmpty(BlockWithNeighbors, 0))
+			{
+				return;
+			}
+			
+			const FIntVector BlockSize = BlockWithNeighbors.Size();
+			const TArray<FVoxelValue> Values = Data.Get<FVoxelValue>(BlockWithNeighbors);
+			
+			const auto GetValue = [&](int32 X, int32 Y, int32 Z)
 			{
-				for (int32 Z = 1; Z < Size.Z - 1; Z++)
+				checkVoxelSlow(0 <= X && X < BlockSize.X);
+				checkVoxelSlow(0 <= Y && Y < BlockSize.Y);
+				checkVoxelSlow(0 <= Z && Z < BlockSize.Z);
+				const int32 Index = X + Y * BlockSize.X + Z * BlockSize.X * BlockSize.Y;
+				return Values.GetData()[Index];
+			};
+
+			TArray<FVoxelSurfaceEditsVoxelBase>& OutVoxels = BlocksVoxels[BlockIndex];
+			
+			for (int32 X = 1; X < BlockSize.X - 1; X++)
+			{
+				for (int32 Y = 1; Y < BlockSize.Y - 1; Y++)
 				{
-					const FVoxelValue Value = GetValue(X, Y, Z);
-					if (bOnlyOutputNonEmptyVoxels_Static && Value.IsEmpty())
-					{
-						continue;
-					}
-					
-					bool bAdd = false;
-					const auto GetOtherValue = [&](uint8 Direction, int32 DX, int32 DY, int32 DZ)
+					for (int32 Z = 1; Z < BlockSize.Z - 1; Z++)
 					{
-						const FVoxelValue OtherValue = GetValue(X + DX, Y + DY, Z + DZ);
-						if (!DirectionMask || (!Value.IsEmpty() && (Direction & DirectionMask)))
+						const FVoxelValue Value = GetValue(X, Y, Z);
+						if (bOnlyOutputNonEmptyVoxels_Static && Value.IsEmpty())
 						{
-							bAdd |= Value.IsEmpty() != OtherValue.IsEmpty();
+							continue;
 						}
-						return OtherValue.ToFloat();
-					};
-					
-					// Note: if bComputeNormals = false, could be faster by not computing other values once bAdd = true
-					const float GradientX = GetOtherValue(EVoxelDirectionFlag::XMax, 1, 0, 0) - GetOtherValue(EVoxelDirectionFlag::XMin, -1, 0, 0);
-					const float GradientY = GetOtherValue(EVoxelDirectionFlag::YMax, 0, 1, 0) - GetOtherValue(EVoxelDirectionFlag::YMin, 0, -1, 0);
-					const float GradientZ = GetOtherValue(EVoxelDirectionFlag::ZMax, 0, 0, 1) - GetOtherValue(EVoxelDirectionFlag::ZMin, 0, 0, -1);
-
-					if (bAdd)
-					{
+						
+						const auto IsSurface = [&](uint8 Direction, const FVoxelValue& OtherValue)
+						{
+							if (!DirectionMask || (!Value.IsEmpty() && (Direction & DirectionMask)))
+							{
+								return Value.IsEmpty() != OtherValue.IsEmpty();
+							}
+							return false;
+						};
+
+						const FVoxelValue ValueXMax = GetValue(X + 1, Y, Z);
+						const FVoxelValue ValueXMin = GetValue(X - 1, Y, Z);
+						const FVoxelValue ValueYMax = GetValue(X, Y + 1, Z);
+						const FVoxelValue ValueYMin = GetValue(X, Y - 1, Z);
+						const FVoxelValue ValueZMax = GetValue(X, Y, Z + 1);
+						const FVoxelValue ValueZMin = GetValue(X, Y, Z - 1);
+
+						// Bitwise or: no branches, all the neighbors are already loaded
+						const bool bAdd =
+							IsSurface(EVoxelDirectionFlag::XMax, ValueXMax) |
+							IsSurface(EVoxelDirectionFlag::XMin, ValueXMin) |
+							IsSurface(EVoxelDirectionFlag::YMax, ValueYMax) |
+							IsSurface(EVoxelDirectionFlag::YMin, ValueYMin) |
+							IsSurface(EVoxelDirectionFlag::ZMax, ValueZMax) |
+							IsSurface(EVoxelDirectionFlag::ZMin, ValueZMin);
+
+						if (!bAdd)
+						{
+							continue;
+						}
+
+						// Only compute the gradient for surface voxels
 						FVector Normal;
 						if (bComputeNormals_Static)
 						{
-							Normal = FVector(GradientX, GradientY, GradientZ).GetSafeNormal();
+							Normal = FVector(
+								ValueXMax.ToFloat() - ValueXMin.ToFloat(),
+								ValueYMax.ToFloat() - ValueYMin.ToFloat(),
+								ValueZMax.ToFloat() - ValueZMin.ToFloat()).GetSafeNormal();
 						}
 						else
 						{
 							Normal = FVector(ForceInit);
 						}
-						OutVoxels.Add({ Bounds.Min + FIntVector(X, Y, Z), Normal, Value.ToFloat() });
+						OutVoxels.Add({ BlockWithNeighbors.Min + FIntVector(X, Y, Z), Normal, Value.ToFloat() });
 					}
 				}
 			}
-		}
+		}, Blocks.Num() == 1);
 	});
 
-	FVoxelSurfaceEditsVoxels EditsVoxels;
-	EditsVoxels.Info.bHasValues = true;
-	EditsVoxels.Info.bHasNormals = bComputeNormals_Dynamic;
+	TArray<FVoxelSurfaceEditsVoxelBase> OutVoxels;
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Merge");
+		
+		int32 Num = 0;
+		for (auto& BlockVoxels : BlocksVoxels)
+		{
+			Num += BlockVoxels.Num();
+		}
+		
+		OutVoxels.Reserve(Num);
+		for (auto& BlockVoxels : BlocksVoxels)
+		{
+			OutVoxels.Append(MoveTemp(BlockVoxels));
+		}
+	}
 
 	EditsVoxels.Voxels = MakeVoxelSharedCopy(MoveTemp(OutVoxels));
 	
@@ -175,7 +243,8 @@ FVoxelSurfaceEditsVoxels UVoxelSurfaceTools::FindSurfaceVoxelsFromDistanceFieldI
 	
 	const FIntVector Size = Bounds.Size();
 
-	const TArray<FVoxelValue> Values = Data.ParallelGet<FVoxelValue>(Bounds.Extend(1), !bMultiThreaded);
+	// Uniform blocks are filled directly, only querying the generator near the surface & in edited leaves
+	const TArray<FVoxelValue> Values = FVoxelDataUtilities::GetValuesUsingRanges(Data, Bounds.Extend(1), bMultiThreaded);
 
 	TArray<float> Distances;
 	TArray<FVector> SurfacePositions;
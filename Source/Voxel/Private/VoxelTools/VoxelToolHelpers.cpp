@@ -1,12 +1,19 @@
 // Copyright 2021 Phyronnaz
 
 #include "VoxelTools/VoxelToolHelpers.h"
+#include "VoxelTools/VoxelEditBatcher.h"
 #include "VoxelRender/IVoxelLODManager.h"
 #include "VoxelPool.h"
 
 #include "Engine/Engine.h"
 #include "Async/Async.h"
 
+static TAutoConsoleVariable<int32> CVarBatchLatentEdits(
+	TEXT("voxel.tools.BatchLatentEdits"),
+	0,
+	TEXT("If true, latent voxel tools will be merged with the other edits of the frame, using a single lock and render update per batch"),
+	ECVF_Default);
+
 FVoxelLatentActionAsyncWork::FVoxelLatentActionAsyncWork(FName Name)
 	: FVoxelAsyncWorkWithWait(Name, EVoxelTaskType::AsyncEditFunctions, EPriority::Null)
 {
@@ -27,12 +34,32 @@ FVoxelLatentActionAsyncWork_WithWorld::FVoxelLatentActionAsyncWork_WithWorld(
 {
 }
 
+void FVoxelLatentActionAsyncWork_WithWorld::SetLock(EVoxelLockType InLockType, const FVoxelIntBox& InBounds)
+{
+	LockType = InLockType;
+	LockBounds = InBounds;
+}
+
+void FVoxelLatentActionAsyncWork_WithWorld::SetBatcher(const TVoxelSharedRef<FVoxelEditBatcher>& InBatcher)
+{
+	Batcher = InBatcher;
+}
+
 void FVoxelLatentActionAsyncWork_WithWorld::DoWork()
 {
 	const auto PinnedData = Data.Pin();
 	if (PinnedData.IsValid())
 	{
-		Function(*PinnedData);
+		if (LockBounds.IsSet())
+		{
+			auto LockInfo = PinnedData->Lock(LockType, LockBounds.GetValue(), Name);
+			Function(*PinnedData);
+			PinnedData->Unlock(MoveTemp(LockInfo));
+		}
+		else
+		{
+			Function(*PinnedData);
+		}
 	}
 }
 
@@ -41,6 +68,16 @@ bool FVoxelLatentActionAsyncWork_WithWorld::IsValid() const
 	return World.IsValid() && Data.IsValid();
 }
 
+void FVoxelLatentActionAsyncWork_WithWorld::PrepareForWait()
+{
+	// Else we would wait for the end of the frame forever
+	const auto PinnedBatcher = Batcher.Pin();
+	if (PinnedBatcher.IsValid())
+	{
+		PinnedBatcher->Flush();
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -85,6 +122,26 @@ void FVoxelToolHelpers::StartAsyncEditTask(AVoxelWorld* World, IVoxelQueuedWork*
 	}
 }
 
+bool FVoxelToolHelpers::StartLockedAsyncEditTask(AVoxelWorld* World, FVoxelLatentActionAsyncWork_WithWorld& Work, EVoxelLockType LockType, const FVoxelIntBox& Bounds, EVoxelUpdateRender UpdateRender)
+{
+	check(World);
+	
+	if (CVarBatchLatentEdits.GetValueOnGameThread())
+	{
+		const auto Batcher = World->GetSubsystem<FVoxelEditBatcher>();
+		if (Batcher.IsValid())
+		{
+			Work.SetBatcher(Batcher.ToSharedRef());
+			Batcher->QueueEdit(Work, LockType, Bounds, UpdateRender);
+			return true;
+		}
+	}
+
+	Work.SetLock(LockType, Bounds);
+	StartAsyncEditTask(World, &Work);
+	return false;
+}
+
 float FVoxelToolHelpers::GetRealDistance(AVoxelWorld* World, float Distance, bool bConvertToVoxelSpace)
 {
 	if (bConvertToVoxelSpace)
@@ -188,6 +245,30 @@ bool FVoxelToolHelpers::StartAsyncLatentAction_WithWorld(
 		});
 }
 
+bool FVoxelToolHelpers::StartLockedAsyncLatentAction_WithWorld(
+	UObject* WorldContextObject, 
+	FLatentActionInfo LatentInfo, 
+	AVoxelWorld* World, 
+	FName Name, 
+	bool bHideLatentWarnings, 
+	TFunction<void(FVoxelData&)> DoWork, 
+	EVoxelLockType LockType,
+	EVoxelUpdateRender UpdateRender, 
+	const FVoxelIntBox& Bounds)
+{
+	return StartLockedAsyncLatentActionImpl<FVoxelLatentActionAsyncWork_WithWorld>(
+		WorldContextObject,
+		LatentInfo,
+		World,
+		Name,
+		bHideLatentWarnings,
+		LockType,
+		UpdateRender,
+		Bounds,
+		[&]() { return new FVoxelLatentActionAsyncWork_WithWorld(Name, World, DoWork); },
+		[](auto&) {});
+}
+
 bool FVoxelToolHelpers::StartAsyncLatentAction_WithoutWorld(
 	UObject* WorldContextObject, 
 	FLatentActionInfo LatentInfo, 
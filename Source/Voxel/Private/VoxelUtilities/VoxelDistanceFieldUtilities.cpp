@@ -23,6 +23,47 @@ FColor FVoxelDistanceFieldUtilities::GetDistanceFieldColor(float Value)
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+FORCEINLINE FVector FVoxelDistanceFieldUtilities::JumpFloodCell_CPU(const FIntVector& Size, TArrayView<const FVector> InData, const FIntVector& Position, int32 Step)
+{
+	float BestDistance = MAX_flt;
+	FVector BestSurfacePosition = MakeInvalidSurfacePosition();
+
+	for (int32 DX = -1; DX <= 1; ++DX)
+	{
+		for (int32 DY = -1; DY <= 1; ++DY)
+		{
+			for (int32 DZ = -1; DZ <= 1; ++DZ)
+			{
+				const FIntVector NeighborPosition = Position + FIntVector(DX, DY, DZ) * Step;
+
+				if (NeighborPosition.X < 0 ||
+					NeighborPosition.Y < 0 ||
+					NeighborPosition.Z < 0 ||
+					NeighborPosition.X >= Size.X ||
+					NeighborPosition.Y >= Size.Y ||
+					NeighborPosition.Z >= Size.Z)
+				{
+					continue;
+				}
+
+				const FVector NeighborSurfacePosition = FVoxelUtilities::Get3D(InData, Size, NeighborPosition);
+
+				if (IsSurfacePositionValid(NeighborSurfacePosition))
+				{
+					const float Distance = (NeighborSurfacePosition - FVector(Position)).SizeSquared();
+					if (Distance < BestDistance)
+					{
+						BestDistance = Distance;
+						BestSurfacePosition = NeighborSurfacePosition;
+					}
+				}
+			}
+		}
+	}
+
+	return BestSurfacePosition;
+}
+
 void FVoxelDistanceFieldUtilities::JumpFlood(const FIntVector& Size, TArray<FVector>& InOutSurfacePositions, EVoxelComputeDevice Device, bool bMultiThreaded, int32 MaxPasses_Debug)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
@@ -74,6 +115,57 @@ void FVoxelDistanceFieldUtilities::JumpFlood(const FIntVector& Size, TArray<FVec
 	}
 }
 
+void FVoxelDistanceFieldUtilities::JumpFloodBricks(const FIntVector& Size, TArray<FVector>& InOutSurfacePositions, int32 BrickSize, TArrayView<const FIntVector> Bricks)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	check(BrickSize > 0);
+	check(InOutSurfacePositions.Num() == Size.X * Size.Y * Size.Z);
+
+	if (Bricks.Num() == 0)
+	{
+		return;
+	}
+
+	// Cells outside of the bricks are never written, so they must be valid in both buffers
+	TArray<FVector> Temp = InOutSurfacePositions;
+	bool bUseTempAsSrc = false;
+	
+	const int32 PowerOfTwo = FMath::CeilLogTwo(Size.GetMax());
+	for (int32 Pass = 0; Pass < PowerOfTwo; Pass++)
+	{
+		// -1: we want to start with half the size
+		const int32 Step = 1 << (PowerOfTwo - 1 - Pass);
+
+		const TArray<FVector>& InData = bUseTempAsSrc ? Temp : InOutSurfacePositions;
+		TArray<FVector>& OutData = bUseTempAsSrc ? InOutSurfacePositions : Temp;
+
+		for (const FIntVector& Brick : Bricks)
+		{
+			const FIntVector Min = Brick * BrickSize;
+			const FIntVector Max = FVoxelUtilities::ComponentMin(Min + FIntVector(BrickSize), Size);
+			for (int32 X = Min.X; X < Max.X; X++)
+			{
+				for (int32 Y = Min.Y; Y < Max.Y; Y++)
+				{
+					for (int32 Z = Min.Z; Z < Max.Z; Z++)
+					{
+						const FIntVector Position(X, Y, Z);
+						FVoxelUtilities::Get3D(OutData, Size, Position) = JumpFloodCell_CPU(Size, InData, Position, Step);
+					}
+				}
+			}
+		}
+
+		bUseTempAsSrc = !bUseTempAsSrc;
+	}
+
+	if (bUseTempAsSrc)
+	{
+		InOutSurfacePositions = MoveTemp(Temp);
+	}
+}
+
 void FVoxelDistanceFieldUtilities::GetDistancesFromSurfacePositions(const FIntVector& Size, TArrayView<const FVector> SurfacePositions, TArrayView<float> InOutDistances)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
@@ -235,43 +327,7 @@ void FVoxelDistanceFieldUtilities::JumpFloodStep_CPU(const FIntVector& Size, TAr
 			for (int32 Z = 0; Z < Size.Z; Z++)
 			{
 				const FIntVector Position(X, Y, Z);
-
-				float BestDistance = MAX_flt;
-				FVector BestSurfacePosition = MakeInvalidSurfacePosition();
-
-				for (int32 DX = -1; DX <= 1; ++DX)
-				{
-					for (int32 DY = -1; DY <= 1; ++DY)
-					{
-						for (int32 DZ = -1; DZ <= 1; ++DZ)
-						{
-							const FIntVector NeighborPosition = Position + FIntVector(DX, DY, DZ) * Step;
-
-							if (NeighborPosition.X < 0 ||
-								NeighborPosition.Y < 0 ||
-								NeighborPosition.Z < 0 ||
-								NeighborPosition.X >= Size.X ||
-								NeighborPosition.Y >= Size.Y ||
-								NeighborPosition.Z >= Size.Z)
-							{
-								continue;
-							}
-
-							const FVector NeighborSurfacePosition = FVoxelUtilities::Get3D(InData, Size, NeighborPosition);
-
-							if (IsSurfacePositionValid(NeighborSurfacePosition))
-							{
-								const float Distance = (NeighborSurfacePosition - FVector(Position)).SizeSquared();
-								if (Distance < BestDistance)
-								{
-									BestDistance = Distance;
-									BestSurfacePosition = NeighborSurfacePosition;
-								}
-							}
-						}
-					}
-				}
-				FVoxelUtilities::Get3D(OutData, Size, Position) = BestSurfacePosition;
+				FVoxelUtilities::Get3D(OutData, Size, Position) = JumpFloodCell_CPU(Size, InData, Position, Step);
 			}
 		}
 	};
@@ -85,6 +85,29 @@ public:
 	void SetFractalOctavesAndGain(int32 Octaves, v_flt NewGain) { Gain = NewGain; CalculateFractalBounding(Octaves); }
 	v_flt GetFractalGain() const { return Gain; }
 
+	// Number of octaves that can be represented when sampling every 1 << LOD voxels:
+	// octaves whose frequency is above the Nyquist limit of the step are dropped
+	// InputScale is the size of a voxel in the noise input coordinates, eg 1 if the noise samples X Y Z directly
+	// If the scale isn't known (InputScale <= 0), eg for normalized positions, no octave is dropped
+	// Returns Octaves at LOD 0. Only truncates, so the fractal bounding of the full noise is kept and far LODs stay close to LOD 0
+	FORCEINLINE int32 GetLODOctaves(int32 Octaves, v_flt Frequency, v_flt InputScale, int32 LOD) const
+	{
+		if (LOD <= 0 || Lacunarity <= 1 || InputScale <= 0)
+		{
+			return Octaves;
+		}
+
+		// Frequency in cycles per sample
+		v_flt SampleFrequency = FMath::Abs(Frequency) * InputScale * v_flt(1 << FMath::Min(LOD, 30));
+		int32 NumOctaves = 1;
+		while (NumOctaves < Octaves && SampleFrequency * Lacunarity <= v_flt(0.5))
+		{
+			SampleFrequency *= Lacunarity;
+			NumOctaves++;
+		}
+		return NumOctaves;
+	}
+
 	// Sets method for combining octaves in all fractal noise types
 	// Default: FBM
 	void SetFractalType(EVoxelNoiseFractalType NewFractalType) { FractalType = NewFractalType; }
@@ -95,16 +95,25 @@ public:
 	//~ Begin UVoxelGenerator Interface
 	virtual TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance() override;
 	virtual TVoxelSharedRef<FVoxelTransformableGeneratorInstance> GetTransformableInstance() override final;
+	virtual bool CanShareInstances() const override { return true; }
 	//~ End UVoxelGenerator Interface
 
 public:
+	// The data with all its slabs loaded
 	TVoxelSharedRef<const FVoxelDataAssetData> GetData();
 	void SetData(const TVoxelSharedRef<FVoxelDataAssetData>& InData);
 
+	// Compress data as a slab payload for SetCompressedData. Thread safe: lets importers compress several assets in parallel
+	static void CompressData(FVoxelDataAssetData& InData, TArray<uint8>& OutCompressedData);
+	// Same as SetData, with InCompressedData computed by CompressData
+	// If bKeepDataLoaded is false, InData is released and will only be decompressed when the asset is used
+	void SetCompressedData(const TVoxelSharedRef<FVoxelDataAssetData>& InData, TArray<uint8>&& InCompressedData, bool bKeepDataLoaded);
+
 	TVoxelSharedRef<FVoxelDataAssetInstance> GetInstanceImpl();
 
 protected:
 	void Save();
+	void SaveCompressedData(TArray<uint8>&& InCompressedData);
 	void Load();
 
 	void TryLoad();
@@ -126,7 +135,8 @@ private:
 	UPROPERTY()
 	uint32 MaterialConfigFlag;
 
-	TArray<uint8> CompressedData;
+	// Shared with the data lazily loading its slabs from it: must be replaced, not modified
+	TVoxelSharedRef<TArray<uint8>> CompressedData = MakeVoxelShared<TArray<uint8>>();
 
 private:
 #if WITH_EDITORONLY_DATA
@@ -9,6 +9,7 @@
 class AVoxelWorld;
 class UTexture2D;
 class FVoxelDataAssetInstance;
+struct FVoxelDataAssetSlabs;
 
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Data Assets Memory"), STAT_VoxelDataAssetMemory, STATGROUP_VoxelMemory, VOXEL_API);
 
@@ -31,6 +32,7 @@ namespace FVoxelDataAssetDataVersion
 		SHARED_AddUserFlagsToSaves,
 		SHARED_StoreSpawnerMatricesRelativeToComponent,
 		SHARED_StoreMaterialChannelsIndividuallyAndRemoveFoliage,
+		SlabPayload,
 		
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
@@ -40,14 +42,9 @@ namespace FVoxelDataAssetDataVersion
 
 struct VOXEL_API FVoxelDataAssetData
 {
-	FVoxelDataAssetData()
-	{
-		Values.Add(FVoxelValue::Empty());
-	}
-	~FVoxelDataAssetData()
-	{
-		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelDataAssetMemory, AllocatedSize);
-	}
+	FVoxelDataAssetData();
+	~FVoxelDataAssetData();
+	UE_NONCOPYABLE(FVoxelDataAssetData);
 
 public:
 	FORCEINLINE FIntVector GetSize() const
@@ -119,12 +116,39 @@ public:
 	FVoxelMaterial GetMaterial(T X, T Y, T Z) const = delete;
 
 	float GetInterpolatedValue(float X, float Y, float Z, FVoxelValue DefaultValue, float Tolerance = 0.0001f) const;
+	// Same as GetInterpolatedValue at Start + Delta * Index, for Index in [0, Num)
+	// Rows entirely inside the asset gather the 8 corners without bound checks
+	void GetInterpolatedValues(const FVector& Start, const FVector& Delta, int32 Num, FVoxelValue DefaultValue, float Tolerance, v_flt* RESTRICT OutValues) const;
 	FVoxelMaterial GetInterpolatedMaterial(float X, float Y, float Z, float Tolerance = 0.0001f) const;
 
 public:
 	void Serialize(FArchive& Ar, uint32 ValueConfigFlag, uint32 MaterialConfigFlag, FVoxelDataAssetDataVersion::Type Version);
 
 public:
+	// Slab payloads store the data as Z slabs compressed independently, so that only the slabs actually queried are decompressed
+	// Each slab is serialized like a small asset: payloads saved with another value/material config can still be loaded
+	void CompressSlabs(TArray<uint8>& OutPayload) const;
+	// Reads the payload header & allocates the data without touching it: the slabs are decompressed by LoadSlabs
+	// The payload is shared, not copied. It must not be modified afterwards
+	bool InitSlabs(const TVoxelSharedRef<const TArray<uint8>>& Payload, uint32 ValueConfigFlag, uint32 MaterialConfigFlag, FVoxelDataAssetDataVersion::Type Version);
+
+	// Must be called before reading voxels between MinZ and MaxZ if the data was created by InitSlabs. Thread safe
+	FORCEINLINE void LoadSlabs(float MinZ, float MaxZ) const
+	{
+		if (FPlatformAtomics::AtomicRead(&NumSlabsToLoad) > 0)
+		{
+			LoadSlabsImpl(FMath::FloorToInt(MinZ), FMath::CeilToInt(MaxZ));
+		}
+	}
+	// Decompress all the remaining slabs in parallel. Thread safe
+	void LoadAllSlabs() const;
+	FORCEINLINE bool AreAllSlabsLoaded() const
+	{
+		return FPlatformAtomics::AtomicRead(&NumSlabsToLoad) == 0;
+	}
+
+public:
+	// The raw arrays are only valid once all the slabs are loaded
 	FVoxelValueArray& GetRawValues()
 	{
 		return Values;
@@ -155,5 +179,10 @@ private:
 	TNoGrowArray<FVoxelMaterial> Materials = { FVoxelMaterial::Default() };
 	mutable int64 AllocatedSize = 0;
 
+	TUniquePtr<FVoxelDataAssetSlabs> Slabs;
+	mutable volatile int32 NumSlabsToLoad = 0;
+
 	void UpdateStats() const;
+	void LoadSlabsImpl(int32 MinZ, int32 MaxZ) const;
+	void LoadSlab(int32 SlabIndex) const;
 };
\ No newline at end of file
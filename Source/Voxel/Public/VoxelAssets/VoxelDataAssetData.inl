@@ -67,6 +67,78 @@ inline float FVoxelDataAssetData::GetInterpolatedValue(float X, float Y, float Z
 		AlphaZ);
 }
 
+inline void FVoxelDataAssetData::GetInterpolatedValues(const FVector& Start, const FVector& Delta, int32 Num, FVoxelValue DefaultValue, float Tolerance, v_flt* RESTRICT OutValues) const
+{
+	if (Num <= 0)
+	{
+		return;
+	}
+
+	const FVector End = Start + Delta * (Num - 1);
+	// The row is a segment: if both its ends are inside, all its samples are
+	if (!IsValidIndex(Start.X, Start.Y, Start.Z) || !IsValidIndex(End.X, End.Y, End.Z))
+	{
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const FVector Position = Start + Delta * Index;
+			OutValues[Index] = GetInterpolatedValue(Position.X, Position.Y, Position.Z, DefaultValue, Tolerance);
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const FVector Position = Start + Delta * Index;
+
+		const int32 RoundedX = FMath::RoundToInt(Position.X);
+		const int32 RoundedY = FMath::RoundToInt(Position.Y);
+		const int32 RoundedZ = FMath::RoundToInt(Position.Z);
+		if (FMath::IsNearlyEqual(Position.X, RoundedX, Tolerance) &&
+			FMath::IsNearlyEqual(Position.Y, RoundedY, Tolerance) &&
+			FMath::IsNearlyEqual(Position.Z, RoundedZ, Tolerance))
+		{
+			OutValues[Index] = GetValueUnsafe(
+				FMath::Clamp(RoundedX, 0, Size.X - 1),
+				FMath::Clamp(RoundedY, 0, Size.Y - 1),
+				FMath::Clamp(RoundedZ, 0, Size.Z - 1)).ToFloat();
+			continue;
+		}
+
+		// Clamp to be safe against rounding errors when stepping close to the borders
+		const int32 MinX = FMath::Clamp(FMath::FloorToInt(Position.X), 0, Size.X - 1);
+		const int32 MinY = FMath::Clamp(FMath::FloorToInt(Position.Y), 0, Size.Y - 1);
+		const int32 MinZ = FMath::Clamp(FMath::FloorToInt(Position.Z), 0, Size.Z - 1);
+
+		// Min + 1 can only be out of bounds when on the border, where its alpha is 0
+		const int32 OffsetX = MinX + 1 < Size.X ? 1 : 0;
+		const int32 OffsetY = MinY + 1 < Size.Y ? Size.X : 0;
+		const int32 OffsetZ = MinZ + 1 < Size.Z ? Size.X * Size.Y : 0;
+
+		const float AlphaX = FMath::Clamp(Position.X - MinX, 0.f, 1.f);
+		const float AlphaY = FMath::Clamp(Position.Y - MinY, 0.f, 1.f);
+		const float AlphaZ = FMath::Clamp(Position.Z - MinZ, 0.f, 1.f);
+
+		const int32 Base = GetIndex(MinX, MinY, MinZ);
+		const auto Get = [&](int32 Offset)
+		{
+			return FVoxelUtilities::Get(Values, Base + Offset).ToFloat();
+		};
+
+		OutValues[Index] = FVoxelUtilities::TrilinearInterpolation<float>(
+			Get(0),
+			Get(OffsetX),
+			Get(OffsetY),
+			Get(OffsetX + OffsetY),
+			Get(OffsetZ),
+			Get(OffsetX + OffsetZ),
+			Get(OffsetY + OffsetZ),
+			Get(OffsetX + OffsetY + OffsetZ),
+			AlphaX,
+			AlphaY,
+			AlphaZ);
+	}
+}
+
 inline FVoxelMaterial FVoxelDataAssetData::GetInterpolatedMaterial(float X, float Y, float Z, float Tolerance) const
 {
 	const int32 RoundedX = FMath::RoundToInt(X);
@@ -18,9 +18,9 @@ public:
 	float Tolerance = 0.f;
 
 public:
-	FVoxelDataAssetInstance(UVoxelDataAsset& Asset)
+	FVoxelDataAssetInstance(UVoxelDataAsset& Asset, const TVoxelSharedRef<const FVoxelDataAssetData>& InData)
 		: Super(&Asset)
-		, Data(Asset.GetData())
+		, Data(InData)
 		, bSubtractiveAsset(Asset.bSubtractiveAsset)
 		, PositionOffset(Asset.PositionOffset)
 		, Tolerance(Asset.Tolerance)
@@ -41,10 +41,30 @@ public:
 		X -= PositionOffset.X;
 		Y -= PositionOffset.Y;
 		Z -= PositionOffset.Z;
-		
+
+		Data->LoadSlabs(Z, Z);
 		return Data->GetInterpolatedValue(X, Y, Z, bSubtractiveAsset ? FVoxelValue::Full() : FVoxelValue::Empty(), Tolerance);
 	}
 	
+	void GetValuesAlongLine(const FVoxelVector& Start, const FVoxelVector& Delta, int32 Num, int32 LOD, const FVoxelItemStack& Items, v_flt* RESTRICT OutValues) const
+	{
+		if (Num <= 0)
+		{
+			return;
+		}
+		
+		const v_flt EndZ = Start.Z + Delta.Z * (Num - 1);
+		Data->LoadSlabs(FMath::Min(Start.Z, EndZ) - PositionOffset.Z, FMath::Max(Start.Z, EndZ) - PositionOffset.Z);
+		
+		Data->GetInterpolatedValues(
+			Start - FVoxelVector(PositionOffset),
+			Delta,
+			Num,
+			bSubtractiveAsset ? FVoxelValue::Full() : FVoxelValue::Empty(),
+			Tolerance,
+			OutValues);
+	}
+	
 	FVoxelMaterial GetMaterialImpl(v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const
 	{
 		X -= PositionOffset.X;
@@ -53,6 +73,7 @@ public:
 		
 		if (Data->HasMaterials())
 		{
+			Data->LoadSlabs(Z, Z);
 			return Data->GetInterpolatedMaterial(X, Y, Z, Tolerance);
 		}
 		else
@@ -75,6 +96,8 @@ public:
 
 	virtual void GetValues(TVoxelQueryZone<FVoxelValue>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const override
 	{
+		Data->LoadSlabs(QueryZone.Bounds.Min.Z - PositionOffset.Z, QueryZone.Bounds.Max.Z - PositionOffset.Z);
+		
 		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
 		{
 			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
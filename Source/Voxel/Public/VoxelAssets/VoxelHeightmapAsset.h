@@ -141,6 +141,7 @@ public:
 	virtual TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance() override;
 	virtual TVoxelSharedRef<FVoxelTransformableGeneratorInstance> GetTransformableInstance() override;
 	virtual FVoxelIntBox GetBounds() const override;
+	virtual bool CanShareInstances() const override { return true; }
 	//~ End UVoxelGenerator Interface
 
 private:
@@ -194,6 +195,7 @@ public:
 	virtual TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance() override;
 	virtual TVoxelSharedRef<FVoxelTransformableGeneratorInstance> GetTransformableInstance() override;
 	virtual FVoxelIntBox GetBounds() const override;
+	virtual bool CanShareInstances() const override { return true; }
 	//~ End UVoxelGenerator Interface
 
 private:
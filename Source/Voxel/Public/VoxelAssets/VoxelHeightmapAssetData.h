@@ -5,9 +5,15 @@
 #include "CoreMinimal.h"
 #include "VoxelMaterial.h"
 #include "VoxelRange.h"
+#include "HAL/ConsoleManager.h"
+#include "HAL/ThreadSafeCounter64.h"
 
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Heightmap Assets Memory"), STAT_VoxelHeightmapAssetMemory, STATGROUP_VoxelMemory, VOXEL_API);
 
+extern VOXEL_API TAutoConsoleVariable<int32> CVarHeightmapResidentTilesBudget;
+// Unique id identifying a heightmap data. Never reused, unlike pointers
+extern VOXEL_API uint64 NewHeightmapAssetDataId();
+
 namespace FVoxelHeightmapAssetDataVersion
 {
 	enum Type : int32
@@ -29,17 +35,24 @@ namespace FVoxelHeightmapAssetDataVersion
 		SHARED_StoreMaterialChannelsIndividuallyAndRemoveFoliage,
 		UseTArray64,
 		SerializeHeightRangeMips,
-		
+		TiledStorage,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
 	};
 };
 
+// Heights & materials are stored in compressed tiles, that are decompressed when sampled
+// Only the most recently used tiles are kept decompressed, see voxel.heightmaps.ResidentTilesBudget
 template<typename T>
 struct TVoxelHeightmapAssetData
-{	
+{
 public:
+	// Size of an edge of a tile, in pixels
+	static constexpr int64 TileSizeLog2 = 8;
+	static constexpr int64 TileSize = 1 << TileSizeLog2;
+
 	TVoxelHeightmapAssetData()
 	{
 		ClearData();
@@ -69,6 +82,7 @@ public:
 
 public:
 	void SetSize(int64 NewWidth, int64 NewHeight, bool bCreateMaterials, EVoxelMaterialConfig InMaterialConfig);
+	// Also resets the materials
 	void SetAllHeightsTo(T NewHeight);
 
 	void ClearData()
@@ -77,21 +91,22 @@ public:
 		SetSize(2, 2, false, {});
 		SetAllHeightsTo(0);
 	}
-	
+
 public:
 	bool HasMaterials() const
 	{
-		return Materials.Num() > 0;
+		return bHasMaterials;
 	}
 	bool IsEmpty() const
 	{
-		return Heights.Num() <= 4 && Materials.Num() == 0;
+		return Width * Height <= 4 && !bHasMaterials;
 	}
+	// Compressed tiles, resident tiles and height range mips
 	int64 GetAllocatedSize() const
 	{
 		return AllocatedSize;
 	}
-	
+
 public:
 	int64 GetNumHeightRangeMips() const
 	{
@@ -119,43 +134,37 @@ private:
 	void InitializeHeightRangeMips();
 
 public:
-	FORCEINLINE bool IsValidIndex(int64 X, int64 Y) const
+	int32 GetNumHeightMips() const
 	{
-		return (0 <= X && X < Width) && (0 <= Y && Y < Height);
+		return HeightMips.Num();
 	}
-	FORCEINLINE int64 GetIndex(int64 X, int64 Y) const
+	// Mip to sample when querying every StepInPixels pixels. Mip 0 is the full resolution heightmap
+	// The mips are not used until rebuilt by a save after an edit
+	int32 GetHeightMip(float StepInPixels) const;
+
+public:
+	FORCEINLINE bool IsValidIndex(int64 X, int64 Y) const
 	{
-		checkVoxelSlow(IsValidIndex(X, Y));
-		return X + Width * Y;
+		return (0 <= X && X < Width) && (0 <= Y && Y < Height);
 	}
 
+	// Use a FWriter instead when writing many pixels: these lock and invalidate the per thread caches on every call
 	void SetHeight(int64 X, int64 Y, T NewHeight);
 
 	void SetMaterial_RGB(int64 X, int64 Y, FColor Color);
 	void SetMaterial_SingleIndex(int64 X, int64 Y, uint8 SingleIndex);
 	void SetMaterial_MultiIndex(int64 X, int64 Y, const FVoxelMaterial& Material);
 
-	FORCEINLINE T GetHeightUnsafe(int64 X, int64 Y) const
-	{
-		return GetHeightUnsafe(GetIndex(X, Y));
-	}
-	FORCEINLINE FVoxelMaterial GetMaterialUnsafe(int64 X, int64 Y) const
-	{
-		return GetMaterialUnsafe(GetIndex(X, Y));
-	}
-	FORCEINLINE T GetHeightUnsafe(int64 Index) const
-	{
-		return Heights[Index];
-	}
-	FVoxelMaterial GetMaterialUnsafe(int64 Index) const;
-
 public:
 	void TileCoordinates(int64& X, int64& Y) const;
 	void ClampCoordinates(int64& X, int64& Y) const;
 
-	T GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode) const;
+	// Use a FReader instead when sampling many pixels
+	// These use a small per thread cache of the last tiles sampled, so that they only lock when sampling a new tile
+	// Heights are in pixels of Mip
+	T GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode, int32 Mip = 0) const;
 	FVoxelMaterial GetMaterial(int64 X, int64 Y, EVoxelSamplerMode Mode) const;
-	
+
 	T GetHeight(int32 X, int32 Y, EVoxelSamplerMode Mode) const
 	{
 		return GetHeight(int64(X), int64(Y), Mode);
@@ -165,31 +174,209 @@ public:
 		return GetMaterial(int64(X), int64(Y), Mode);
 	}
 
-	float GetHeight(float X, float Y, EVoxelSamplerMode Mode) const;
+	// In pixels of mip 0: the position is converted to Mip
+	float GetHeight(float X, float Y, EVoxelSamplerMode Mode, int32 Mip = 0) const;
 	FVoxelMaterial GetMaterial(float X, float Y, EVoxelSamplerMode Mode) const;
 
 public:
-	const auto& GetRawHeights() const
+	void Serialize(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave);
+
+private:
+	struct FTileData
 	{
-		return Heights;
-	}
+		TArray<T> Heights;
+		// Empty if the heightmap has no materials or if that's not mip 0
+		TArray<uint8> Materials;
+
+		int64 GetAllocatedSize() const
+		{
+			return Heights.GetAllocatedSize() + Materials.GetAllocatedSize();
+		}
+	};
+	// Tiles are paged in and out by the const accessors, under TilesSection
+	struct FTile
+	{
+		// Zlib compressed. Empty if the tile was never written to, in which case all its heights are DefaultHeight
+		mutable TArray<uint8> CompressedHeights;
+		mutable TArray<uint8> CompressedMaterials;
+		// Null if paged out
+		mutable TVoxelSharedPtr<FTileData> Data;
+		// Whether Data was edited since it was last compressed
+		mutable bool bDirty = false;
+		mutable uint64 LastAccess = 0;
+		// Number of FWriter currently writing to Data. Such tiles aren't evicted
+		mutable int32 NumWriters = 0;
+
+		int64 GetCompressedSize() const
+		{
+			return CompressedHeights.GetAllocatedSize() + CompressedMaterials.GetAllocatedSize();
+		}
+	};
+	struct FHeightMip
+	{
+		int64 Width = -1;
+		int64 Height = -1;
+		int64 NumTilesX = -1;
+		int64 NumTilesY = -1;
+
+		TArray<FTile> Tiles;
+
+		FORCEINLINE int64 GetTileIndex(int64 X, int64 Y) const
+		{
+			checkVoxelSlow(0 <= X && X < Width && 0 <= Y && Y < Height);
+			return (X >> TileSizeLog2) + NumTilesX * (Y >> TileSizeLog2);
+		}
+		FORCEINLINE static int64 GetIndexInTile(int64 X, int64 Y)
+		{
+			return (X & (TileSize - 1)) + TileSize * (Y & (TileSize - 1));
+		}
+	};
+	struct FResidentTile
+	{
+		int32 Mip;
+		int64 TileIndex;
+	};
 
 public:
-	void Serialize(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave);
-	
-private:
-	TNoGrowArray64<T> Heights;
-	TNoGrowArray64<uint8> Materials;
+	// Samples a mip, keeping the last tiles it used to avoid looking them up for every pixel
+	// Not thread safe: use one reader per thread
+	class FReader
+	{
+	public:
+		explicit FReader(const TVoxelHeightmapAssetData& Data, int32 Mip = 0)
+			: Data(Data)
+			, Mip(FMath::Clamp(Mip, 0, Data.GetNumHeightMips() - 1))
+			, HeightMip(Data.HeightMips[this->Mip])
+		{
+		}
+
+		int32 GetMip() const
+		{
+			return Mip;
+		}
+
+		// In pixels of this mip
+		T GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode);
+		// In pixels of mip 0. Only valid on mip 0
+		FVoxelMaterial GetMaterial(int64 X, int64 Y, EVoxelSamplerMode Mode);
+
+		// In pixels of mip 0: the position is converted to this mip
+		float GetHeight(float X, float Y, EVoxelSamplerMode Mode);
+		FVoxelMaterial GetMaterial(float X, float Y, EVoxelSamplerMode Mode);
+
+	private:
+		const TVoxelHeightmapAssetData& Data;
+		const int32 Mip;
+		const FHeightMip& HeightMip;
+
+		struct FCachedTile
+		{
+			int64 TileIndex;
+			TVoxelSharedPtr<const FTileData> Data;
+		};
+		// Most recently used first
+		TArray<FCachedTile, TInlineAllocator<4>> CachedTiles;
+
+		void FixCoordinates(int64& X, int64& Y, EVoxelSamplerMode Mode) const;
+		const FTileData* GetTileData(int64 TileIndex);
+	};
+
+	// Writes mip 0, locking and invalidating the per thread caches once per tile instead of once per pixel
+	// Not thread safe: use one writer per thread. Don't resize the data while a writer is alive
+	class FWriter
+	{
+	public:
+		explicit FWriter(TVoxelHeightmapAssetData& Data)
+			: Data(Data)
+		{
+		}
+		~FWriter()
+		{
+			ReleaseTile();
+		}
 
+		void SetHeight(int64 X, int64 Y, T NewHeight);
+
+		void SetMaterial_RGB(int64 X, int64 Y, FColor Color);
+		void SetMaterial_SingleIndex(int64 X, int64 Y, uint8 SingleIndex);
+		void SetMaterial_MultiIndex(int64 X, int64 Y, const FVoxelMaterial& Material);
+
+	private:
+		TVoxelHeightmapAssetData& Data;
+		int64 TileIndex = -1;
+		FTileData* TileData = nullptr;
+
+		FTileData& GetTileData(int64 X, int64 Y, int64& OutIndexInTile);
+		void ReleaseTile();
+	};
+
+private:
 	// In theory these fit in int32, but it's safer to use 64 bit math everywhere
 	int64 Width = -1;
 	int64 Height = -1;
-	
+
 	T MinHeight = 0;
 	T MaxHeight = 0;
 
 	EVoxelMaterialConfig MaterialConfig{};
+	bool bHasMaterials = false;
+
+	// Height of the tiles that were never written to
+	T DefaultHeight = 0;
+
+	// Mip 0 is the full resolution heightmap, and the only one with materials
+	// Each following mip averages 2x2 pixels of the previous one, until a mip fits in a single tile
+	TArray<FHeightMip, TInlineAllocator<16>> HeightMips;
+	// Set by edits: the mips are rebuilt when saving, and aren't sampled until then
+	bool bHeightMipsDirty = false;
+
+	mutable FCriticalSection TilesSection;
+	mutable TArray<FResidentTile> ResidentTiles;
+	mutable uint64 AccessCounter = 0;
+
+	// To find the tiles of this data in the per thread caches
+	const uint64 DataId = NewHeightmapAssetDataId();
+	// Incremented when the tiles kept by the per thread caches might be outdated, ie on any write
+	FThreadSafeCounter64 TilesVersion;
 
+	struct FThreadCachedTile
+	{
+		uint64 DataId = 0;
+		int64 TilesVersion = 0;
+		int32 Mip = 0;
+		int64 TileIndex = 0;
+		// Null if the tile was never written to
+		TVoxelSharedPtr<const FTileData> Data;
+	};
+	// Same as GetTile, but without locking if this thread sampled that tile recently
+	const FTileData* GetTileThreadCached(int32 Mip, int64 TileIndex) const;
+
+	void InitializeHeightMips();
+	void BuildHeightMips();
+
+	// Reads the flat arrays used before TiledStorage
+	void SerializeLegacy(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave);
+
+	int64 GetMaterialSize() const;
+	static FVoxelMaterial DecodeMaterial(const uint8* MaterialData, EVoxelMaterialConfig MaterialConfig);
+
+	// Returns null if the tile was never written to
+	TVoxelSharedPtr<const FTileData> GetTile(int32 Mip, int64 TileIndex) const;
+	// Must be called under TilesSection, and the tile written to before releasing it: else it could be evicted before the write
+	FTileData& GetTileForWrite(int64 X, int64 Y, int64& OutIndexInTile);
+	void UpdateHeightRange(int64 X, int64 Y, T NewHeight);
+
+	TVoxelSharedRef<FTileData> CreateTileData(int32 Mip) const;
+	void DecompressTile(const TArray<uint8>& CompressedHeights, const TArray<uint8>& CompressedMaterials, FTileData& TileData) const;
+	// Must be called under TilesSection if the tile is resident
+	void CompressTile(const FTile& Tile, const FTileData& TileData) const;
+
+	// Must be called under TilesSection
+	void AddResidentTile(int32 Mip, int64 TileIndex, const TVoxelSharedPtr<FTileData>& TileData) const;
+	void EvictTiles() const;
+	void ResetResidentTiles();
+
+private:
 	struct FHeightRangeMip
 	{
 		int64 Width = -1;
@@ -219,9 +406,10 @@ private:
 	TArray<FHeightRangeMip, TInlineAllocator<16>> HeightRangeMips;
 
 	static constexpr uint32 MipChunkSize = 32;
-	
+
 private:
-	int64 AllocatedSize = 0;
+	mutable int64 AllocatedSize = 0;
 
 	void UpdateStats();
+	void AddAllocatedSize(int64 Delta) const;
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "VoxelFeedbackContext.h"
 #include "VoxelAssets/VoxelHeightmapAssetData.h"
 #include "VoxelUtilities/VoxelSerializationUtilities.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
 
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetSize(int64 NewWidth, int64 NewHeight, bool bCreateMaterials, EVoxelMaterialConfig InMaterialConfig)
@@ -15,28 +17,7 @@ void TVoxelHeightmapAssetData<T>::SetSize(int64 NewWidth, int64 NewHeight, bool
 
 	check(NewWidth > 0 && NewHeight > 0);
 
-	const int64 NumHeights = NewWidth * NewHeight;
-	Heights.Empty(NumHeights);
-	Heights.SetNumUninitialized(NumHeights);
-
-	if (bCreateMaterials)
-	{
-		int64 NumMaterials = NewWidth * NewHeight;
-		switch (InMaterialConfig)
-		{
-		case EVoxelMaterialConfig::RGB: NumMaterials *= 4; break;
-		case EVoxelMaterialConfig::SingleIndex: NumMaterials *= 1; break;
-		case EVoxelMaterialConfig::MultiIndex: NumMaterials *= 7; break;
-		default: ensure(false);
-		}
-
-		Materials.Empty(NumMaterials);
-		Materials.SetNumUninitialized(NumMaterials);
-	}
-	else
-	{
-		Materials.Empty();
-	}
+	ResetResidentTiles();
 
 	Width = NewWidth;
 	Height = NewHeight;
@@ -45,9 +26,15 @@ void TVoxelHeightmapAssetData<T>::SetSize(int64 NewWidth, int64 NewHeight, bool
 	MaxHeight = NegativeInfinity<T>();
 
 	MaterialConfig = InMaterialConfig;
+	bHasMaterials = bCreateMaterials;
+	ensure(!bHasMaterials || GetMaterialSize() > 0);
 
-	UpdateStats();
+	DefaultHeight = 0;
+	bHeightMipsDirty = false;
+
+	InitializeHeightMips();
 	InitializeHeightRangeMips();
+	UpdateStats();
 }
 
 template<typename T>
@@ -55,10 +42,18 @@ void TVoxelHeightmapAssetData<T>::SetAllHeightsTo(T NewHeight)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 
-	for (auto& HeightIt : Heights)
+	// Drop all the tiles: the tiles that were never written to are all DefaultHeight
+	ResetResidentTiles();
+	for (FHeightMip& HeightMip : HeightMips)
 	{
-		HeightIt = NewHeight;
+		for (FTile& Tile : HeightMip.Tiles)
+		{
+			Tile = {};
+		}
 	}
+	DefaultHeight = NewHeight;
+	bHeightMipsDirty = false;
+
 	for (auto& HeightRangeMip : HeightRangeMips)
 	{
 		for (auto& HeightRange : HeightRangeMip.Data)
@@ -66,6 +61,8 @@ void TVoxelHeightmapAssetData<T>::SetAllHeightsTo(T NewHeight)
 			HeightRange = NewHeight;
 		}
 	}
+
+	UpdateStats();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -254,11 +251,405 @@ void TVoxelHeightmapAssetData<T>::InitializeHeightRangeMips()
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+template<typename T>
+void TVoxelHeightmapAssetData<T>::InitializeHeightMips()
+{
+	HeightMips.Empty();
+
+	int64 MipWidth = Width;
+	int64 MipHeight = Height;
+	while (true)
+	{
+		FHeightMip& HeightMip = HeightMips.Emplace_GetRef();
+		HeightMip.Width = MipWidth;
+		HeightMip.Height = MipHeight;
+		HeightMip.NumTilesX = FVoxelUtilities::DivideCeil64(MipWidth, TileSize);
+		HeightMip.NumTilesY = FVoxelUtilities::DivideCeil64(MipHeight, TileSize);
+		HeightMip.Tiles.SetNum(HeightMip.NumTilesX * HeightMip.NumTilesY);
+
+		if (HeightMip.NumTilesX == 1 && HeightMip.NumTilesY == 1)
+		{
+			break;
+		}
+
+		MipWidth = FVoxelUtilities::DivideCeil64(MipWidth, 2);
+		MipHeight = FVoxelUtilities::DivideCeil64(MipHeight, 2);
+	}
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::BuildHeightMips()
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	{
+		// The mips are entirely rewritten
+		FScopeLock Lock(&TilesSection);
+		for (int32 Index = 0; Index < ResidentTiles.Num(); Index++)
+		{
+			const FResidentTile ResidentTile = ResidentTiles[Index];
+			if (ResidentTile.Mip == 0)
+			{
+				continue;
+			}
+
+			const FTile& Tile = HeightMips[ResidentTile.Mip].Tiles[ResidentTile.TileIndex];
+			AddAllocatedSize(-Tile.Data->GetAllocatedSize());
+			Tile.Data.Reset();
+			ResidentTiles.RemoveAtSwap(Index--, 1, false);
+		}
+	}
+
+	FTileData TileData;
+	TileData.Heights.SetNumUninitialized(TileSize * TileSize);
+
+	for (int32 Mip = 1; Mip < HeightMips.Num(); Mip++)
+	{
+		FHeightMip& HeightMip = HeightMips[Mip];
+		FReader Reader(*this, Mip - 1);
+
+		for (int64 TileY = 0; TileY < HeightMip.NumTilesY; TileY++)
+		{
+			for (int64 TileX = 0; TileX < HeightMip.NumTilesX; TileX++)
+			{
+				for (int64 LocalY = 0; LocalY < TileSize; LocalY++)
+				{
+					for (int64 LocalX = 0; LocalX < TileSize; LocalX++)
+					{
+						const int64 X = TileX * TileSize + LocalX;
+						const int64 Y = TileY * TileSize + LocalY;
+
+						T& MipHeight = TileData.Heights[FHeightMip::GetIndexInTile(LocalX, LocalY)];
+						if (X >= HeightMip.Width || Y >= HeightMip.Height)
+						{
+							MipHeight = DefaultHeight;
+							continue;
+						}
+
+						// Box filter. Clamp handles odd sizes
+						const double Sum =
+							double(Reader.GetHeight(2 * X + 0, 2 * Y + 0, EVoxelSamplerMode::Clamp)) +
+							double(Reader.GetHeight(2 * X + 1, 2 * Y + 0, EVoxelSamplerMode::Clamp)) +
+							double(Reader.GetHeight(2 * X + 0, 2 * Y + 1, EVoxelSamplerMode::Clamp)) +
+							double(Reader.GetHeight(2 * X + 1, 2 * Y + 1, EVoxelSamplerMode::Clamp));
+
+						MipHeight = TIsSame<T, float>::Value ? T(Sum / 4) : T(FMath::RoundToInt(Sum / 4));
+					}
+				}
+
+				FScopeLock Lock(&TilesSection);
+				CompressTile(HeightMip.Tiles[TileX + HeightMip.NumTilesX * TileY], TileData);
+			}
+		}
+	}
+
+	TilesVersion.Increment();
+	bHeightMipsDirty = false;
+}
+
+template<typename T>
+int32 TVoxelHeightmapAssetData<T>::GetHeightMip(float StepInPixels) const
+{
+	if (bHeightMipsDirty || StepInPixels < 2)
+	{
+		return 0;
+	}
+
+	return FMath::Min<int32>(FMath::FloorLog2(uint32(FMath::Min(StepInPixels, float(MAX_int32)))), HeightMips.Num() - 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+int64 TVoxelHeightmapAssetData<T>::GetMaterialSize() const
+{
+	switch (MaterialConfig)
+	{
+	case EVoxelMaterialConfig::RGB: return 4;
+	case EVoxelMaterialConfig::SingleIndex: return 1;
+	case EVoxelMaterialConfig::MultiIndex: return 7;
+	default: return 0;
+	}
+}
+
+template<typename T>
+TVoxelSharedPtr<const typename TVoxelHeightmapAssetData<T>::FTileData> TVoxelHeightmapAssetData<T>::GetTile(int32 Mip, int64 TileIndex) const
+{
+	const FTile& Tile = HeightMips[Mip].Tiles[TileIndex];
+
+	TArray<uint8> CompressedHeights;
+	TArray<uint8> CompressedMaterials;
+	{
+		FScopeLock Lock(&TilesSection);
+		if (Tile.Data.IsValid())
+		{
+			Tile.LastAccess = ++AccessCounter;
+			return Tile.Data;
+		}
+		if (Tile.CompressedHeights.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		// Copy to decompress outside of the lock: the compressed data changes if an edited tile is evicted
+		CompressedHeights = Tile.CompressedHeights;
+		CompressedMaterials = Tile.CompressedMaterials;
+	}
+
+	const TVoxelSharedRef<FTileData> TileData = CreateTileData(Mip);
+	DecompressTile(CompressedHeights, CompressedMaterials, *TileData);
+
+	FScopeLock Lock(&TilesSection);
+	if (!Tile.Data.IsValid())
+	{
+		AddResidentTile(Mip, TileIndex, TileData);
+	}
+	Tile.LastAccess = ++AccessCounter;
+	return Tile.Data;
+}
+
+template<typename T>
+const typename TVoxelHeightmapAssetData<T>::FTileData* TVoxelHeightmapAssetData<T>::GetTileThreadCached(int32 Mip, int64 TileIndex) const
+{
+	// Shared by all the heightmaps of this type sampled by this thread. Small, as it keeps the tiles alive
+	static thread_local TArray<FThreadCachedTile, TInlineAllocator<4>> CachedTiles;
+
+	// Read before getting the tile: a concurrent write will then invalidate it
+	const int64 Version = TilesVersion.GetValue();
+	for (const FThreadCachedTile& CachedTile : CachedTiles)
+	{
+		if (CachedTile.DataId == DataId &&
+			CachedTile.TilesVersion == Version &&
+			CachedTile.Mip == Mip &&
+			CachedTile.TileIndex == TileIndex)
+		{
+			return CachedTile.Data.Get();
+		}
+	}
+
+	if (CachedTiles.Num() == 4)
+	{
+		CachedTiles.Pop(false);
+	}
+	CachedTiles.Insert({ DataId, Version, Mip, TileIndex, GetTile(Mip, TileIndex) }, 0);
+	return CachedTiles[0].Data.Get();
+}
+
+template<typename T>
+typename TVoxelHeightmapAssetData<T>::FTileData& TVoxelHeightmapAssetData<T>::GetTileForWrite(int64 X, int64 Y, int64& OutIndexInTile)
+{
+	const FHeightMip& HeightMip = HeightMips[0];
+	const int64 TileIndex = HeightMip.GetTileIndex(X, Y);
+	OutIndexInTile = FHeightMip::GetIndexInTile(X, Y);
+
+	const FTile& Tile = HeightMip.Tiles[TileIndex];
+
+	if (!Tile.Data.IsValid())
+	{
+		const TVoxelSharedRef<FTileData> TileData = CreateTileData(0);
+		if (Tile.CompressedHeights.Num() > 0)
+		{
+			DecompressTile(Tile.CompressedHeights, Tile.CompressedMaterials, *TileData);
+		}
+		else
+		{
+			for (T& TileHeight : TileData->Heights)
+			{
+				TileHeight = DefaultHeight;
+			}
+			FMemory::Memzero(TileData->Materials.GetData(), TileData->Materials.Num());
+		}
+		AddResidentTile(0, TileIndex, TileData);
+	}
+
+	Tile.bDirty = true;
+	Tile.LastAccess = ++AccessCounter;
+	bHeightMipsDirty = true;
+	// The per thread caches might have an older copy of this tile
+	TilesVersion.Increment();
+
+	return *Tile.Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+TVoxelSharedRef<typename TVoxelHeightmapAssetData<T>::FTileData> TVoxelHeightmapAssetData<T>::CreateTileData(int32 Mip) const
+{
+	const TVoxelSharedRef<FTileData> TileData = MakeVoxelShared<FTileData>();
+	TileData->Heights.SetNumUninitialized(TileSize * TileSize);
+	if (Mip == 0 && bHasMaterials)
+	{
+		TileData->Materials.SetNumUninitialized(TileSize * TileSize * GetMaterialSize());
+	}
+	return TileData;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::DecompressTile(const TArray<uint8>& CompressedHeights, const TArray<uint8>& CompressedMaterials, FTileData& TileData) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	const bool bHeightsSuccess = FCompression::UncompressMemory(
+		NAME_Zlib,
+		TileData.Heights.GetData(),
+		TileData.Heights.Num() * sizeof(T),
+		CompressedHeights.GetData(),
+		CompressedHeights.Num());
+
+	if (!ensureMsgf(bHeightsSuccess, TEXT("Failed to decompress heightmap tile")))
+	{
+		for (T& TileHeight : TileData.Heights)
+		{
+			TileHeight = DefaultHeight;
+		}
+	}
+
+	if (TileData.Materials.Num() > 0)
+	{
+		const bool bMaterialsSuccess =
+			CompressedMaterials.Num() > 0 &&
+			FCompression::UncompressMemory(
+				NAME_Zlib,
+				TileData.Materials.GetData(),
+				TileData.Materials.Num(),
+				CompressedMaterials.GetData(),
+				CompressedMaterials.Num());
+
+		if (!ensureMsgf(bMaterialsSuccess, TEXT("Failed to decompress heightmap tile materials")))
+		{
+			FMemory::Memzero(TileData.Materials.GetData(), TileData.Materials.Num());
+		}
+	}
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::CompressTile(const FTile& Tile, const FTileData& TileData) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	const auto Compress = [](const void* Data, int32 Size, TArray<uint8>& OutCompressedData)
+	{
+		if (Size == 0)
+		{
+			OutCompressedData.Empty();
+			return;
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Size);
+		OutCompressedData.SetNumUninitialized(CompressedSize);
+		verify(FCompression::CompressMemory(NAME_Zlib, OutCompressedData.GetData(), CompressedSize, Data, Size));
+		OutCompressedData.SetNum(CompressedSize, false);
+		OutCompressedData.Shrink();
+	};
+
+	AddAllocatedSize(-Tile.GetCompressedSize());
+	Compress(TileData.Heights.GetData(), TileData.Heights.Num() * sizeof(T), Tile.CompressedHeights);
+	Compress(TileData.Materials.GetData(), TileData.Materials.Num(), Tile.CompressedMaterials);
+	AddAllocatedSize(Tile.GetCompressedSize());
+
+	Tile.bDirty = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::AddResidentTile(int32 Mip, int64 TileIndex, const TVoxelSharedPtr<FTileData>& TileData) const
+{
+	checkVoxelSlow(TileData.IsValid());
+
+	const FTile& Tile = HeightMips[Mip].Tiles[TileIndex];
+	checkVoxelSlow(!Tile.Data.IsValid());
+
+	Tile.Data = TileData;
+	// Make sure it's not evicted right away
+	Tile.LastAccess = ++AccessCounter;
+	ResidentTiles.Add({ Mip, TileIndex });
+	AddAllocatedSize(TileData->GetAllocatedSize());
+
+	EvictTiles();
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::EvictTiles() const
+{
+	const int32 Budget = FMath::Max(1, CVarHeightmapResidentTilesBudget.GetValueOnAnyThread());
+	if (ResidentTiles.Num() <= Budget)
+	{
+		return;
+	}
+
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	const auto GetTileRef = [&](const FResidentTile& ResidentTile) -> const FTile&
+	{
+		return HeightMips[ResidentTile.Mip].Tiles[ResidentTile.TileIndex];
+	};
+
+	// Evict a few more than needed to not sort on every new tile
+	ResidentTiles.Sort([&](const FResidentTile& A, const FResidentTile& B) { return GetTileRef(A).LastAccess < GetTileRef(B).LastAccess; });
+	const int32 NumToEvict = ResidentTiles.Num() - FMath::Max(1, Budget - Budget / 4);
+
+	int32 NumEvicted = 0;
+	int32 NumKept = 0;
+	for (int32 Index = 0; Index < ResidentTiles.Num(); Index++)
+	{
+		const FResidentTile ResidentTile = ResidentTiles[Index];
+		const FTile& Tile = GetTileRef(ResidentTile);
+
+		// Tiles being written to would lose the writes
+		if (NumEvicted < NumToEvict && Tile.NumWriters == 0)
+		{
+			if (Tile.bDirty)
+			{
+				CompressTile(Tile, *Tile.Data);
+			}
+			AddAllocatedSize(-Tile.Data->GetAllocatedSize());
+			// Readers using this tile keep it alive
+			Tile.Data.Reset();
+			NumEvicted++;
+			continue;
+		}
+
+		ResidentTiles[NumKept++] = ResidentTile;
+	}
+	ResidentTiles.SetNum(NumKept, false);
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::ResetResidentTiles()
+{
+	FScopeLock Lock(&TilesSection);
+	for (const FResidentTile& ResidentTile : ResidentTiles)
+	{
+		const FTile& Tile = HeightMips[ResidentTile.Mip].Tiles[ResidentTile.TileIndex];
+		if (Tile.bDirty)
+		{
+			CompressTile(Tile, *Tile.Data);
+		}
+		AddAllocatedSize(-Tile.Data->GetAllocatedSize());
+		Tile.Data.Reset();
+	}
+	ResidentTiles.Reset();
+	// The tiles are about to be rewritten
+	TilesVersion.Increment();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetHeight(int64 X, int64 Y, T NewHeight)
 {
-	Heights[GetIndex(X, Y)] = NewHeight;
+	FWriter(*this).SetHeight(X, Y, NewHeight);
+}
 
+template<typename T>
+void TVoxelHeightmapAssetData<T>::UpdateHeightRange(int64 X, int64 Y, T NewHeight)
+{
 	MaxHeight = FMath::Max(MaxHeight, NewHeight);
 	MinHeight = FMath::Min(MinHeight, NewHeight);
 
@@ -281,35 +672,108 @@ void TVoxelHeightmapAssetData<T>::SetHeight(int64 X, int64 Y, T NewHeight)
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetMaterial_RGB(int64 X, int64 Y, FColor Color)
 {
-	checkVoxelSlow(MaterialConfig == EVoxelMaterialConfig::RGB);
-	const int64 Index = GetIndex(X, Y);
-
-	Materials[4 * Index + 0] = Color.R;
-	Materials[4 * Index + 1] = Color.G;
-	Materials[4 * Index + 2] = Color.B;
-	Materials[4 * Index + 3] = Color.A;
+	FWriter(*this).SetMaterial_RGB(X, Y, Color);
 }
 
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetMaterial_SingleIndex(int64 X, int64 Y, uint8 SingleIndex)
 {
-	checkVoxelSlow(MaterialConfig == EVoxelMaterialConfig::SingleIndex);
-	Materials[GetIndex(X, Y)] = SingleIndex;
+	FWriter(*this).SetMaterial_SingleIndex(X, Y, SingleIndex);
 }
 
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetMaterial_MultiIndex(int64 X, int64 Y, const FVoxelMaterial& Material)
 {
-	checkVoxelSlow(MaterialConfig == EVoxelMaterialConfig::MultiIndex);
-	const int64 Index = GetIndex(X, Y);
+	FWriter(*this).SetMaterial_MultiIndex(X, Y, Material);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+typename TVoxelHeightmapAssetData<T>::FTileData& TVoxelHeightmapAssetData<T>::FWriter::GetTileData(int64 X, int64 Y, int64& OutIndexInTile)
+{
+	const int64 NewTileIndex = Data.HeightMips[0].GetTileIndex(X, Y);
+	if (TileData && TileIndex == NewTileIndex)
+	{
+		OutIndexInTile = FHeightMip::GetIndexInTile(X, Y);
+		return *TileData;
+	}
+
+	ReleaseTile();
+
+	// Only lock, dirty the mips & invalidate the per thread caches once per tile
+	FScopeLock Lock(&Data.TilesSection);
+	TileData = &Data.GetTileForWrite(X, Y, OutIndexInTile);
+	TileIndex = NewTileIndex;
+	Data.HeightMips[0].Tiles[TileIndex].NumWriters++;
+	return *TileData;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::FWriter::ReleaseTile()
+{
+	if (!TileData)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Data.TilesSection);
+	const FTile& Tile = Data.HeightMips[0].Tiles[TileIndex];
+	checkVoxelSlow(Tile.NumWriters > 0 && Tile.Data.Get() == TileData);
+	Tile.NumWriters--;
+	// In case it was compressed by a save in the meantime
+	Tile.bDirty = true;
+
+	TileIndex = -1;
+	TileData = nullptr;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::FWriter::SetHeight(int64 X, int64 Y, T NewHeight)
+{
+	int64 IndexInTile;
+	GetTileData(X, Y, IndexInTile).Heights[IndexInTile] = NewHeight;
 
-	Materials[7 * Index + 0] = Material.GetMultiIndex_Blend0();
-	Materials[7 * Index + 1] = Material.GetMultiIndex_Blend1();
-	Materials[7 * Index + 2] = Material.GetMultiIndex_Blend2();
-	Materials[7 * Index + 3] = Material.GetMultiIndex_Index0();
-	Materials[7 * Index + 4] = Material.GetMultiIndex_Index1();
-	Materials[7 * Index + 5] = Material.GetMultiIndex_Index2();
-	Materials[7 * Index + 6] = Material.GetMultiIndex_Index3();
+	Data.UpdateHeightRange(X, Y, NewHeight);
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::FWriter::SetMaterial_RGB(int64 X, int64 Y, FColor Color)
+{
+	checkVoxelSlow(Data.bHasMaterials && Data.MaterialConfig == EVoxelMaterialConfig::RGB);
+	int64 IndexInTile;
+	uint8* Material = &GetTileData(X, Y, IndexInTile).Materials[4 * IndexInTile];
+
+	Material[0] = Color.R;
+	Material[1] = Color.G;
+	Material[2] = Color.B;
+	Material[3] = Color.A;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::FWriter::SetMaterial_SingleIndex(int64 X, int64 Y, uint8 SingleIndex)
+{
+	checkVoxelSlow(Data.bHasMaterials && Data.MaterialConfig == EVoxelMaterialConfig::SingleIndex);
+	int64 IndexInTile;
+	GetTileData(X, Y, IndexInTile).Materials[IndexInTile] = SingleIndex;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::FWriter::SetMaterial_MultiIndex(int64 X, int64 Y, const FVoxelMaterial& Material)
+{
+	checkVoxelSlow(Data.bHasMaterials && Data.MaterialConfig == EVoxelMaterialConfig::MultiIndex);
+	int64 IndexInTile;
+	uint8* MaterialData = &GetTileData(X, Y, IndexInTile).Materials[7 * IndexInTile];
+
+	MaterialData[0] = Material.GetMultiIndex_Blend0();
+	MaterialData[1] = Material.GetMultiIndex_Blend1();
+	MaterialData[2] = Material.GetMultiIndex_Blend2();
+	MaterialData[3] = Material.GetMultiIndex_Index0();
+	MaterialData[4] = Material.GetMultiIndex_Index1();
+	MaterialData[5] = Material.GetMultiIndex_Index2();
+	MaterialData[6] = Material.GetMultiIndex_Index3();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -317,29 +781,29 @@ void TVoxelHeightmapAssetData<T>::SetMaterial_MultiIndex(int64 X, int64 Y, const
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-FORCEINLINE FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterialUnsafe(int64 Index) const
+FORCEINLINE FVoxelMaterial TVoxelHeightmapAssetData<T>::DecodeMaterial(const uint8* MaterialData, EVoxelMaterialConfig MaterialConfig)
 {
 	FVoxelMaterial Material(ForceInit);
 	switch (MaterialConfig)
 	{
 	case EVoxelMaterialConfig::RGB:
-		Material.SetR(Materials[4 * Index + 0]);
-		Material.SetG(Materials[4 * Index + 1]);
-		Material.SetB(Materials[4 * Index + 2]);
-		Material.SetA(Materials[4 * Index + 3]);
+		Material.SetR(MaterialData[0]);
+		Material.SetG(MaterialData[1]);
+		Material.SetB(MaterialData[2]);
+		Material.SetA(MaterialData[3]);
 		break;
 	case EVoxelMaterialConfig::SingleIndex:
-		Material.SetSingleIndex(Materials[Index]);
+		Material.SetSingleIndex(MaterialData[0]);
 		break;
 	case EVoxelMaterialConfig::MultiIndex:
 	default:
-		Material.SetMultiIndex_Blend0(Materials[7 * Index + 0]);
-		Material.SetMultiIndex_Blend1(Materials[7 * Index + 1]);
-		Material.SetMultiIndex_Blend2(Materials[7 * Index + 2]);
-		Material.SetMultiIndex_Index0(Materials[7 * Index + 3]);
-		Material.SetMultiIndex_Index1(Materials[7 * Index + 4]);
-		Material.SetMultiIndex_Index2(Materials[7 * Index + 5]);
-		Material.SetMultiIndex_Index3(Materials[7 * Index + 6]);
+		Material.SetMultiIndex_Blend0(MaterialData[0]);
+		Material.SetMultiIndex_Blend1(MaterialData[1]);
+		Material.SetMultiIndex_Blend2(MaterialData[2]);
+		Material.SetMultiIndex_Index0(MaterialData[3]);
+		Material.SetMultiIndex_Index1(MaterialData[4]);
+		Material.SetMultiIndex_Index2(MaterialData[5]);
+		Material.SetMultiIndex_Index3(MaterialData[6]);
 		break;
 	}
 	return Material;
@@ -368,21 +832,153 @@ FORCEINLINE void TVoxelHeightmapAssetData<T>::TileCoordinates(int64& X, int64& Y
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-T TVoxelHeightmapAssetData<T>::GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode) const
+FORCEINLINE void TVoxelHeightmapAssetData<T>::FReader::FixCoordinates(int64& X, int64& Y, EVoxelSamplerMode Mode) const
 {
-	if (!IsValidIndex(X, Y))
+	if ((0 <= X && X < HeightMip.Width) && (0 <= Y && Y < HeightMip.Height))
+	{
+		return;
+	}
+
+	if (Mode == EVoxelSamplerMode::Tile)
+	{
+		X = FVoxelUtilities::PositiveMod(X, HeightMip.Width);
+		Y = FVoxelUtilities::PositiveMod(Y, HeightMip.Height);
+	}
+	else
+	{
+		X = FMath::Clamp<int64>(X, 0, HeightMip.Width - 1);
+		Y = FMath::Clamp<int64>(Y, 0, HeightMip.Height - 1);
+	}
+}
+
+template<typename T>
+FORCEINLINE const typename TVoxelHeightmapAssetData<T>::FTileData* TVoxelHeightmapAssetData<T>::FReader::GetTileData(int64 TileIndex)
+{
+	if (CachedTiles.Num() > 0 && CachedTiles[0].TileIndex == TileIndex)
+	{
+		return CachedTiles[0].Data.Get();
+	}
+
+	for (int32 Index = 1; Index < CachedTiles.Num(); Index++)
+	{
+		if (CachedTiles[Index].TileIndex == TileIndex)
+		{
+			// Move it first
+			const FCachedTile CachedTile = CachedTiles[Index];
+			CachedTiles.RemoveAt(Index, 1, false);
+			CachedTiles.Insert(CachedTile, 0);
+			return CachedTile.Data.Get();
+		}
+	}
+
+	if (CachedTiles.Num() == 4)
+	{
+		CachedTiles.Pop(false);
+	}
+	CachedTiles.Insert({ TileIndex, Data.GetTile(Mip, TileIndex) }, 0);
+	return CachedTiles[0].Data.Get();
+}
+
+template<typename T>
+T TVoxelHeightmapAssetData<T>::FReader::GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode)
+{
+	FixCoordinates(X, Y, Mode);
+
+	const FTileData* TileData = GetTileData(HeightMip.GetTileIndex(X, Y));
+	if (!TileData)
+	{
+		return Data.DefaultHeight;
+	}
+	return TileData->Heights[FHeightMip::GetIndexInTile(X, Y)];
+}
+
+template<typename T>
+FVoxelMaterial TVoxelHeightmapAssetData<T>::FReader::GetMaterial(int64 X, int64 Y, EVoxelSamplerMode Mode)
+{
+	checkVoxelSlow(Mip == 0);
+	FixCoordinates(X, Y, Mode);
+
+	const FTileData* TileData = GetTileData(HeightMip.GetTileIndex(X, Y));
+	if (!TileData || TileData->Materials.Num() == 0)
+	{
+		return FVoxelMaterial(ForceInit);
+	}
+	return DecodeMaterial(&TileData->Materials[Data.GetMaterialSize() * FHeightMip::GetIndexInTile(X, Y)], Data.MaterialConfig);
+}
+
+template<typename T>
+float TVoxelHeightmapAssetData<T>::FReader::GetHeight(float X, float Y, EVoxelSamplerMode Mode)
+{
+	if (Mip > 0)
+	{
+		// Pixel N of this mip is centered on the pixels N * Divisor to (N + 1) * Divisor - 1 of mip 0
+		const float Divisor = 1 << Mip;
+		X = (X - (Divisor - 1) / 2) / Divisor;
+		Y = (Y - (Divisor - 1) / 2) / Divisor;
+	}
+
+	const int64 MinX = FMath::FloorToInt(X);
+	const int64 MinY = FMath::FloorToInt(Y);
+
+	const int64 MaxX = FMath::CeilToInt(X);
+	const int64 MaxY = FMath::CeilToInt(Y);
+
+	const float AlphaX = X - MinX;
+	const float AlphaY = Y - MinY;
+
+	return FVoxelUtilities::BilinearInterpolation<float>(
+		GetHeight(MinX, MinY, Mode),
+		GetHeight(MaxX, MinY, Mode),
+		GetHeight(MinX, MaxY, Mode),
+		GetHeight(MaxX, MaxY, Mode),
+		AlphaX,
+		AlphaY);
+}
+
+template<typename T>
+FVoxelMaterial TVoxelHeightmapAssetData<T>::FReader::GetMaterial(float X, float Y, EVoxelSamplerMode Mode)
+{
+	if (Data.HasMaterials())
+	{
+		return GetMaterial(int64(FMath::RoundToInt(X)), int64(FMath::RoundToInt(Y)), Mode);
+	}
+	else
+	{
+		return FVoxelMaterial::Default();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+T TVoxelHeightmapAssetData<T>::GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode, int32 Mip) const
+{
+	checkVoxelSlow(HeightMips.IsValidIndex(Mip));
+	const FHeightMip& HeightMip = HeightMips[Mip];
+
+	if (!((0 <= X && X < HeightMip.Width) && (0 <= Y && Y < HeightMip.Height)))
 	{
 		if (Mode == EVoxelSamplerMode::Tile)
 		{
-			TileCoordinates(X, Y);
+			X = FVoxelUtilities::PositiveMod(X, HeightMip.Width);
+			Y = FVoxelUtilities::PositiveMod(Y, HeightMip.Height);
 		}
 		else
 		{
-			ClampCoordinates(X, Y);
+			X = FMath::Clamp<int64>(X, 0, HeightMip.Width - 1);
+			Y = FMath::Clamp<int64>(Y, 0, HeightMip.Height - 1);
 		}
-		checkVoxelSlow(IsValidIndex(X, Y));
 	}
-	return GetHeightUnsafe(X, Y);
+
+	// Only valid until the next GetTileThreadCached
+	const FTileData* TileData = GetTileThreadCached(Mip, HeightMip.GetTileIndex(X, Y));
+	if (!TileData)
+	{
+		return DefaultHeight;
+	}
+	return TileData->Heights[FHeightMip::GetIndexInTile(X, Y)];
 }
 
 template<typename T>
@@ -398,14 +994,29 @@ FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterial(int64 X, int64 Y, EVoxel
 		{
 			ClampCoordinates(X, Y);
 		}
-		checkVoxelSlow(IsValidIndex(X, Y));
 	}
-	return GetMaterialUnsafe(X, Y);
+
+	// Only valid until the next GetTileThreadCached
+	const FTileData* TileData = GetTileThreadCached(0, HeightMips[0].GetTileIndex(X, Y));
+	if (!TileData || TileData->Materials.Num() == 0)
+	{
+		return FVoxelMaterial(ForceInit);
+	}
+	return DecodeMaterial(&TileData->Materials[GetMaterialSize() * FHeightMip::GetIndexInTile(X, Y)], MaterialConfig);
 }
 
 template<typename T>
-float TVoxelHeightmapAssetData<T>::GetHeight(float X, float Y, EVoxelSamplerMode Mode) const
+float TVoxelHeightmapAssetData<T>::GetHeight(float X, float Y, EVoxelSamplerMode Mode, int32 Mip) const
 {
+	Mip = FMath::Clamp(Mip, 0, GetNumHeightMips() - 1);
+	if (Mip > 0)
+	{
+		// Same as FReader::GetHeight
+		const float Divisor = 1 << Mip;
+		X = (X - (Divisor - 1) / 2) / Divisor;
+		Y = (Y - (Divisor - 1) / 2) / Divisor;
+	}
+
 	const int64 MinX = FMath::FloorToInt(X);
 	const int64 MinY = FMath::FloorToInt(Y);
 
@@ -416,10 +1027,10 @@ float TVoxelHeightmapAssetData<T>::GetHeight(float X, float Y, EVoxelSamplerMode
 	const float AlphaY = Y - MinY;
 
 	return FVoxelUtilities::BilinearInterpolation<float>(
-		GetHeight(MinX, MinY, Mode),
-		GetHeight(MaxX, MinY, Mode),
-		GetHeight(MinX, MaxY, Mode),
-		GetHeight(MaxX, MaxY, Mode),
+		GetHeight(MinX, MinY, Mode, Mip),
+		GetHeight(MaxX, MinY, Mode, Mip),
+		GetHeight(MinX, MaxY, Mode, Mip),
+		GetHeight(MaxX, MaxY, Mode, Mip),
 		AlphaX,
 		AlphaY);
 }
@@ -429,7 +1040,7 @@ FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterial(float X, float Y, EVoxel
 {
 	if (HasMaterials())
 	{
-		return GetMaterial(FMath::RoundToInt(X), FMath::RoundToInt(Y), Mode);
+		return GetMaterial(int64(FMath::RoundToInt(X)), int64(FMath::RoundToInt(Y)), Mode);
 	}
 	else
 	{
@@ -445,9 +1056,93 @@ template<typename T>
 void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave)
 {
 	VOXEL_FUNCTION_COUNTER();
-	
-	FVoxelScopedSlowTask Serializing(3.f);
-	
+
+	if (Version < FVoxelHeightmapAssetDataVersion::TiledStorage)
+	{
+		check(Ar.IsLoading());
+		SerializeLegacy(Ar, MaterialConfigFlag, Version, bNeedToSave);
+		UpdateStats();
+		return;
+	}
+
+	Ar << Width;
+	Ar << Height;
+
+	Ar << MaxHeight;
+	Ar << MinHeight;
+
+	Ar << MaterialConfig;
+	Ar << bHasMaterials;
+	Ar << DefaultHeight;
+
+	if (Ar.IsSaving())
+	{
+		if (bHeightMipsDirty)
+		{
+			BuildHeightMips();
+		}
+
+		FScopeLock Lock(&TilesSection);
+		for (const FResidentTile& ResidentTile : ResidentTiles)
+		{
+			const FTile& Tile = HeightMips[ResidentTile.Mip].Tiles[ResidentTile.TileIndex];
+			if (Tile.bDirty)
+			{
+				CompressTile(Tile, *Tile.Data);
+			}
+		}
+	}
+	else
+	{
+		ResetResidentTiles();
+
+		if (Width <= 0 || Height <= 0 || (bHasMaterials && GetMaterialSize() == 0))
+		{
+			Ar.SetError();
+			return;
+		}
+
+		InitializeHeightMips();
+		bHeightMipsDirty = false;
+	}
+
+	int32 NumHeightMips = HeightMips.Num();
+	Ar << NumHeightMips;
+	if (NumHeightMips != HeightMips.Num())
+	{
+		Ar.SetError();
+		return;
+	}
+
+	{
+		FVoxelScopedSlowTask Serializing(HeightMips.Num(), VOXEL_LOCTEXT("Serializing tiles"));
+		FScopeLock Lock(&TilesSection);
+		for (FHeightMip& HeightMip : HeightMips)
+		{
+			Serializing.EnterProgressFrame();
+			for (FTile& Tile : HeightMip.Tiles)
+			{
+				Tile.CompressedHeights.BulkSerialize(Ar);
+				Tile.CompressedMaterials.BulkSerialize(Ar);
+			}
+		}
+	}
+
+	Ar << HeightRangeMips;
+
+	UpdateStats();
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::SerializeLegacy(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	FVoxelScopedSlowTask Serializing(4.f);
+
+	TArray64<T> Heights;
+	TArray64<uint8> Materials;
+
 	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Serializing heights"));
 	if (Version < FVoxelHeightmapAssetDataVersion::UseTArray64)
 	{
@@ -500,38 +1195,44 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 		Materials.BulkSerialize(Ar);
 	}
 
+	int64 NewWidth;
+	int64 NewHeight;
 	if (Version < FVoxelHeightmapAssetDataVersion::UseTArray64)
 	{
 		int32 Width32;
 		int32 Height32;
 		Ar << Width32;
 		Ar << Height32;
-		Width = Width32;
-		Height = Height32;
+		NewWidth = Width32;
+		NewHeight = Height32;
 	}
 	else
 	{
-		Ar << Width;
-		Ar << Height;
+		Ar << NewWidth;
+		Ar << NewHeight;
 	}
 
-	Ar << MaxHeight;
-	Ar << MinHeight;
+	T NewMaxHeight;
+	T NewMinHeight;
+	Ar << NewMaxHeight;
+	Ar << NewMinHeight;
 
+	EVoxelMaterialConfig NewMaterialConfig = EVoxelMaterialConfig::RGB;
 	if (Version >= FVoxelHeightmapAssetDataVersion::NoVoxelMaterialInHeightmapAssets)
 	{
-		Ar << MaterialConfig;
+		Ar << NewMaterialConfig;
 	}
 
-	if (Width * Height != Heights.Num())
+	if (NewWidth <= 0 || NewHeight <= 0 || NewWidth * NewHeight != Heights.Num())
 	{
 		Ar.SetError();
+		return;
 	}
 
 	if (Materials.Num() > 0)
 	{
 		int64 MaterialSize = 0;
-		switch (MaterialConfig)
+		switch (NewMaterialConfig)
 		{
 		case EVoxelMaterialConfig::RGB:
 			MaterialSize = 4;
@@ -541,7 +1242,7 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 			break;
 		case EVoxelMaterialConfig::DoubleIndex_DEPRECATED:
 			MaterialSize = 0;
-			MaterialConfig = EVoxelMaterialConfig::RGB;
+			NewMaterialConfig = EVoxelMaterialConfig::RGB;
 			Materials.Empty();
 			FVoxelMessages::Error("Cannot load double index heightmap materials, removing them. You'll need to reimport your weightmaps");
 			break;
@@ -550,11 +1251,58 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 			break;
 		default:
 			Ar.SetError();
+			return;
 		}
 
-		if (MaterialSize * Width * Height != Materials.Num())
+		if (MaterialSize * NewWidth * NewHeight != Materials.Num())
 		{
 			Ar.SetError();
+			return;
+		}
+	}
+
+	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Compressing tiles"));
+	{
+		VOXEL_SCOPE_COUNTER("Compressing tiles");
+
+		SetSize(NewWidth, NewHeight, Materials.Num() > 0, NewMaterialConfig);
+		MinHeight = NewMinHeight;
+		MaxHeight = NewMaxHeight;
+
+		const int64 MaterialSize = GetMaterialSize();
+
+		FHeightMip& HeightMip = HeightMips[0];
+		for (int64 TileY = 0; TileY < HeightMip.NumTilesY; TileY++)
+		{
+			for (int64 TileX = 0; TileX < HeightMip.NumTilesX; TileX++)
+			{
+				const TVoxelSharedRef<FTileData> TileData = CreateTileData(0);
+				for (T& TileHeight : TileData->Heights)
+				{
+					TileHeight = DefaultHeight;
+				}
+				FMemory::Memzero(TileData->Materials.GetData(), TileData->Materials.Num());
+
+				const int64 StartX = TileX * TileSize;
+				const int64 StartY = TileY * TileSize;
+				const int64 SizeX = FMath::Min(TileSize, Width - StartX);
+				const int64 SizeY = FMath::Min(TileSize, Height - StartY);
+
+				for (int64 LocalY = 0; LocalY < SizeY; LocalY++)
+				{
+					const int64 Index = StartX + Width * (StartY + LocalY);
+					const int64 IndexInTile = FHeightMip::GetIndexInTile(0, LocalY);
+
+					FMemory::Memcpy(&TileData->Heights[IndexInTile], &Heights[Index], SizeX * sizeof(T));
+					if (bHasMaterials)
+					{
+						FMemory::Memcpy(&TileData->Materials[MaterialSize * IndexInTile], &Materials[MaterialSize * Index], SizeX * MaterialSize);
+					}
+				}
+
+				FScopeLock Lock(&TilesSection);
+				CompressTile(HeightMip.Tiles[TileX + HeightMip.NumTilesX * TileY], *TileData);
+			}
 		}
 	}
 
@@ -565,12 +1313,11 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 
 		const double StartTime = FPlatformTime::Seconds();
 
-		InitializeHeightRangeMips();
 		for (int64 X = 0; X < Width; X++)
 		{
 			for (int64 Y = 0; Y < Height; Y++)
 			{
-				const T LocalHeight = GetHeightUnsafe(X, Y);
+				const T LocalHeight = Heights[X + Width * Y];
 				for (int64 Mip = 0; Mip < GetNumHeightRangeMips(); Mip++)
 				{
 					int64 LocalX;
@@ -586,8 +1333,6 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 
 		const double EndTime = FPlatformTime::Seconds();
 
-		bNeedToSave = true;
-
 		int64 Size = HeightRangeMips.GetAllocatedSize();
 		for (auto& Mip : HeightRangeMips)
 		{
@@ -600,17 +1345,53 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 		Ar << HeightRangeMips;
 	}
 
-	UpdateStats();
+	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Building height mips"));
+	BuildHeightMips();
+
+	// Save in the tiled format
+	bNeedToSave = true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename T>
 void TVoxelHeightmapAssetData<T>::UpdateStats()
 {
-	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, AllocatedSize);
-	AllocatedSize = Heights.GetAllocatedSize() + Materials.GetAllocatedSize() + HeightRangeMips.GetAllocatedSize();
+	FScopeLock Lock(&TilesSection);
+
+	int64 NewAllocatedSize = HeightRangeMips.GetAllocatedSize();
 	for (auto& Mip : HeightRangeMips)
 	{
-		AllocatedSize += Mip.Data.GetAllocatedSize();
+		NewAllocatedSize += Mip.Data.GetAllocatedSize();
+	}
+	for (const FHeightMip& HeightMip : HeightMips)
+	{
+		NewAllocatedSize += HeightMip.Tiles.GetAllocatedSize();
+		for (const FTile& Tile : HeightMip.Tiles)
+		{
+			NewAllocatedSize += Tile.GetCompressedSize();
+		}
+	}
+	for (const FResidentTile& ResidentTile : ResidentTiles)
+	{
+		NewAllocatedSize += HeightMips[ResidentTile.Mip].Tiles[ResidentTile.TileIndex].Data->GetAllocatedSize();
 	}
-	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, AllocatedSize);
-}
\ No newline at end of file
+
+	AddAllocatedSize(NewAllocatedSize - AllocatedSize);
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::AddAllocatedSize(int64 Delta) const
+{
+	if (Delta > 0)
+	{
+		INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, Delta);
+	}
+	else
+	{
+		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, -Delta);
+	}
+	AllocatedSize += Delta;
+}
@@ -48,7 +48,8 @@ public:
 	{
 		if (bInfiniteExtent || WorldBounds.ContainsFloat(X, Y, Z)) // Note: it's safe to access outside the bounds
 		{
-			const float Height = Wrapper.GetHeight(X + Wrapper.GetWidth() / 2, Y + Wrapper.GetHeight() / 2, EVoxelSamplerMode::Clamp);
+			// Use the same mip as GetValues. Goes through the per thread tile cache: no lock unless the tile changed
+			const float Height = Wrapper.GetHeight(X + Wrapper.GetWidth() / 2, Y + Wrapper.GetHeight() / 2, EVoxelSamplerMode::Clamp, Wrapper.GetHeightMip(LOD));
 			return (Z - Height) / Precision;
 		}
 		else
@@ -70,8 +71,17 @@ public:
 
 		const bool bEntirelyContained = WorldBounds.Contains(Bounds);
 
-		const auto XRange = TVoxelRange<v_flt>(Bounds.Min.X, Bounds.Max.X) + Wrapper.GetWidth() / 2;
-		const auto YRange = TVoxelRange<v_flt>(Bounds.Min.Y, Bounds.Max.Y) + Wrapper.GetHeight() / 2;
+		auto XRange = TVoxelRange<v_flt>(Bounds.Min.X, Bounds.Max.X) + Wrapper.GetWidth() / 2;
+		auto YRange = TVoxelRange<v_flt>(Bounds.Min.Y, Bounds.Max.Y) + Wrapper.GetHeight() / 2;
+
+		const int32 HeightMip = Wrapper.GetHeightMip(LOD);
+		if (HeightMip > 0)
+		{
+			// The pixels of a height mip average the neighboring pixels
+			const v_flt Padding = Wrapper.Scale * (1 << HeightMip);
+			XRange = TVoxelRange<v_flt>(XRange.Min - Padding, XRange.Max + Padding);
+			YRange = TVoxelRange<v_flt>(YRange.Min - Padding, YRange.Max + Padding);
+		}
 		const auto ZRange = TVoxelRange<v_flt>(Bounds.Min.Z, Bounds.Max.Z);
 
 		auto HeightRange = TVoxelRange<v_flt>(Wrapper.GetHeightRange(XRange, YRange, EVoxelSamplerMode::Clamp));
@@ -94,11 +104,14 @@ public:
 	}
 	virtual void GetValues(TVoxelQueryZone<FVoxelValue>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const override final
 	{
+		// Coarse LODs sample a downsampled heightmap, and keep the tiles they're using at hand
+		typename TVoxelHeightmapAssetSamplerWrapper<T>::FReader Reader(*Wrapper.Data, Wrapper.GetHeightMip(LOD));
+
 		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
 		{
 			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
 			{
-				const float Height = Wrapper.GetHeight(X + Wrapper.GetWidth() / 2, Y + Wrapper.GetHeight() / 2, EVoxelSamplerMode::Clamp);
+				const float Height = Wrapper.GetHeight(Reader, X + Wrapper.GetWidth() / 2, Y + Wrapper.GetHeight() / 2, EVoxelSamplerMode::Clamp);
 
 				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
 				{
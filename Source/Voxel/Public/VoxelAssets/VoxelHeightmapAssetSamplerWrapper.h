@@ -14,17 +14,39 @@ struct TVoxelHeightmapAssetSamplerWrapper
 	const float HeightOffset;
 	const TVoxelSharedRef<TVoxelHeightmapAssetData<T>> Data;
 
+	using FReader = typename TVoxelHeightmapAssetData<T>::FReader;
+	using FWriter = typename TVoxelHeightmapAssetData<T>::FWriter;
+
 	explicit VOXEL_API TVoxelHeightmapAssetSamplerWrapper(UVoxelHeightmapAsset* Asset);
 
-	float GetHeight(v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode) const
+	// Height mip to use when sampling at this LOD. LOD 0 always uses the full resolution
+	int32 GetHeightMip(int32 LOD) const
 	{
-		return HeightOffset + HeightScale * Data->GetHeight(float(X / Scale), float(Y / Scale), SamplerMode);
+		if (LOD == 0)
+		{
+			return 0;
+		}
+		return Data->GetHeightMip(float(1 << FMath::Min(LOD, 30)) / Scale);
+	}
+
+	float GetHeight(v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode, int32 Mip = 0) const
+	{
+		return HeightOffset + HeightScale * Data->GetHeight(float(X / Scale), float(Y / Scale), SamplerMode, Mip);
 	}
 	FVoxelMaterial GetMaterial(v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode) const
 	{
 		return Data->GetMaterial(float(X / Scale), float(Y / Scale), SamplerMode);
 	}
 
+	float GetHeight(FReader& Reader, v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode) const
+	{
+		return HeightOffset + HeightScale * Reader.GetHeight(float(X / Scale), float(Y / Scale), SamplerMode);
+	}
+	FVoxelMaterial GetMaterial(FReader& Reader, v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode) const
+	{
+		return Reader.GetMaterial(float(X / Scale), float(Y / Scale), SamplerMode);
+	}
+
 	TVoxelRange<float> GetHeightRange(TVoxelRange<v_flt> X, TVoxelRange<v_flt> Y, EVoxelSamplerMode SamplerMode) const
 	{
 		return HeightOffset + HeightScale * TVoxelRange<float>(Data->GetHeightRange(
@@ -35,18 +57,12 @@ struct TVoxelHeightmapAssetSamplerWrapper
 
 	void SetHeight(int32 X, int32 Y, float Height)
 	{
-		ensureVoxelSlowNoSideEffects(Scale == 1.f);
-		Height -= HeightOffset;
-		Height /= HeightScale;
-		Height = FMath::Clamp<float>(Height, TNumericLimits<T>::Lowest(), TNumericLimits<T>::Max());
-		if (TIsSame<T, float>::Value)
-		{
-			Data->SetHeight(X, Y, Height);
-		}
-		else
-		{
-			Data->SetHeight(X, Y, FMath::RoundToInt(Height));
-		}
+		Data->SetHeight(X, Y, ToDataHeight(Height));
+	}
+	// Use when setting many heights
+	void SetHeight(FWriter& Writer, int32 X, int32 Y, float Height)
+	{
+		Writer.SetHeight(X, Y, ToDataHeight(Height));
 	}
 
 	float GetMinHeight() const
@@ -66,4 +82,21 @@ struct TVoxelHeightmapAssetSamplerWrapper
 	{
 		return Scale * Data->GetHeight();
 	}
+
+private:
+	T ToDataHeight(float Height) const
+	{
+		ensureVoxelSlowNoSideEffects(Scale == 1.f);
+		Height -= HeightOffset;
+		Height /= HeightScale;
+		Height = FMath::Clamp<float>(Height, TNumericLimits<T>::Lowest(), TNumericLimits<T>::Max());
+		if (TIsSame<T, float>::Value)
+		{
+			return Height;
+		}
+		else
+		{
+			return FMath::RoundToInt(Height);
+		}
+	}
 };
\ No newline at end of file
@@ -15,6 +15,8 @@ class VOXEL_API UVoxelChunkGenerator : public UVoxelGenerator
 public:
 	//~ Begin UVoxelGenerator Interface
 	virtual TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance() override;
+	// Instances use the chunks of their runtime
+	virtual bool CanShareInstances() const override { return false; }
 	//~ End UVoxelGenerator Interface
 };
 
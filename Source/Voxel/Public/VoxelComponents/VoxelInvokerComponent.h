@@ -61,12 +61,18 @@ public:
 	FVoxelInvokerSettings GetInvokerSettings(AVoxelWorld* VoxelWorld) const;
 	FVoxelInvokerSettings GetInvokerSettings(const AVoxelWorld* VoxelWorld) const;
 
+	// In cm/s. Used to prefetch the data and the chunks along the predicted path of the invoker, see voxel.lod.InvokerPredictionTime
+	// Defaults to GetOwner()->GetVelocity()
+	UFUNCTION(BlueprintNativeEvent, Category = "Voxel|Invoker")
+	FVector GetInvokerVelocity() const;
+
 public:
 	//~ Begin UVoxelInvokerComponentBase Interface
 	virtual bool IsLocalInvoker_Implementation() const;
 	virtual bool ShouldUseInvoker_Implementation(AVoxelWorld* VoxelWorld) const;
 	virtual FIntVector GetInvokerVoxelPosition_Implementation(AVoxelWorld* VoxelWorld) const;
 	virtual FVoxelInvokerSettings GetInvokerSettings_Implementation(AVoxelWorld* VoxelWorld) const;
+	virtual FVector GetInvokerVelocity_Implementation() const;
 	//~ End UVoxelInvokerComponentBase Interface
 
 protected:
@@ -205,8 +205,14 @@ public:
 
 	// Requires read lock
 	TVoxelRange<FVoxelValue> GetValueRange(const FVoxelIntBox& Bounds, int32 LOD) const;
+	// Range of the generator & assets values of Tree in Bounds, ignoring any edit. Bounds must be inside Tree
+	TVoxelRange<FVoxelValue> GetGeneratorValueRange(const FVoxelDataOctreeBase& Tree, const FVoxelIntBox& Bounds, int32 LOD) const;
 
 	bool IsEmpty(const FVoxelIntBox& Bounds, int32 LOD) const;
+	// Slower but tighter version of IsEmpty, for when range analysis is too loose
+	// Samples the generator on an adaptive lattice, and uses the generator Lipschitz constant to prove that there's no surface between the samples
+	// Conservative: returns false if the generator has no Lipschitz constant, or if there are edits or items in Bounds. Requires read lock
+	bool IsEmptyFromSamples(const FVoxelIntBox& Bounds, int32 LOD) const;
 
 	template<typename T>
 	T GetCustomOutput(T DefaultValue, FName Name, v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelGeneratorQueryData& QueryData = FVoxelGeneratorQueryData::Empty) const;
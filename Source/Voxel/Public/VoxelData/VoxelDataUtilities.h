@@ -89,12 +89,30 @@ namespace FVoxelDataUtilities
 	template<typename T, typename F>
 	void IterateDirtyDataInBounds(const FVoxelData& Data, const FVoxelIntBox& Bounds, F Lambda);
 
+	/**
+	 * Leaf-aware iteration of the values in Bounds
+	 * Lambda(Block, Range) is called with the range of the values of each block of Bounds:
+	 * if Range.IsSingleValue(), every value in Block is equal to it and there's no need to query them
+	 * Blocks are aligned on the leaves. Nodes that were never created are passed in one go if their generator range is a single value
+	 * Single value leaves & generator range analysis are used. Dirty leaves & data outside of the world have an infinite range
+	 * Requires read lock in Bounds. If bMultiThreaded, Lambda must be thread safe
+	 */
+	template<typename F>
+	void IterateValueRangesInBounds(const FVoxelData& Data, const FVoxelIntBox& Bounds, F Lambda, bool bMultiThreaded = false);
+
+	// Same as FVoxelData::Get, but blocks with a single value are filled directly instead of being queried. Requires read lock
+	TVoxelArrayFwd<FVoxelValue> GetValuesUsingRanges(const FVoxelData& Data, const FVoxelIntBox& Bounds, bool bMultiThreaded = false);
+
 	template<typename T>
 	void ClearData(FVoxelData& Data);
 
 	template<typename T>
 	bool HasData(FVoxelData& Data);
 
+	// Returns true if the generator & assets values are all the same in Leaf, ignoring any edit
+	bool GetGeneratorSingleValue(const FVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, FVoxelValue& OutValue);
+	bool GetGeneratorSingleValue(const FVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, FVoxelMaterial& OutValue);
+
 	template<typename T>
 	bool CheckIfSameAsGenerator(const FVoxelData& Data, FVoxelDataOctreeLeaf& Leaf);
 
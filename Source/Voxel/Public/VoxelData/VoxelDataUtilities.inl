@@ -6,6 +6,7 @@
 #include "VoxelData/VoxelDataUtilities.h"
 #include "VoxelData/VoxelDataAccelerator.h"
 #include "VoxelFeedbackContext.h"
+#include "Async/ParallelFor.h"
 
 template<typename T, typename TData>
 FVector FVoxelDataUtilities::GetGradientFromGetValue(const TData& Data, T X, T Y, T Z, int32 LOD, T Offset)
@@ -61,6 +62,132 @@ void FVoxelDataUtilities::IterateDirtyDataInBounds(const FVoxelData& Data, const
 	});
 }
 
+template<typename F>
+void FVoxelDataUtilities::IterateValueRangesInBounds(const FVoxelData& Data, const FVoxelIntBox& Bounds, F Lambda, bool bMultiThreaded)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	struct FBlock
+	{
+		FVoxelIntBox Bounds;
+		// Null if outside of the world
+		const FVoxelDataOctreeBase* Tree = nullptr;
+		TOptional<TVoxelRange<FVoxelValue>> Range;
+	};
+	TArray<FBlock> Blocks;
+	
+	if (!Data.WorldBounds.Contains(Bounds))
+	{
+		// Queries are clamped to the world bounds, can't use the octree there
+		for (const FVoxelIntBox& OutsideBounds : Bounds.Difference(Data.WorldBounds))
+		{
+			Blocks.Add({ OutsideBounds });
+		}
+	}
+
+	if (Data.WorldBounds.Intersect(Bounds))
+	{
+		const FVoxelIntBox InWorldBounds = Data.WorldBounds.Overlap(Bounds);
+		FVoxelOctreeUtilities::IterateTreeInBounds(Data.GetOctree(), InWorldBounds, [&](const FVoxelDataOctreeBase& Tree)
+		{
+			if (!Tree.IsLeaf() && Tree.AsParent().HasChildren())
+			{
+				return;
+			}
+			
+			const FVoxelIntBox TreeBounds = Tree.GetBounds().Overlap(InWorldBounds);
+			if (Tree.IsLeaf())
+			{
+				Blocks.Add({ TreeBounds, &Tree });
+				return;
+			}
+
+			// Node that was never created: only the generator & assets, try to handle it in one go
+			const TVoxelRange<FVoxelValue> Range = Data.GetGeneratorValueRange(Tree, TreeBounds, 0);
+			if (Range.IsSingleValue())
+			{
+				Blocks.Add({ TreeBounds, &Tree, Range });
+				return;
+			}
+			
+			TArray<FVoxelIntBox> Children;
+			TreeBounds.Subdivide(DATA_CHUNK_SIZE, Children);
+			for (const FVoxelIntBox& Child : Children)
+			{
+				Blocks.Add({ Child.Overlap(TreeBounds), &Tree });
+			}
+		});
+	}
+
+	ParallelFor(Blocks.Num(), [&](int32 Index)
+	{
+		const FBlock& Block = Blocks[Index];
+		
+		TVoxelRange<FVoxelValue> Range = TVoxelRange<FVoxelValue>::Infinite();
+		if (Block.Range.IsSet())
+		{
+			Range = Block.Range.GetValue();
+		}
+		else if (Block.Tree)
+		{
+			if (Block.Tree->IsLeaf())
+			{
+				ensureThreadSafe(Block.Tree->AsLeaf().IsLockedForRead());
+				
+				auto& DataHolder = Block.Tree->AsLeaf().GetData<FVoxelValue>();
+				if (DataHolder.IsSingleValue())
+				{
+					Range = TVoxelRange<FVoxelValue>(DataHolder.GetSingleValue());
+				}
+				else if (!DataHolder.IsDirty())
+				{
+					Range = Data.GetGeneratorValueRange(*Block.Tree, Block.Bounds, 0);
+				}
+			}
+			else
+			{
+				Range = Data.GetGeneratorValueRange(*Block.Tree, Block.Bounds, 0);
+			}
+		}
+		
+		Lambda(Block.Bounds, Range);
+	}, !bMultiThreaded);
+}
+
+inline TVoxelArrayFwd<FVoxelValue> FVoxelDataUtilities::GetValuesUsingRanges(const FVoxelData& Data, const FVoxelIntBox& Bounds, bool bMultiThreaded)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	TVoxelArrayFwd<FVoxelValue> Result;
+	Result.SetNumUninitialized(Bounds.Count());
+	TVoxelQueryZone<FVoxelValue> QueryZone(Bounds, Result);
+
+	IterateValueRangesInBounds(Data, Bounds, [&](const FVoxelIntBox& Block, const TVoxelRange<FVoxelValue>& Range)
+	{
+		auto LocalQueryZone = QueryZone.ShrinkTo(Block);
+		if (Range.IsSingleValue())
+		{
+			const FVoxelValue Value = Range.GetSingleValue();
+			for (VOXEL_QUERY_ZONE_ITERATE(LocalQueryZone, X))
+			{
+				for (VOXEL_QUERY_ZONE_ITERATE(LocalQueryZone, Y))
+				{
+					for (VOXEL_QUERY_ZONE_ITERATE(LocalQueryZone, Z))
+					{
+						LocalQueryZone.Set(X, Y, Z, Value);
+					}
+				}
+			}
+		}
+		else
+		{
+			Data.Get(LocalQueryZone, 0);
+		}
+	}, bMultiThreaded);
+
+	return Result;
+}
+
 template<typename T>
 void FVoxelDataUtilities::ClearData(FVoxelData& Data)
 {
@@ -81,6 +208,24 @@ bool FVoxelDataUtilities::HasData(FVoxelData& Data)
 	});
 }
 
+inline bool FVoxelDataUtilities::GetGeneratorSingleValue(const FVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, FVoxelValue& OutValue)
+{
+	const TVoxelRange<FVoxelValue> Range = Data.GetGeneratorValueRange(Leaf, Leaf.GetBounds(), 0);
+	if (!Range.IsSingleValue())
+	{
+		return false;
+	}
+	
+	OutValue = Range.GetSingleValue();
+	return true;
+}
+
+inline bool FVoxelDataUtilities::GetGeneratorSingleValue(const FVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, FVoxelMaterial& OutValue)
+{
+	// No range analysis for materials
+	return false;
+}
+
 template<typename T>
 bool FVoxelDataUtilities::CheckIfSameAsGenerator(const FVoxelData& Data, FVoxelDataOctreeLeaf& Leaf)
 {
@@ -91,6 +236,22 @@ bool FVoxelDataUtilities::CheckIfSameAsGenerator(const FVoxelData& Data, FVoxelD
 	if (!ensure(DataHolder.IsDirty())) return false;
 
 	const FIntVector Min = Leaf.GetMin();
+
+	// If the generator is uniform in this leaf, compare against its value without querying it for every voxel
+	T GeneratorSingleValue;
+	if (GetGeneratorSingleValue(Data, Leaf, GeneratorSingleValue))
+	{
+		for (int32 Index = 0; Index < VOXELS_PER_DATA_CHUNK; Index++)
+		{
+			if (DataHolder.Get(Index) != GeneratorSingleValue)
+			{
+				return false;
+			}
+		}
+		
+		DataHolder.SetIsDirty(false, Data);
+		return true;
+	}
 	
 	// Note: check if single value too, as else we end up with the save file being big because of single values!
 	// 1024 x 1024 x 1024 world -> 32k possible single values! Ends up being a lot as you store 14 bytes per value
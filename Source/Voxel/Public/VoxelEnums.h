@@ -214,6 +214,12 @@ enum class EVoxelTaskType : uint8
 	// The render octree is used to determine the LODs to display
 	// Should be done as fast as possible to start meshing tasks 
 	RenderOctree,
+	// Meshing of chunks that need to be updated because of an edit
+	// These tasks are scheduled in the thread pool low latency lane, before any other task
+	EditChunksMeshing,
+	// Speculative caching of the data along the predicted path of the invokers
+	// Lowest priority: only done when there is nothing else to do
+	InvokersPrefetch,
 	
 	Max UMETA(Hidden)
 };
@@ -0,0 +1,158 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+
+// Set of chunk positions, stored as a sparse bitset of 8x8x8 regions
+// Much more compact than a TSet<FIntVector> for the dense spheres of chunks around invokers
+class FVoxelEventChunkSet
+{
+public:
+	FVoxelEventChunkSet() = default;
+
+	FORCEINLINE int32 Num() const
+	{
+		return NumChunks;
+	}
+	FORCEINLINE uint32 GetAllocatedSize() const
+	{
+		return Regions.GetAllocatedSize();
+	}
+	FORCEINLINE void Reset()
+	{
+		Regions.Reset();
+		NumChunks = 0;
+	}
+
+	FORCEINLINE bool Contains(const FIntVector& Chunk) const
+	{
+		const FRegion* Region = Regions.Find(GetRegionKey(Chunk));
+		if (!Region)
+		{
+			return false;
+		}
+
+		int32 WordIndex;
+		uint64 Mask;
+		GetWordIndexAndMask(Chunk, WordIndex, Mask);
+		return Region->Words[WordIndex] & Mask;
+	}
+	// Returns true if the chunk wasn't already in the set
+	FORCEINLINE bool Add(const FIntVector& Chunk)
+	{
+		FRegion& Region = Regions.FindOrAdd(GetRegionKey(Chunk));
+
+		int32 WordIndex;
+		uint64 Mask;
+		GetWordIndexAndMask(Chunk, WordIndex, Mask);
+
+		uint64& Word = Region.Words[WordIndex];
+		if (Word & Mask)
+		{
+			return false;
+		}
+
+		Word |= Mask;
+		Region.Num++;
+		NumChunks++;
+		return true;
+	}
+	// Returns true if the chunk was in the set
+	FORCEINLINE bool Remove(const FIntVector& Chunk)
+	{
+		const FIntVector RegionKey = GetRegionKey(Chunk);
+		FRegion* Region = Regions.Find(RegionKey);
+		if (!Region)
+		{
+			return false;
+		}
+
+		int32 WordIndex;
+		uint64 Mask;
+		GetWordIndexAndMask(Chunk, WordIndex, Mask);
+
+		uint64& Word = Region->Words[WordIndex];
+		if (!(Word & Mask))
+		{
+			return false;
+		}
+
+		Word &= ~Mask;
+		NumChunks--;
+		if (--Region->Num == 0)
+		{
+			Regions.Remove(RegionKey);
+		}
+		return true;
+	}
+
+public:
+	template<typename T>
+	void Iterate(T Lambda) const
+	{
+		for (const auto& It : Regions)
+		{
+			IterateWords(It.Key, It.Value.Words, Lambda);
+		}
+	}
+
+	// Iterate the chunks that are in A but not in B
+	template<typename T>
+	static void IterateDifference(const FVoxelEventChunkSet& A, const FVoxelEventChunkSet& B, T Lambda)
+	{
+		for (const auto& It : A.Regions)
+		{
+			const FRegion* OtherRegion = B.Regions.Find(It.Key);
+			if (!OtherRegion)
+			{
+				IterateWords(It.Key, It.Value.Words, Lambda);
+				continue;
+			}
+
+			uint64 Words[8];
+			for (int32 WordIndex = 0; WordIndex < 8; WordIndex++)
+			{
+				Words[WordIndex] = It.Value.Words[WordIndex] & ~OtherRegion->Words[WordIndex];
+			}
+			IterateWords(It.Key, Words, Lambda);
+		}
+	}
+
+private:
+	struct FRegion
+	{
+		// Word X, bit Z + 8 * Y
+		uint64 Words[8] = {};
+		int32 Num = 0;
+	};
+	TMap<FIntVector, FRegion> Regions;
+	int32 NumChunks = 0;
+
+	FORCEINLINE static FIntVector GetRegionKey(const FIntVector& Chunk)
+	{
+		return FIntVector(Chunk.X >> 3, Chunk.Y >> 3, Chunk.Z >> 3);
+	}
+	FORCEINLINE static void GetWordIndexAndMask(const FIntVector& Chunk, int32& OutWordIndex, uint64& OutMask)
+	{
+		OutWordIndex = Chunk.X & 7;
+		OutMask = uint64(1) << ((Chunk.Z & 7) + 8 * (Chunk.Y & 7));
+	}
+
+	template<typename T>
+	FORCEINLINE static void IterateWords(const FIntVector& RegionKey, const uint64 (&Words)[8], T& Lambda)
+	{
+		const FIntVector RegionMin = RegionKey * 8;
+		for (int32 WordIndex = 0; WordIndex < 8; WordIndex++)
+		{
+			uint64 Word = Words[WordIndex];
+			while (Word)
+			{
+				const int32 Bit = FMath::CountTrailingZeros64(Word);
+				Word &= Word - 1;
+				Lambda(RegionMin + FIntVector(WordIndex, Bit / 8, Bit % 8));
+			}
+		}
+	}
+};
@@ -5,11 +5,14 @@
 #include "CoreMinimal.h"
 #include "VoxelTickable.h"
 #include "VoxelSubsystem.h"
+#include "VoxelAsyncWork.h"
+#include "VoxelEvents/VoxelEventChunkSet.h"
 #include "VoxelEventManager.generated.h"
 
 struct FVoxelChunkMesh;
 class AVoxelWorld;
 class UVoxelInvokerComponentBase;
+class FVoxelEventsAsyncUpdater;
 
 DECLARE_DELEGATE_OneParam(FChunkDelegate, const FVoxelIntBox&);
 DECLARE_MULTICAST_DELEGATE_OneParam(FChunkMulticastDelegate, const FVoxelIntBox&);
@@ -86,10 +89,10 @@ public:
 		if (auto* EventPtr = Events.Find(Key))
 		{
 			auto& Event = **EventPtr;
-			for (auto& P : Event.ActiveOrGeneratedChunks)
+			Event.ActiveOrGeneratedChunks.Iterate([&](const FIntVector& P)
 			{
 				Lambda(FVoxelIntBox(P * Event.ChunkSize, (P + 1) * Event.ChunkSize));
-			}
+			});
 		}
 	}
 
@@ -141,15 +144,18 @@ private:
 	};
 	struct FEventInfo
 	{
+		// Unique id, used to match the async updates with the event
+		const uint64 Id;
 		const int32 ChunkSize;
 		const int32 DistanceInChunks;
 		const uint32 Flags;
 		FChunkMulticastDelegate OnActivate;
 		FChunkMulticastDelegate OnDeactivate;
-		TSet<FIntVector> ActiveOrGeneratedChunks; // If generation event this is the list of already generated chunks
+		FVoxelEventChunkSet ActiveOrGeneratedChunks; // If generation event this is the list of already generated chunks
 
-		FEventInfo(int32 ChunkSize, int32 Distance, uint32 Flags)
-			: ChunkSize(ChunkSize)
+		FEventInfo(uint64 Id, int32 ChunkSize, int32 Distance, uint32 Flags)
+			: Id(Id)
+			, ChunkSize(ChunkSize)
 			, DistanceInChunks(Distance)
 			, Flags(Flags)
 		{
@@ -164,11 +170,20 @@ private:
 	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> OldInvokerComponents;
 	TMap<FEventKey, TArray<FEventInvoker>> EventsInvokers;
 	TMap<FEventKey, TUniquePtr<FEventInfo>> Events;
+	uint64 EventIdCounter = 0;
+
+	// Computes the chunks entering or leaving the invokers range. Only the delegates are fired on the game thread
+	TVoxelAsyncWorkPtr<FVoxelEventsAsyncUpdater> Task;
+	bool bAsyncTaskWorking = false;
+	// Events removed since the last task was started, so that it can free their state
+	TArray<uint64> RemovedEventIds;
 
 	void Update();
-	void UpdateInvokers(const TArray<TPair<FEventKey, TArray<FIntVector>>>& InvokersToUpdate);
+	void FireDelegates();
 	void ClearOldInvokerComponents();
 
+	friend class FVoxelEventsAsyncUpdater;
+
 private:
 	uint32 EventsAllocatedSize = 0;
 	uint32 NumEvents = 0;
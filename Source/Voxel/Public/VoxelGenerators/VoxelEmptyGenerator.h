@@ -73,5 +73,6 @@ public:
 	{
 		return MakeVoxelShared<FVoxelTransformableEmptyGeneratorInstance>();
 	}
+	bool CanShareInstances() const override { return true; }
 	//~ End UVoxelGenerator Interface
 };
\ No newline at end of file
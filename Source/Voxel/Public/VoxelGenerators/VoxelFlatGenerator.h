@@ -57,6 +57,7 @@ public:
 		
 	//~ Begin UVoxelGenerator Interface
 	TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance() override;
+	bool CanShareInstances() const override { return true; }
 	//~ End UVoxelGenerator Interface
 };
 
@@ -130,6 +131,11 @@ public:
 	{
 		return FVector::UpVector;
 	}
+	virtual bool GetValueLipschitzConstant(const FVoxelIntBox& Bounds, int32 LOD, v_flt& OutLipschitz) const override final
+	{
+		OutLipschitz = 1;
+		return true;
+	}
 	//~ End FVoxelGeneratorInstance Interface
 };
 
@@ -35,6 +35,10 @@ public:
 	virtual TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance();
 
 	virtual FVoxelGeneratorOutputs GetGeneratorOutputs() const;
+
+	// If true, users with the same parameters share a single instance. Only return true if the instances don't use the world or runtime of their FVoxelGeneratorInit
+	// See FVoxelGeneratorInstanceCache
+	virtual bool CanShareInstances() const { return false; }
 	//~ End UVoxelGenerator Interface
 
 protected:
@@ -20,6 +20,9 @@
  * {
  *     return { Min, Max }; // Replace this by the possible values in Bounds
  * }
+ *
+ * Optionally, to batch the transformed queries when placed as an asset:
+ * void GetValuesAlongLine(const FVoxelVector& Start, const FVoxelVector& Delta, int32 Num, int32 LOD, const FVoxelItemStack& Items, v_flt* RESTRICT OutValues) const
  */
 template<
 	typename TWorldInstance, 
@@ -34,6 +37,7 @@ public:
 
 	using FVoxelGeneratorInstance::TOutputFunctionPtr;
 	using FVoxelGeneratorInstance::TRangeOutputFunctionPtr;
+	using FVoxelGeneratorInstance::TQueryZoneOutputFunctionPtr;
 
 	using FVoxelGeneratorInstance::FBaseFunctionPtrs;
 	using FVoxelGeneratorInstance::FCustomFunctionPtrs;
@@ -84,6 +88,17 @@ public:
 			}
 		}
 	}
+
+	// Values at Start + Delta * Index, for Index in [0, Num)
+	// Used by the transformed queries of TVoxelTransformableGeneratorHelper. Hide it in TWorldInstance to batch the sampling
+	void GetValuesAlongLine(const FVoxelVector& Start, const FVoxelVector& Delta, int32 Num, int32 LOD, const FVoxelItemStack& Items, v_flt* RESTRICT OutValues) const
+	{
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const FVoxelVector Position = Start + Delta * Index;
+			OutValues[Index] = This().GetValueImpl(Position.X, Position.Y, Position.Z, LOD, Items);
+		}
+	}
 	
 private:
 	inline const TWorldInstance& This() const
@@ -122,6 +137,7 @@ public:
 	
 	using FVoxelGeneratorInstance::TOutputFunctionPtr;
 	using FVoxelGeneratorInstance::TRangeOutputFunctionPtr;
+	using FVoxelGeneratorInstance::TQueryZoneOutputFunctionPtr;
 	
 	using FVoxelTransformableGeneratorInstance::TOutputFunctionPtr_Transform;
 	using FVoxelTransformableGeneratorInstance::TRangeOutputFunctionPtr_Transform;
@@ -29,6 +29,9 @@ public:
 	
 	template<typename T>
 	using TRangeOutputFunctionPtr = TVoxelRange<T>(FVoxelGeneratorInstance::*)(const FVoxelIntBox& Bounds, int32 LOD, const FVoxelItemStack& Items) const;
+
+	template<typename T>
+	using TQueryZoneOutputFunctionPtr = void(FVoxelGeneratorInstance::*)(TVoxelQueryZone<T>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const;
 	
 	struct FBaseFunctionPtrs
 	{
@@ -43,6 +46,24 @@ public:
 		TMap<FName, TOutputFunctionPtr<FColor>> Color;
 		
 		TMap<FName, TRangeOutputFunctionPtr<v_flt>> FloatRange;
+
+		// Optional, queries a whole zone at once. If not set, the outputs above are called for every voxel
+		TMap<FName, TQueryZoneOutputFunctionPtr<v_flt>> FloatQueryZone;
+		TMap<FName, TQueryZoneOutputFunctionPtr<int32>> IntQueryZone;
+		TMap<FName, TQueryZoneOutputFunctionPtr<FColor>> ColorQueryZone;
+	};
+
+	// A custom output resolved by GetCustomOutputHandle, to avoid looking it up by name on every query
+	template<typename T>
+	struct TCustomOutputHandle
+	{
+		TOutputFunctionPtr<T> Ptr = nullptr;
+		TQueryZoneOutputFunctionPtr<T> QueryZonePtr = nullptr;
+
+		bool IsValid() const
+		{
+			return Ptr != nullptr;
+		}
 	};
 
 public:
@@ -75,6 +96,8 @@ public:
 	const TMap<FName, TOutputFunctionPtr<T>>& GetOutputsPtrMap() const;
 	template<typename T>
 	const TMap<FName, TRangeOutputFunctionPtr<T>>& GetOutputsRangesPtrMap() const;
+	template<typename T>
+	const TMap<FName, TQueryZoneOutputFunctionPtr<T>>& GetOutputsQueryZonePtrMap() const;
 
 public:
 	//~ Begin FVoxelGeneratorInstance Interface
@@ -98,6 +121,11 @@ public:
 
 	// World up vector at position (must be normalized). Used for foliage
 	virtual FVector GetUpVector(v_flt X, v_flt Y, v_flt Z) const = 0;
+
+	// Max value change per voxel in Bounds, ie |Value(A) - Value(B)| <= OutLipschitz * |A - B|, ignoring items
+	// Lets chunks without surface be skipped from a few samples when range analysis is too loose
+	// Must never be underestimated, else surfaces will be missed. Return false if unknown
+	virtual bool GetValueLipschitzConstant(const FVoxelIntBox& Bounds, int32 LOD, v_flt& OutLipschitz) const { return false; }
 	//~ End FVoxelGeneratorInstance Interface
 	
 public:
@@ -121,6 +149,17 @@ public:
 	T GetCustomOutput(T DefaultValue, FName Name, const U& P, int32 LOD, const FVoxelItemStack& Items) const;
 	template<typename T>
 	TVoxelRange<T> GetCustomOutputRange(TVoxelRange<T> DefaultValue, FName Name, const FVoxelIntBox& Bounds, int32 LOD, const FVoxelItemStack& Items) const;
+
+	// Resolve the output once, and use the handle for all the following queries
+	// If the output doesn't exist, the handle is invalid and the queries return DefaultValue
+	template<typename T>
+	TCustomOutputHandle<T> GetCustomOutputHandle(FName Name) const;
+	template<typename T>
+	T GetCustomOutput(T DefaultValue, const TCustomOutputHandle<T>& Handle, v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const;
+	template<typename T>
+	void GetCustomOutputs(T DefaultValue, const TCustomOutputHandle<T>& Handle, TVoxelQueryZone<T>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const;
+	template<typename T>
+	void GetCustomOutputs(T DefaultValue, const TCustomOutputHandle<T>& Handle, TArrayView<const FVoxelVector> Positions, TArrayView<T> OutValues, int32 LOD, const FVoxelItemStack& Items) const;
 };
 
 class VOXEL_API FVoxelTransformableGeneratorInstance : public FVoxelGeneratorInstance
@@ -51,6 +51,75 @@ FORCEINLINE TVoxelRange<T> FVoxelGeneratorInstance::GetCustomOutputRange(TVoxelR
 
 ///////////////////////////////////////////////////////////////////////////////
 
+template<typename T>
+FORCEINLINE FVoxelGeneratorInstance::TCustomOutputHandle<T> FVoxelGeneratorInstance::GetCustomOutputHandle(FName Name) const
+{
+	TCustomOutputHandle<T> Handle;
+	Handle.Ptr = GetOutputsPtrMap<T>().FindRef(Name);
+	if (Handle.Ptr)
+	{
+		Handle.QueryZonePtr = GetOutputsQueryZonePtrMap<T>().FindRef(Name);
+	}
+	return Handle;
+}
+
+template<typename T>
+FORCEINLINE T FVoxelGeneratorInstance::GetCustomOutput(T DefaultValue, const TCustomOutputHandle<T>& Handle, v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const
+{
+	if (Handle.Ptr)
+	{
+		return (this->*Handle.Ptr)(X, Y, Z, LOD, Items);
+	}
+	else
+	{
+		return DefaultValue;
+	}
+}
+
+template<typename T>
+void FVoxelGeneratorInstance::GetCustomOutputs(T DefaultValue, const TCustomOutputHandle<T>& Handle, TVoxelQueryZone<T>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const
+{
+	if (Handle.QueryZonePtr)
+	{
+		(this->*Handle.QueryZonePtr)(QueryZone, LOD, Items);
+		return;
+	}
+
+	for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
+	{
+		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
+			{
+				QueryZone.Set(X, Y, Z, GetCustomOutput<T>(DefaultValue, Handle, X, Y, Z, LOD, Items));
+			}
+		}
+	}
+}
+
+template<typename T>
+void FVoxelGeneratorInstance::GetCustomOutputs(T DefaultValue, const TCustomOutputHandle<T>& Handle, TArrayView<const FVoxelVector> Positions, TArrayView<T> OutValues, int32 LOD, const FVoxelItemStack& Items) const
+{
+	check(Positions.Num() == OutValues.Num());
+
+	if (!Handle.Ptr)
+	{
+		for (T& Value : OutValues)
+		{
+			Value = DefaultValue;
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < Positions.Num(); Index++)
+	{
+		const FVoxelVector& Position = Positions[Index];
+		OutValues[Index] = (this->*Handle.Ptr)(Position.X, Position.Y, Position.Z, LOD, Items);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename T>
 FORCEINLINE T FVoxelTransformableGeneratorInstance::GetCustomOutput_Transform(const FTransform& LocalToWorld, T DefaultValue, FName Name, v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const
 {
@@ -230,6 +299,24 @@ FORCEINLINE const TMap<FName, FVoxelGeneratorInstance::TRangeOutputFunctionPtr<v
 	return CustomPtrs.FloatRange;
 }
 
+template<>
+FORCEINLINE const TMap<FName, FVoxelGeneratorInstance::TQueryZoneOutputFunctionPtr<v_flt>>& FVoxelGeneratorInstance::GetOutputsQueryZonePtrMap<v_flt>() const
+{
+	return CustomPtrs.FloatQueryZone;
+}
+
+template<>
+FORCEINLINE const TMap<FName, FVoxelGeneratorInstance::TQueryZoneOutputFunctionPtr<int32>>& FVoxelGeneratorInstance::GetOutputsQueryZonePtrMap<int32>() const
+{
+	return CustomPtrs.IntQueryZone;
+}
+
+template<>
+FORCEINLINE const TMap<FName, FVoxelGeneratorInstance::TQueryZoneOutputFunctionPtr<FColor>>& FVoxelGeneratorInstance::GetOutputsQueryZonePtrMap<FColor>() const
+{
+	return CustomPtrs.ColorQueryZone;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 template<>
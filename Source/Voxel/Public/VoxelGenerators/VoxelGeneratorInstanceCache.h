@@ -0,0 +1,31 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+#include "VoxelGenerators/VoxelGeneratorInit.h"
+#include "VoxelGenerators/VoxelGeneratorPicker.h"
+
+/**
+ * Process-wide cache of the generator instances, shared by all the voxel worlds, asset actors & data items
+ * Instances are keyed by generator & parameters, and by the settings of FVoxelGeneratorInit they can depend on:
+ * memory & init cost are paid once for all the worlds using the same generator
+ * Entries are weak: instances are freed as soon as nobody is using them anymore
+ * Thread safe
+ */
+class VOXEL_API FVoxelGeneratorInstanceCache
+{
+public:
+	static bool IsEnabled();
+
+	// Returns a shared instance already initialized with compatible settings, or creates & inits a new one
+	static TVoxelSharedRef<FVoxelGeneratorInstance> GetInstance(const FVoxelGeneratorPicker& Picker, const FVoxelGeneratorInit& Init);
+	static TVoxelSharedRef<FVoxelTransformableGeneratorInstance> GetInstance(const FVoxelTransformableGeneratorPicker& Picker, const FVoxelGeneratorInit& Init);
+
+	// Following calls will create new instances. Existing ones are left untouched
+	// Must be called when the generator data changes without its properties changing, eg when saving the data of an asset
+	static void Invalidate(const UObject* Generator);
+	static void Clear();
+	static void LogStats();
+};
@@ -0,0 +1,34 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+#include "VoxelVector.h"
+
+/**
+ * Local positions of the voxels of a transformed query zone
+ * Transforms are affine: the local position of a voxel is the one of the zone origin plus a combination of the local steps,
+ * which is exact and much cheaper than inverse transforming every voxel
+ */
+struct FVoxelTransformStepper
+{
+	FVoxelVector Origin;
+	FVoxelVector StepX;
+	FVoxelVector StepY;
+	FVoxelVector StepZ;
+
+	FVoxelTransformStepper(const FTransform& LocalToWorld, const FIntVector& WorldOrigin, int32 Step)
+		: Origin(LocalToWorld.InverseTransformPosition(FVector(WorldOrigin)))
+		, StepX(LocalToWorld.InverseTransformVector(FVector(Step, 0, 0)))
+		, StepY(LocalToWorld.InverseTransformVector(FVector(0, Step, 0)))
+		, StepZ(LocalToWorld.InverseTransformVector(FVector(0, 0, Step)))
+	{
+	}
+
+	// Indices are in steps. Start of the rows is computed directly to not accumulate errors across rows
+	FORCEINLINE FVoxelVector Get(int32 IndexX, int32 IndexY, int32 IndexZ = 0) const
+	{
+		return Origin + StepX * IndexX + StepY * IndexY + StepZ * IndexZ;
+	}
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "VoxelUtilities/VoxelRangeUtilities.h"
 #include "VoxelGenerators/VoxelGeneratorHelpers.h"
+#include "VoxelGenerators/VoxelTransformStepper.h"
 
 template<typename T, typename TObject = typename T::UStaticClass>
 class TVoxelTransformableGeneratorHelper : public TVoxelTransformableGeneratorInstanceHelper<TVoxelTransformableGeneratorHelper<T, TObject>, TObject>
@@ -49,6 +50,48 @@ public:
 		}
 	}
 	
+	virtual void GetValues_Transform(const FTransform& LocalToWorld, TVoxelQueryZone<FVoxelValue>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const override
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		// Step the local positions along the Z rows instead of inverse transforming every voxel,
+		// and let the generator sample the whole row at once
+		const int32 Step = QueryZone.Step;
+		const FIntVector Min = QueryZone.Bounds.Min;
+		const FVoxelTransformStepper Stepper(LocalToWorld, Min, Step);
+		const int32 NumZ = QueryZone.Bounds.Size().Z / Step;
+		const FVoxelValue BestValue = bSubtractiveAsset ? FVoxelValue::Empty() : FVoxelValue::Full();
+
+		TArray<v_flt, TInlineAllocator<128>> RowValues;
+		RowValues.SetNumUninitialized(NumZ);
+
+		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
+			{
+				const FVoxelVector RowStart = Stepper.Get((X - Min.X) / Step, (Y - Min.Y) / Step);
+				Generator->GetValuesAlongLine(RowStart, Stepper.StepZ, NumZ, LOD, Items, RowValues.GetData());
+
+				int32 IndexZ = 0;
+				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
+				{
+					const v_flt Value = RowValues[IndexZ++];
+					if (Items.IsEmpty() || FVoxelValue(Value) == BestValue)
+					{
+						// No need to merge as we are the best value possible
+						QueryZone.Set(X, Y, Z, FVoxelValue(Value));
+					}
+					else
+					{
+						const auto NextStack = Items.GetNextStack(X, Y, Z);
+						const auto NextValue = NextStack.Get<v_flt>(X, Y, Z, LOD);
+						QueryZone.Set(X, Y, Z, FVoxelValue(FVoxelUtilities::MergeAsset<v_flt>(Value, NextValue, bSubtractiveAsset)));
+					}
+				}
+			}
+		}
+	}
+	
 	template<bool bCustomTransform>
 	inline FVoxelMaterial GetMaterialImpl(const FTransform& LocalToWorld, v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const
 	{
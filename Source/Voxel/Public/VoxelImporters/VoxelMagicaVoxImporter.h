@@ -34,14 +34,18 @@ public:
 	~FVoxelMagicaVoxScene();
 	UE_NONCOPYABLE(FVoxelMagicaVoxScene);
 
+	// Models are converted & compressed in parallel, by batches to bound memory usage
+	// The decoded models are freed as soon as they are converted: ImportModel can't be used on this scene afterwards
 	UVoxelMagicaVoxScene* Import(
 		UObject* Parent,
 		FName NamePrefix,
 		EObjectFlags Flags,
 		bool bUsePalette,
-		TArray<UVoxelDataAsset*>& OutAssets) const;
+		TArray<UVoxelDataAsset*>& OutAssets);
 	
 	bool ImportModel(FVoxelDataAssetData& Asset, int32 ModelIndex, bool bUsePalette) const;
+	// Free the decoded voxels of a model. Thread safe as long as ModelIndex is different
+	void ReleaseModel(int32 ModelIndex);
 
 public:
 	static TVoxelSharedPtr<FVoxelMagicaVoxScene> LoadScene(const FString& Filename, FString& OutError);
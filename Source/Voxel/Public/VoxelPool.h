@@ -27,7 +27,9 @@ namespace EVoxelTaskType_DefaultPriorityCategories
 		HISMBuild                      = 1000,
 		AsyncEditFunctions             = 50,
 		MeshMerge                      = 100000,
-		RenderOctree                   = 1000000
+		RenderOctree                   = 1000000,
+		EditChunksMeshing              = 10000,
+		InvokersPrefetch               = 0
 	};
 }
 
@@ -45,7 +47,9 @@ namespace EVoxelTaskType_DefaultPriorityOffsets
 		HISMBuild                      = 0,
 		AsyncEditFunctions             = 0,
 		MeshMerge                      = 0,
-		RenderOctree                   = 0
+		RenderOctree                   = 0,
+		EditChunksMeshing              = 0,
+		InvokersPrefetch               = 0
 	};
 }
 
@@ -7,12 +7,14 @@
 #include "VoxelIntBox.h"
 #include "VoxelRender/VoxelProcMeshTangent.h"
 #include "VoxelRender/VoxelMaterialIndices.h"
+#include "VoxelValue.h"
 
 class FVoxelData;
 class FVoxelRuntimeSettings;
 class FDistanceFieldVolumeData;
 
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Chunk Mesh Memory"), STAT_VoxelChunkMeshMemory, STATGROUP_VoxelMemory, VOXEL_API);
+DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Chunk Distance Field Cache Memory"), STAT_VoxelChunkDistanceFieldCacheMemory, STATGROUP_VoxelMemory, VOXEL_API);
 
 struct VOXEL_API FVoxelChunkMeshBuffers
 {
@@ -53,6 +55,40 @@ private:
 	void UpdateStats();
 };
 
+// Intermediate data of a chunk distance field
+// Kept for edited chunks, so that their next build only recomputes the bricks around the voxels that changed
+struct VOXEL_API FVoxelChunkDistanceFieldCache
+{
+	int32 LOD = 0;
+	FIntVector Position = FIntVector(ForceInit);
+	int32 Extension = 0;
+	int32 Divisor = 0;
+	bool bEightBitFixedPoint = false;
+	bool bCompress = false;
+
+	// Densities the distance field was built from
+	FVoxelValueArray Values;
+	// Closest surface position of each low resolution cell, after jump flooding
+	TArray<FVector> SurfacePositions;
+	TVoxelSharedPtr<FDistanceFieldVolumeData> VolumeData;
+
+	FVoxelChunkDistanceFieldCache() = default;
+	~FVoxelChunkDistanceFieldCache()
+	{
+		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkDistanceFieldCacheMemory, LastAllocatedSize);
+	}
+
+	void UpdateStats()
+	{
+		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkDistanceFieldCacheMemory, LastAllocatedSize);
+		LastAllocatedSize = Values.GetAllocatedSize() + SurfacePositions.GetAllocatedSize();
+		INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkDistanceFieldCacheMemory, LastAllocatedSize);
+	}
+
+private:
+	int32 LastAllocatedSize = 0;
+};
+
 struct FVoxelChunkMesh
 {
 public:
@@ -62,7 +98,8 @@ public:
 	}
 	bool IsEmpty() const
 	{
-		return bSingleBuffers ? SingleBuffers->Indices.Num() == 0 : Map.Num() == 0;
+		// Occupancy collision chunks have cubes but no triangles
+		return bSingleBuffers ? SingleBuffers->Indices.Num() == 0 && SingleBuffers->CollisionCubes.Num() == 0 : Map.Num() == 0;
 	}
 
 	TVoxelSharedPtr<const FVoxelChunkMeshBuffers> GetSingleBuffers() const
@@ -75,6 +112,10 @@ public:
 	{
 		return DistanceFieldVolumeData;
 	}
+	TVoxelSharedPtr<const FVoxelChunkDistanceFieldCache> GetDistanceFieldCache() const
+	{
+		return DistanceFieldCache;
+	}
 	TVoxelSharedPtr<const FVoxelChunkMeshBuffers> FindBuffer(const FVoxelMaterialIndices& MaterialIndices) const
 	{
 		ensure(!IsSingle());
@@ -106,7 +147,15 @@ public:
 	}
 	
 public:
-	void BuildDistanceField(int32 LOD, const FIntVector& Position, const FVoxelData& Data, const FVoxelRuntimeSettings& Settings);
+	// PreviousCache: cache of the previous build of this chunk, if any. Only the bricks affected by the values that changed since are recomputed
+	// bKeepCache: if true, the intermediate data is kept for the next build
+	void BuildDistanceField(
+		int32 LOD, 
+		const FIntVector& Position, 
+		const FVoxelData& Data, 
+		const FVoxelRuntimeSettings& Settings,
+		TVoxelSharedPtr<const FVoxelChunkDistanceFieldCache> PreviousCache = nullptr,
+		bool bKeepCache = false);
 	
 public:
 	template<typename T>
@@ -156,4 +205,5 @@ private:
 	TMap<FVoxelMaterialIndices, TVoxelSharedPtr<FVoxelChunkMeshBuffers>> Map;
 	
 	TVoxelSharedPtr<FDistanceFieldVolumeData> DistanceFieldVolumeData;
+	TVoxelSharedPtr<const FVoxelChunkDistanceFieldCache> DistanceFieldCache;
 };
\ No newline at end of file
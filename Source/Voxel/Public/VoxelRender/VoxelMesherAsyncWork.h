@@ -13,6 +13,7 @@ class FVoxelMesherBase;
 class FVoxelDefaultRenderer;
 class FVoxelRuntimeSettings;
 struct FVoxelChunkMesh;
+struct FVoxelChunkDistanceFieldCache;
 
 class VOXEL_API FVoxelMesherAsyncWork : public FVoxelAsyncWork
 {
@@ -27,6 +28,9 @@ public:
 	const bool bIsTransitionTask;
 	const uint8 TransitionsMask; // If bIsTransitionTask is true
 
+	// Input: distance field data of the previous mesh of this chunk. Must be set before the task is queued
+	TVoxelSharedPtr<const FVoxelChunkDistanceFieldCache> PreviousDistanceFieldCache;
+
 	// Output
 	TVoxelSharedPtr<FVoxelChunkMesh> Chunk;
 	double CreationTime = 0;
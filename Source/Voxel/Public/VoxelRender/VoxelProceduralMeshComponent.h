@@ -15,6 +15,7 @@ struct FKConvexElem;
 struct FVoxelProcMeshBuffers;
 struct FMaterialRelevance;
 struct FVoxelSimpleCollisionData;
+struct FVoxelCookedChaosTriMeshes;
 
 class FVoxelPool;
 class FVoxelTexturePool;
@@ -202,6 +203,8 @@ private:
 	bool bNeedToRebuildStaticMesh = false;
 	
 	IVoxelAsyncPhysicsCooker* AsyncCooker = nullptr;
+	// Chaos only: the sub-meshes of the last cook, reused by the next one if their triangles didn't change
+	TVoxelSharedPtr<const FVoxelCookedChaosTriMeshes> CookedChaosTriMeshes;
 	TVoxelSharedPtr<FVoxelSimpleCollisionHandle> SimpleCollisionHandle;
 	FVoxelProceduralMeshComponentMemoryUsage MemoryUsage;
 	
@@ -90,6 +90,8 @@ public:
 	int32 MinLOD;
 	float InvokerDistanceThreshold;
 	float MinDelayBetweenLODUpdates;
+	TArray<float> LODHysteresis;
+	float MinChunkLifetime;
 	bool bConstantLOD;
 	
 public:
@@ -158,6 +160,7 @@ public:
 	int32 VisibleChunksCollisionsMaxLOD;
 	bool bSimpleCubicCollision;
 	int32 SimpleCubicCollisionLODBias;
+	bool bOccupancyCollision;
 	int32 NumConvexHullsPerAxis;
 	bool bCleanCollisionMeshes;
 	
@@ -170,6 +173,7 @@ public:
 	TMap<EVoxelTaskType, int32> PriorityCategories;
 	TMap<EVoxelTaskType, int32> PriorityOffsets;
 	float MeshUpdatesBudget;
+	float EditMeshUpdatesBudget;
 	float EventsTickRate;
 	int32 DataOctreeInitialSubdivisionDepth;
 
@@ -107,6 +107,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - LOD Settings", meta = (RecreateRender, ClampMin = 0), DisplayName = "Min Delay Between LOD Updates")
 	float MinDelayBetweenLODUpdates = 0.1;
 
+	// Per LOD, as a fraction of the chunk size: a chunk subdivided by an invoker is only merged back once the invoker is further than this from it
+	// Avoids chunks flipping between two LODs when an invoker moves back and forth around a LOD boundary
+	// Element N is used for chunks of LOD N, the last element for the higher LODs. Empty to disable
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - LOD Settings", meta = (RecreateRender, DisplayName = "LOD Hysteresis"))
+	TArray<float> LODHysteresis;
+
+	// Min time a chunk keeps its LOD before it can be subdivided or merged again, in seconds
+	// The chunks kept back are updated by a following LOD update. 0 to disable
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - LOD Settings", meta = (RecreateRender, ClampMin = 0))
+	float MinChunkLifetime = 0;
+
 	// If true, the LODs will be updated only once at start
 	// LODs can still be updated using ForceLODsUpdate or ApplyLODSettings
 	// For example, can be useful when used with a Max LOD of 0 for worlds that have the highest resolution LOD everywhere
@@ -428,6 +439,12 @@ public:
 	// Will use a lower LOD for cubic collisions, making them much faster to simulate at the cost of accuracy
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Collisions", meta = (Recreate, ClampMin = 0, ClampMax = 4, EditCondition = bEnableCollisions))
 	int32 SimpleCubicCollisionLODBias = 0;
+
+	// If true, collisions are made of cubes built greedily from the voxel occupancy, without running the mesher or creating any triangle
+	// Much faster to cook and lighter in memory when a lot of collision chunks are needed, but smooth worlds will have blocky collisions
+	// Only used when Render World and navmesh are disabled
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Collisions", meta = (Recreate, EditCondition = bEnableCollisions))
+	bool bOccupancyCollision = false;
 	
 	// Number of convex hulls to create per chunk per axis for simple collisions
 	// More hulls = more precise collisions, but much more expensive physics
@@ -477,6 +494,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Performance", meta = (RecreateRender, ClampMin = 0.001))
 	float MeshUpdatesBudget = 1000;
 
+	// Max time in milliseconds to spend per tick on applying the meshes of chunks updated by edits
+	// These meshes are applied before any other mesh update, and are computed by dedicated threads (see voxel.threading.NumEditThreads)
+	// Use voxel.renderer.LogEditLatency to check the latency between an edit and its chunks being updated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Performance", meta = (RecreateRender, ClampMin = 0.001))
+	float EditMeshUpdatesBudget = 1000;
+
 	// The rate at which events are fired (number of updates per seconds). Used for foliage spawning, foliage collision, binded BP events...
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Performance", meta = (RecreateRender, UIMin = 1, UIMax = 60))
 	float EventsTickRate = 15;
@@ -21,12 +21,16 @@ extern VOXEL_API FVoxelThreadPool* GVoxelThreadPool;
 
 extern VOXEL_API TAutoConsoleVariable<float> CVarVoxelThreadingPriorityDuration;
 extern VOXEL_API TAutoConsoleVariable<int32> CVarVoxelThreadingNumThreads;
+extern VOXEL_API TAutoConsoleVariable<int32> CVarVoxelThreadingNumEditThreads;
 extern VOXEL_API TAutoConsoleVariable<int32> CVarVoxelThreadingThreadPriority;
 
 class VOXEL_API FVoxelThread : public FRunnable
 {
 public:
-	FVoxelThread(FVoxelThreadPool& Pool, const FString& ThreadName, uint32 StackSize, EThreadPriority ThreadPriority);
+	// If bIsEditThread is true, this thread will only process low latency tasks
+	const bool bIsEditThread;
+	
+	FVoxelThread(FVoxelThreadPool& Pool, const FString& ThreadName, uint32 StackSize, EThreadPriority ThreadPriority, bool bIsEditThread);
 	~FVoxelThread();
 
 	//~ Begin FRunnable Interface
@@ -74,39 +78,43 @@ public:
 			InQueuedWork->PoolId = PoolId;
 		}
 
+		const bool bIsLowLatency = IsLowLatencyTaskType(Type);
+
 		FVoxelScopeLockWithStats Lock(CriticalSection);
 
 		{
 			VOXEL_SCOPE_COUNTER("Add Works");
+			auto& Works = bIsLowLatency ? QueuedLowLatencyWorks : QueuedWorks;
 			for (auto* InQueuedWork : InQueuedWorks)
 			{
 				FQueuedWorkInfo WorkInfo(InQueuedWork, PriorityCategory, PriorityOffset);
 				WorkInfo.RecomputePriority();
-				QueuedWorks.HeapPush(WorkInfo);
+				Works.HeapPush(WorkInfo);
 			}
 		}
 
 		VOXEL_SCOPE_COUNTER("Wakeup threads");
-		const int32 WantedActiveThreads = CVarVoxelThreadingNumThreads.GetValueOnGameThread();
-		while (AllThreads.Num() - QueuedThreads.Num() < WantedActiveThreads)
+		if (bIsLowLatency)
 		{
-			if (QueuedThreads.Num() > 0)
-			{
-				auto* Thread = QueuedThreads.Pop(false);
-				Thread->Wakeup();
-			}
-			else
-			{
-				auto& Thread = AllThreads.Emplace_GetRef(CreateThread());
-				Thread->Wakeup();
-			}
+			const int32 WantedActiveEditThreads = CVarVoxelThreadingNumEditThreads.GetValueOnGameThread();
+			WakeupThreads(AllEditThreads, QueuedEditThreads, WantedActiveEditThreads, true);
 		}
+		const int32 WantedActiveThreads = CVarVoxelThreadingNumThreads.GetValueOnGameThread();
+		WakeupThreads(AllThreads, QueuedThreads, WantedActiveThreads, false);
+	}
+
+	// Low latency tasks are stored in their own queue: they are always picked before any other task,
+	// and are the only tasks processed by the edit threads (see voxel.threading.NumEditThreads)
+	static bool IsLowLatencyTaskType(EVoxelTaskType Type)
+	{
+		return Type == EVoxelTaskType::EditChunksMeshing;
 	}
 
 	void AbandonAllTasks();
 	
 private:
-	TUniquePtr<FVoxelThread> CreateThread();
+	TUniquePtr<FVoxelThread> CreateThread(bool bIsEditThread);
+	void WakeupThreads(TArray<TUniquePtr<FVoxelThread>>& Threads, TArray<FVoxelThread*>& SleepingThreads, int32 WantedActiveThreads, bool bIsEditThread);
 	void AbandonWork(IVoxelQueuedWork& Work);
 	IVoxelQueuedWork* ReturnToPoolOrGetNextJob(FVoxelThread* InQueuedThread);
 	void RecomputePriorities_AssumeLocked();
@@ -147,6 +155,8 @@ private:
 			return GetPriority() > Other.GetPriority();
 		}
 	};
+	void RecomputePriorities_AssumeLocked(TArray<FQueuedWorkInfo>& Works);
+
 private:
 	const TVoxelSharedRef<const uint32> IsAlive = MakeVoxelShared<uint32>();
 	
@@ -157,6 +167,13 @@ private:
 	TArray<FVoxelThread*> QueuedThreads;
 	// Heapified
 	TArray<FQueuedWorkInfo> QueuedWorks;
+	
+	// Threads reserved for low latency tasks
+	TArray<TUniquePtr<FVoxelThread>> AllEditThreads;
+	// Sleeping edit threads
+	TArray<FVoxelThread*> QueuedEditThreads;
+	// Heapified. Always processed before QueuedWorks
+	TArray<FQueuedWorkInfo> QueuedLowLatencyWorks;
 
 	// Last time we computed priorities
 	double LastPriorityComputeTime = 0;
@@ -0,0 +1,64 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelIntBox.h"
+#include "VoxelTickable.h"
+#include "VoxelSubsystem.h"
+#include "Containers/Queue.h"
+#include "VoxelEditBatcher.generated.h"
+
+class FVoxelLatentActionAsyncWork;
+enum class EVoxelLockType;
+enum class EVoxelUpdateRender;
+
+UCLASS()
+class VOXEL_API UVoxelEditBatcherSubsystemProxy : public UVoxelStaticSubsystemProxy
+{
+	GENERATED_BODY()
+	GENERATED_VOXEL_SUBSYSTEM_PROXY_BODY(FVoxelEditBatcher);
+};
+
+// Coalesces the async edits queued during a frame into a few tasks, each running its edits under a single lock on their merged bounds
+// The render is then updated once for all the edits that finished
+class VOXEL_API FVoxelEditBatcher : public IVoxelSubsystem, public FVoxelTickable
+{
+public:
+	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelEditBatcherSubsystemProxy);
+
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Destroy() override;
+	//~ End IVoxelSubsystem Interface
+
+public:
+	/**
+	 * Queue an edit to be run with the other edits of this frame. Game thread only
+	 * Work must not lock the data itself: it's called with a lock of LockType on a box containing Bounds
+	 * Work is not owned by the batcher, and must be kept alive until it's done. It is abandoned if the batcher is destroyed first
+	 */
+	void QueueEdit(FVoxelLatentActionAsyncWork& Work, EVoxelLockType LockType, const FVoxelIntBox& Bounds, EVoxelUpdateRender UpdateRender);
+
+	// Start the queued edits now instead of at the end of the frame. Game thread only
+	void Flush();
+
+protected:
+	//~ Begin FVoxelTickable Interface
+	virtual void Tick(float DeltaTime) override;
+	//~ End FVoxelTickable Interface
+
+private:
+	struct FQueuedEdit
+	{
+		FVoxelLatentActionAsyncWork* Work = nullptr;
+		EVoxelLockType LockType;
+		FVoxelIntBox Bounds;
+		bool bUpdateRender = false;
+	};
+	TArray<FQueuedEdit> QueuedEdits;
+
+	// Filled by the batch tasks, drained on the game thread
+	TQueue<FVoxelIntBox, EQueueMode::Mpsc> BoundsToUpdate;
+
+	friend class FVoxelEditBatchWork;
+};
@@ -136,6 +136,56 @@ public:
 		float MaxDistance = 1e9,
 		bool bHideLatentWarnings = false);
 
+public:
+	/**
+	 * Find voxels by marching rays through the voxel data. Does not require any collision
+	 * Rays only hit surfaces when going from empty to full voxels
+	 * @param World					The voxel world
+	 * @param Position				The center of the rays
+	 * @param Direction				The direction of the rays
+	 * @param Radius				The radius in world space (cm)
+	 * @param Shape					The shape of the rays start positions
+	 * @param NumRays				The approximate number of rays to march
+	 * @param MaxDistance			The max ray distance
+	 * @return	Number of rays actually marched (should be close to NumRays)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Voxel|Tools|Projection Tools", meta = (DefaultToSelf = "World"))
+	static int32 FindProjectionVoxelsByRayMarching(
+		TArray<FVoxelProjectionHit>& Hits,
+		AVoxelWorld* World,
+		FVector Position,
+		FVector Direction,
+		float Radius = 100.f,
+		EVoxelProjectionShape Shape = EVoxelProjectionShape::Circle,
+		float NumRays = 100.f,
+		float MaxDistance = 1e9);
+
+	/**
+	 * Find voxels by marching rays through the voxel data, asynchronously. Does not require any collision
+	 * Rays only hit surfaces when going from empty to full voxels
+	 * @param World					The voxel world
+	 * @param Position				The center of the rays
+	 * @param Direction				The direction of the rays
+	 * @param Radius				The radius in world space (cm)
+	 * @param Shape					The shape of the rays start positions
+	 * @param NumRays				The approximate number of rays to march
+	 * @param MaxDistance			The max ray distance
+	 * @return	Number of rays actually marched (should be close to NumRays)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Voxel|Tools|Projection Tools", meta = (DefaultToSelf = "World", Latent, LatentInfo="LatentInfo", WorldContext = "WorldContextObject", AdvancedDisplay = "bHideLatentWarnings"))
+	static int32 FindProjectionVoxelsByRayMarchingAsync(
+		UObject* WorldContextObject,
+		FLatentActionInfo LatentInfo,
+		TArray<FVoxelProjectionHit>& Hits,
+		AVoxelWorld* World,
+		FVector Position,
+		FVector Direction,
+		float Radius = 100.f,
+		EVoxelProjectionShape Shape = EVoxelProjectionShape::Circle,
+		float NumRays = 100.f,
+		float MaxDistance = 1e9,
+		bool bHideLatentWarnings = false);
+
 public:
 	UFUNCTION(BlueprintCallable, Category = "Voxel|Tools|Projection Tools")
 	static TArray<FIntVector> GetHitsPositions(const TArray<FVoxelProjectionHit>& Hits);
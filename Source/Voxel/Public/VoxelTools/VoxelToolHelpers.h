@@ -21,6 +21,7 @@ class AVoxelWorld;
 class FVoxelData;
 class FPendingLatentAction;
 class FVoxelLatentActionAsyncWork;
+class FVoxelEditBatcher;
 struct FLatentActionInfo;
 enum class EVoxelLockType;
 
@@ -40,6 +41,8 @@ public:
 	//~ Begin FVoxelLatentActionAsyncWork Interface
 	// Called on the game thread
 	virtual bool IsValid() const = 0;
+	// Called on the game thread before blocking on this work
+	virtual void PrepareForWait() {}
 	//~ End FVoxelLatentActionAsyncWork Interface
 };
 
@@ -54,10 +57,21 @@ public:
 
 	FVoxelLatentActionAsyncWork_WithWorld(FName Name, TWeakObjectPtr<AVoxelWorld> World, TFunction<void(FVoxelData&)> Function);
 
+	// Lock Bounds when running Function. Must be called before the work is started
+	void SetLock(EVoxelLockType InLockType, const FVoxelIntBox& InBounds);
+	// Set when queued in a batcher instead of the thread pool
+	void SetBatcher(const TVoxelSharedRef<FVoxelEditBatcher>& InBatcher);
+	
 	//~ Begin FVoxelLatentActionAsyncWork Interface
 	virtual void DoWork() override;
 	virtual bool IsValid() const override;
+	virtual void PrepareForWait() override;
 	//~ End FVoxelLatentActionAsyncWork Interface
+
+private:
+	EVoxelLockType LockType = EVoxelLockType::Read;
+	TOptional<FVoxelIntBox> LockBounds;
+	TVoxelWeakPtr<FVoxelEditBatcher> Batcher;
 };
 
 class VOXEL_API FVoxelLatentActionAsyncWork_WithoutWorld : public FVoxelLatentActionAsyncWork
@@ -136,6 +150,8 @@ public:
 	{
 		if (!Work->IsDone())
 		{
+			Work->PrepareForWait();
+			
 			const double StartTime = FPlatformTime::Seconds();
 			Work->WaitForCompletion();
 			const double Elapsed = FPlatformTime::Seconds() - StartTime;
@@ -184,6 +200,10 @@ struct VOXEL_API FVoxelToolHelpers
 	static void UpdateWorld(AVoxelWorld* World, const FVoxelIntBox& Bounds);
 	// If World is null, will start an async on AnyThread. Else will use the voxel world thread pool.
 	static void StartAsyncEditTask(AVoxelWorld* World, IVoxelQueuedWork* Work);
+	// Work will be run with a lock of LockType on Bounds
+	// If voxel.tools.BatchLatentEdits is true, it is queued in the world edit batcher and merged with the other edits of the frame
+	// @return whether the edit was batched: if so, the batcher takes care of updating the render
+	static bool StartLockedAsyncEditTask(AVoxelWorld* World, FVoxelLatentActionAsyncWork_WithWorld& Work, EVoxelLockType LockType, const FVoxelIntBox& Bounds, EVoxelUpdateRender UpdateRender);
 
 	static float GetRealDistance(AVoxelWorld* World, float Distance, bool bConvertToVoxelSpace);
 	static FVoxelVector GetRealPosition(AVoxelWorld* World, const FVector& Position, bool bConvertToVoxelSpace);
@@ -217,6 +237,34 @@ struct VOXEL_API FVoxelToolHelpers
 		});
 	}
 
+	template<typename TWork, typename TCreateWork>
+	static bool StartLockedAsyncLatentActionImpl(
+		UObject* WorldContextObject,
+		FLatentActionInfo LatentInfo,
+		AVoxelWorld* World,
+		FName Name,
+		bool bHideLatentWarnings,
+		EVoxelLockType LockType,
+		EVoxelUpdateRender UpdateRender,
+		const FVoxelIntBox& Bounds,
+		TCreateWork CreateWork,
+		TFunction<void(TWork&)> GameThreadCallback)
+	{
+		return StartLatentAction(WorldContextObject, LatentInfo, Name, bHideLatentWarnings, [&]()
+		{
+			TWork* Work = CreateWork();
+			const bool bBatched = StartLockedAsyncEditTask(World, *Work, LockType, Bounds, UpdateRender);
+			return new TVoxelLatentAction<TWork>(LatentInfo, Work, Name, [=](TWork& InWork)
+			{
+				GameThreadCallback(InWork);
+				if (!bBatched && UpdateRender == EVoxelUpdateRender::UpdateRender && InWork.World.IsValid())
+				{
+					UpdateWorld(InWork.World.Get(), Bounds);
+				}
+			});
+		});
+	}
+
 	static bool StartAsyncLatentAction_WithWorld(
 		UObject* WorldContextObject,
 		FLatentActionInfo LatentInfo,
@@ -226,6 +274,17 @@ struct VOXEL_API FVoxelToolHelpers
 		TFunction<void(FVoxelData&)> DoWork,
 		EVoxelUpdateRender UpdateRender,
 		const FVoxelIntBox& BoundsToUpdate);
+	// DoWork must not lock: Bounds is locked with LockType before calling it. Allows batching the edits, see StartLockedAsyncEditTask
+	static bool StartLockedAsyncLatentAction_WithWorld(
+		UObject* WorldContextObject,
+		FLatentActionInfo LatentInfo,
+		AVoxelWorld* World,
+		FName Name,
+		bool bHideLatentWarnings,
+		TFunction<void(FVoxelData&)> DoWork,
+		EVoxelLockType LockType,
+		EVoxelUpdateRender UpdateRender,
+		const FVoxelIntBox& Bounds);
 	static bool StartAsyncLatentAction_WithoutWorld(
 		UObject* WorldContextObject,
 		FLatentActionInfo LatentInfo,
@@ -271,6 +330,39 @@ struct VOXEL_API FVoxelToolHelpers
 				}
 			});
 	}
+	// DoWork must not lock: Bounds is locked with LockType before calling it. Allows batching the edits, see StartLockedAsyncEditTask
+	template<typename T, typename TDoWork>
+	static bool StartLockedAsyncLatentAction_WithWorld_WithValue(
+		UObject* WorldContextObject, 
+		FLatentActionInfo LatentInfo,
+		AVoxelWorld* World,
+		FName Name, 
+		bool bHideLatentWarnings,
+		T& Value,
+		TDoWork DoWork,
+		EVoxelLockType LockType,
+		EVoxelUpdateRender UpdateRender,
+		const FVoxelIntBox& Bounds)
+	{
+		using FWork = TVoxelLatentActionAsyncWork_WithWorld_WithValue<T>;
+		return StartLockedAsyncLatentActionImpl<FWork>(
+			WorldContextObject,
+			LatentInfo,
+			World,
+			Name,
+			bHideLatentWarnings,
+			LockType,
+			UpdateRender,
+			Bounds,
+			[&]() { return new FWork(Name, World, DoWork); },
+			[=, WeakWorldContextObject = MakeWeakObjectPtr(WorldContextObject), &Value](FWork& Work)
+			{
+				if (WeakWorldContextObject.IsValid())
+				{
+					Value = MoveTemp(Work.Value);
+				}
+			});
+	}
 	template<typename T, typename TDoWork>
 	static bool StartAsyncLatentAction_WithoutWorld_WithValue(
 		UObject* WorldContextObject, 
@@ -403,7 +495,7 @@ if (!FVoxelUtilities::CountIs32Bits(Bounds.Size())) \
 	}
 
 #define VOXEL_TOOL_LATENT_HELPER_BODY(InLockType, InUpdateRender, ...) \
-	FVoxelToolHelpers::StartAsyncLatentAction_WithWorld( \
+	FVoxelToolHelpers::StartLockedAsyncLatentAction_WithWorld( \
 		WorldContextObject, \
 		LatentInfo, \
 		World, \
@@ -411,14 +503,14 @@ if (!FVoxelUtilities::CountIs32Bits(Bounds.Size())) \
 		bHideLatentWarnings, \
 		[=](FVoxelData& Data) \
 		{ \
-			TVoxelScopeLock<EVoxelLockType::InLockType> Lock(Data, Bounds, FUNCTION_FNAME); \
 			__VA_ARGS__; \
 		}, \
+		EVoxelLockType::InLockType, \
 		EVoxelUpdateRender::InUpdateRender, \
 		Bounds);
 
 #define VOXEL_TOOL_LATENT_HELPER_WITH_VALUE_BODY(InValue, InLockType, InUpdateRender, ...) \
-	FVoxelToolHelpers::StartAsyncLatentAction_WithWorld_WithValue( \
+	FVoxelToolHelpers::StartLockedAsyncLatentAction_WithWorld_WithValue( \
 		WorldContextObject, \
 		LatentInfo, \
 		World, \
@@ -429,9 +521,9 @@ if (!FVoxelUtilities::CountIs32Bits(Bounds.Size())) \
 		{ \
 			static_assert(TIsReferenceType<decltype(InValue)>::Value, "Value is not a reference!"); \
 			static_assert(!TIsConst<decltype(InValue)>::Value, "Value is const!"); \
-			TVoxelScopeLock<EVoxelLockType::InLockType> Lock(Data, Bounds, FUNCTION_FNAME); \
 			__VA_ARGS__; \
 		}, \
+		EVoxelLockType::InLockType, \
 		EVoxelUpdateRender::InUpdateRender, \
 		Bounds);
 
@@ -23,6 +23,9 @@ public:
 
 public:
 	static void JumpFlood(const FIntVector& Size, TArray<FVector>& InOutPackedPositions, EVoxelComputeDevice Device, bool bMultiThreaded = false, int32 MaxPasses_Debug = -1);
+	// Same as JumpFlood, but only the cells of Bricks are updated
+	// The other cells must already hold their closest surface position: they are used as seeds
+	static void JumpFloodBricks(const FIntVector& Size, TArray<FVector>& InOutSurfacePositions, int32 BrickSize, TArrayView<const FIntVector> Bricks);
 	// Only the InOutDistances sign will be used, not their actual values
 	static void GetDistancesFromSurfacePositions(const FIntVector& Size, TArrayView<const FVector> SurfacePositions, TArrayView<float> InOutDistances);
 	
@@ -70,5 +73,6 @@ public:
 		bool bShrink);
 
 private:
+	static FVector JumpFloodCell_CPU(const FIntVector& Size, TArrayView<const FVector> InData, const FIntVector& Position, int32 Step);
 	static void JumpFloodStep_CPU(const FIntVector& Size, TArrayView<const FVector> InData, TArrayView<FVector> OutData, int32 Step, bool bMultiThreaded);
 };
\ No newline at end of file
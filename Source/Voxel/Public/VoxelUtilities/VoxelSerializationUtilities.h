@@ -97,7 +97,8 @@ public:
 		const uint8* UncompressedData,
 		int64 UncompressedDataNum, 
 		TArray<uint8>& OutCompressedData,
-		EVoxelCompressionLevel::Type CompressionLevel = EVoxelCompressionLevel::VoxelDefault);
+		EVoxelCompressionLevel::Type CompressionLevel = EVoxelCompressionLevel::VoxelDefault,
+		bool bLog = true);
 	static void CompressData(
 		FLargeMemoryWriter& UncompressedData,
 		TArray<uint8>& CompressedData,
@@ -111,7 +112,12 @@ public:
 		CompressData(UncompressedData.GetData(), UncompressedData.Num(), CompressedData, CompressionLevel);
 	}
 
-	static bool DecompressData(const TArray<uint8>& CompressedData, TArray64<uint8>& UncompressedData);
+	// bLog = false for callers decompressing many small buffers, eg data asset slabs
+	static bool DecompressData(const uint8* CompressedData, int64 CompressedDataNum, TArray64<uint8>& UncompressedData, bool bLog = true);
+	static bool DecompressData(const TArray<uint8>& CompressedData, TArray64<uint8>& UncompressedData)
+	{
+		return DecompressData(CompressedData.GetData(), CompressedData.Num(), UncompressedData);
+	}
 	static void TestCompression(int64 Size, EVoxelCompressionLevel::Type CompressionLevel);
 
 private:
@@ -834,6 +834,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
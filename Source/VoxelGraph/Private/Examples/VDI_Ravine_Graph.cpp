@@ -389,7 +389,7 @@ public:
 			Variable_23 = BufferX.Variable_7;
 			Variable_24 = BufferXY.Variable_8;
 			Variable_25 = Variable_9;
-			_3D_Gradient_Perturb_Fractal_0_Noise.GradientPerturbFractal_3D(Variable_23, Variable_24, Variable_25, v_flt(0.001f), _3D_Gradient_Perturb_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(200.0f));
+			_3D_Gradient_Perturb_Fractal_0_Noise.GradientPerturbFractal_3D(Variable_23, Variable_24, Variable_25, v_flt(0.001f), _3D_Gradient_Perturb_Fractal_0_Noise.GetLODOctaves(_3D_Gradient_Perturb_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD), v_flt(200.0f));
 			
 			// vector - vector.-
 			v_flt Variable_29; // vector - vector.- output 0
@@ -478,7 +478,7 @@ public:
 			Variable_23 = Variable_7;
 			Variable_24 = Variable_8;
 			Variable_25 = Variable_9;
-			_3D_Gradient_Perturb_Fractal_0_Noise.GradientPerturbFractal_3D(Variable_23, Variable_24, Variable_25, v_flt(0.001f), _3D_Gradient_Perturb_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(200.0f));
+			_3D_Gradient_Perturb_Fractal_0_Noise.GradientPerturbFractal_3D(Variable_23, Variable_24, Variable_25, v_flt(0.001f), _3D_Gradient_Perturb_Fractal_0_Noise.GetLODOctaves(_3D_Gradient_Perturb_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD), v_flt(200.0f));
 			
 			// vector - vector.-
 			v_flt Variable_27; // vector - vector.- output 0
@@ -1162,6 +1162,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
@@ -250,7 +250,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_9; // 2D Perlin Noise Fractal output 0
-			Variable_9 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_4, Variable_3, BufferConstant.Variable_18, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_9 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_4, Variable_3, BufferConstant.Variable_18, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_18, v_flt(1.0f), Context.LOD));
 			Variable_9 = FMath::Clamp<v_flt>(Variable_9, -0.663838, 0.649431);
 			
 			// vector2 * vector2.*
@@ -305,7 +305,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_9; // 2D Perlin Noise Fractal output 0
-			Variable_9 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_4, Variable_3, BufferConstant.Variable_18, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_9 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_4, Variable_3, BufferConstant.Variable_18, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_18, v_flt(1.0f), Context.LOD));
 			Variable_9 = FMath::Clamp<v_flt>(Variable_9, -0.663838, 0.649431);
 			
 			// vector2 * vector2.*
@@ -389,7 +389,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_9; // 2D Perlin Noise Fractal output 0
-			Variable_9 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_4, Variable_3, BufferConstant.Variable_18, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_9 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_4, Variable_3, BufferConstant.Variable_18, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_18, v_flt(1.0f), Context.LOD));
 			Variable_9 = FMath::Clamp<v_flt>(Variable_9, -0.663838, 0.649431);
 			
 			// vector2 * vector2.*
@@ -969,6 +969,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
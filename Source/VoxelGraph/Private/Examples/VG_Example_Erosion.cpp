@@ -260,7 +260,7 @@ public:
 			v_flt Variable_14; // 2D Perlin Noise Fractal output 0
 			v_flt Variable_15; // 2D Perlin Noise Fractal output 1
 			v_flt Variable_16; // 2D Perlin Noise Fractal output 2
-			Variable_14 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_2, Variable_3, v_flt(0.001f), _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],Variable_15,Variable_16);
+			Variable_14 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_2, Variable_3, v_flt(0.001f), _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD),Variable_15,Variable_16);
 			Variable_14 = FMath::Clamp<v_flt>(Variable_14, -0.722935, 0.711631);
 			Variable_15 = FMath::Clamp<v_flt>(Variable_15, -1.982108, 2.144371);
 			Variable_16 = FMath::Clamp<v_flt>(Variable_16, -2.105316, 1.997740);
@@ -273,7 +273,7 @@ public:
 			v_flt Variable_1; // 2D Erosion output 0
 			v_flt _2D_Erosion_0_Temp_1; // 2D Erosion output 1
 			v_flt _2D_Erosion_0_Temp_2; // 2D Erosion output 2
-			Variable_1 = _2D_Erosion_0_Noise.GetErosion_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Erosion_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], Variable_15, Variable_16, _2D_Erosion_0_Temp_1, _2D_Erosion_0_Temp_2);
+			Variable_1 = _2D_Erosion_0_Noise.GetErosion_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Erosion_0_Noise.GetLODOctaves(_2D_Erosion_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD), Variable_15, Variable_16, _2D_Erosion_0_Temp_1, _2D_Erosion_0_Temp_2);
 			Variable_1 = FMath::Clamp<v_flt>(Variable_1, -1.200000, 1.200000);
 			_2D_Erosion_0_Temp_1 = FMath::Clamp<v_flt>(_2D_Erosion_0_Temp_1, -1.200000, 1.200000);
 			_2D_Erosion_0_Temp_2 = FMath::Clamp<v_flt>(_2D_Erosion_0_Temp_2, -1.200000, 1.200000);
@@ -319,7 +319,7 @@ public:
 			v_flt Variable_14; // 2D Perlin Noise Fractal output 0
 			v_flt Variable_15; // 2D Perlin Noise Fractal output 1
 			v_flt Variable_16; // 2D Perlin Noise Fractal output 2
-			Variable_14 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_2, Variable_3, v_flt(0.001f), _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],Variable_15,Variable_16);
+			Variable_14 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_2, Variable_3, v_flt(0.001f), _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD),Variable_15,Variable_16);
 			Variable_14 = FMath::Clamp<v_flt>(Variable_14, -0.722935, 0.711631);
 			Variable_15 = FMath::Clamp<v_flt>(Variable_15, -1.982108, 2.144371);
 			Variable_16 = FMath::Clamp<v_flt>(Variable_16, -2.105316, 1.997740);
@@ -332,7 +332,7 @@ public:
 			v_flt Variable_1; // 2D Erosion output 0
 			v_flt _2D_Erosion_0_Temp_1; // 2D Erosion output 1
 			v_flt _2D_Erosion_0_Temp_2; // 2D Erosion output 2
-			Variable_1 = _2D_Erosion_0_Noise.GetErosion_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Erosion_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], Variable_15, Variable_16, _2D_Erosion_0_Temp_1, _2D_Erosion_0_Temp_2);
+			Variable_1 = _2D_Erosion_0_Noise.GetErosion_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Erosion_0_Noise.GetLODOctaves(_2D_Erosion_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD), Variable_15, Variable_16, _2D_Erosion_0_Temp_1, _2D_Erosion_0_Temp_2);
 			Variable_1 = FMath::Clamp<v_flt>(Variable_1, -1.200000, 1.200000);
 			_2D_Erosion_0_Temp_1 = FMath::Clamp<v_flt>(_2D_Erosion_0_Temp_1, -1.200000, 1.200000);
 			_2D_Erosion_0_Temp_2 = FMath::Clamp<v_flt>(_2D_Erosion_0_Temp_2, -1.200000, 1.200000);
@@ -401,7 +401,7 @@ public:
 			v_flt Variable_14; // 2D Perlin Noise Fractal output 0
 			v_flt Variable_15; // 2D Perlin Noise Fractal output 1
 			v_flt Variable_16; // 2D Perlin Noise Fractal output 2
-			Variable_14 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D_Deriv(Variable_2, Variable_3, v_flt(0.001f), _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],Variable_15,Variable_16);
+			Variable_14 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D_Deriv(Variable_2, Variable_3, v_flt(0.001f), _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD),Variable_15,Variable_16);
 			Variable_14 = FMath::Clamp<v_flt>(Variable_14, -0.722935, 0.711631);
 			Variable_15 = FMath::Clamp<v_flt>(Variable_15, -1.982108, 2.144371);
 			Variable_16 = FMath::Clamp<v_flt>(Variable_16, -2.105316, 1.997740);
@@ -414,7 +414,7 @@ public:
 			v_flt Variable_1; // 2D Erosion output 0
 			v_flt _2D_Erosion_0_Temp_1; // 2D Erosion output 1
 			v_flt _2D_Erosion_0_Temp_2; // 2D Erosion output 2
-			Variable_1 = _2D_Erosion_0_Noise.GetErosion_2D(Variable_11, Variable_12, v_flt(0.02f), _2D_Erosion_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], Variable_15, Variable_16, _2D_Erosion_0_Temp_1, _2D_Erosion_0_Temp_2);
+			Variable_1 = _2D_Erosion_0_Noise.GetErosion_2D(Variable_11, Variable_12, v_flt(0.02f), _2D_Erosion_0_Noise.GetLODOctaves(_2D_Erosion_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD), Variable_15, Variable_16, _2D_Erosion_0_Temp_1, _2D_Erosion_0_Temp_2);
 			Variable_1 = FMath::Clamp<v_flt>(Variable_1, -1.200000, 1.200000);
 			_2D_Erosion_0_Temp_1 = FMath::Clamp<v_flt>(_2D_Erosion_0_Temp_1, -1.200000, 1.200000);
 			_2D_Erosion_0_Temp_2 = FMath::Clamp<v_flt>(_2D_Erosion_0_Temp_2, -1.200000, 1.200000);
@@ -725,7 +725,7 @@ public:
 			v_flt Variable_18; // 2D Perlin Noise Fractal output 0
 			v_flt Variable_19; // 2D Perlin Noise Fractal output 1
 			v_flt Variable_20; // 2D Perlin Noise Fractal output 2
-			Variable_18 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_1, Variable_2, v_flt(0.001f), _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],Variable_19,Variable_20);
+			Variable_18 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_1, Variable_2, v_flt(0.001f), _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD),Variable_19,Variable_20);
 			Variable_18 = FMath::Clamp<v_flt>(Variable_18, -0.722935, 0.711631);
 			Variable_19 = FMath::Clamp<v_flt>(Variable_19, -1.982108, 2.144371);
 			Variable_20 = FMath::Clamp<v_flt>(Variable_20, -2.105316, 1.997740);
@@ -734,7 +734,7 @@ public:
 			v_flt Variable_0; // 2D Erosion output 0
 			v_flt _2D_Erosion_1_Temp_1; // 2D Erosion output 1
 			v_flt _2D_Erosion_1_Temp_2; // 2D Erosion output 2
-			Variable_0 = _2D_Erosion_1_Noise.GetErosion_2D(BufferX.Variable_14, Variable_15, v_flt(0.02f), _2D_Erosion_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], Variable_19, Variable_20, _2D_Erosion_1_Temp_1, _2D_Erosion_1_Temp_2);
+			Variable_0 = _2D_Erosion_1_Noise.GetErosion_2D(BufferX.Variable_14, Variable_15, v_flt(0.02f), _2D_Erosion_1_Noise.GetLODOctaves(_2D_Erosion_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD), Variable_19, Variable_20, _2D_Erosion_1_Temp_1, _2D_Erosion_1_Temp_2);
 			Variable_0 = FMath::Clamp<v_flt>(Variable_0, -1.200000, 1.200000);
 			_2D_Erosion_1_Temp_1 = FMath::Clamp<v_flt>(_2D_Erosion_1_Temp_1, -1.200000, 1.200000);
 			_2D_Erosion_1_Temp_2 = FMath::Clamp<v_flt>(_2D_Erosion_1_Temp_2, -1.200000, 1.200000);
@@ -788,7 +788,7 @@ public:
 			v_flt Variable_18; // 2D Perlin Noise Fractal output 0
 			v_flt Variable_19; // 2D Perlin Noise Fractal output 1
 			v_flt Variable_20; // 2D Perlin Noise Fractal output 2
-			Variable_18 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_1, Variable_2, v_flt(0.001f), _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],Variable_19,Variable_20);
+			Variable_18 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D_Deriv(BufferX.Variable_1, Variable_2, v_flt(0.001f), _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD),Variable_19,Variable_20);
 			Variable_18 = FMath::Clamp<v_flt>(Variable_18, -0.722935, 0.711631);
 			Variable_19 = FMath::Clamp<v_flt>(Variable_19, -1.982108, 2.144371);
 			Variable_20 = FMath::Clamp<v_flt>(Variable_20, -2.105316, 1.997740);
@@ -797,7 +797,7 @@ public:
 			v_flt Variable_0; // 2D Erosion output 0
 			v_flt _2D_Erosion_1_Temp_1; // 2D Erosion output 1
 			v_flt _2D_Erosion_1_Temp_2; // 2D Erosion output 2
-			Variable_0 = _2D_Erosion_1_Noise.GetErosion_2D(BufferX.Variable_14, Variable_15, v_flt(0.02f), _2D_Erosion_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], Variable_19, Variable_20, _2D_Erosion_1_Temp_1, _2D_Erosion_1_Temp_2);
+			Variable_0 = _2D_Erosion_1_Noise.GetErosion_2D(BufferX.Variable_14, Variable_15, v_flt(0.02f), _2D_Erosion_1_Noise.GetLODOctaves(_2D_Erosion_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD), Variable_19, Variable_20, _2D_Erosion_1_Temp_1, _2D_Erosion_1_Temp_2);
 			Variable_0 = FMath::Clamp<v_flt>(Variable_0, -1.200000, 1.200000);
 			_2D_Erosion_1_Temp_1 = FMath::Clamp<v_flt>(_2D_Erosion_1_Temp_1, -1.200000, 1.200000);
 			_2D_Erosion_1_Temp_2 = FMath::Clamp<v_flt>(_2D_Erosion_1_Temp_2, -1.200000, 1.200000);
@@ -859,7 +859,7 @@ public:
 			v_flt Variable_18; // 2D Perlin Noise Fractal output 0
 			v_flt Variable_19; // 2D Perlin Noise Fractal output 1
 			v_flt Variable_20; // 2D Perlin Noise Fractal output 2
-			Variable_18 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D_Deriv(Variable_1, Variable_2, v_flt(0.001f), _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],Variable_19,Variable_20);
+			Variable_18 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D_Deriv(Variable_1, Variable_2, v_flt(0.001f), _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.001f), v_flt(1.0f), Context.LOD),Variable_19,Variable_20);
 			Variable_18 = FMath::Clamp<v_flt>(Variable_18, -0.722935, 0.711631);
 			Variable_19 = FMath::Clamp<v_flt>(Variable_19, -1.982108, 2.144371);
 			Variable_20 = FMath::Clamp<v_flt>(Variable_20, -2.105316, 1.997740);
@@ -868,7 +868,7 @@ public:
 			v_flt Variable_0; // 2D Erosion output 0
 			v_flt _2D_Erosion_1_Temp_1; // 2D Erosion output 1
 			v_flt _2D_Erosion_1_Temp_2; // 2D Erosion output 2
-			Variable_0 = _2D_Erosion_1_Noise.GetErosion_2D(Variable_14, Variable_15, v_flt(0.02f), _2D_Erosion_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], Variable_19, Variable_20, _2D_Erosion_1_Temp_1, _2D_Erosion_1_Temp_2);
+			Variable_0 = _2D_Erosion_1_Noise.GetErosion_2D(Variable_14, Variable_15, v_flt(0.02f), _2D_Erosion_1_Noise.GetLODOctaves(_2D_Erosion_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD), Variable_19, Variable_20, _2D_Erosion_1_Temp_1, _2D_Erosion_1_Temp_2);
 			Variable_0 = FMath::Clamp<v_flt>(Variable_0, -1.200000, 1.200000);
 			_2D_Erosion_1_Temp_1 = FMath::Clamp<v_flt>(_2D_Erosion_1_Temp_1, -1.200000, 1.200000);
 			_2D_Erosion_1_Temp_2 = FMath::Clamp<v_flt>(_2D_Erosion_1_Temp_2, -1.200000, 1.200000);
@@ -1320,6 +1320,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
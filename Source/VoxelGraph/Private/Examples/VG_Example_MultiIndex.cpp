@@ -205,7 +205,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_1; // 2D Perlin Noise Fractal output 0
-			Variable_1 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_2, Variable_3, v_flt(0.002f), _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_1 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_2, Variable_3, v_flt(0.002f), _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.002f), v_flt(1.0f), Context.LOD));
 			Variable_1 = FMath::Clamp<v_flt>(Variable_1, -0.601283, 0.600269);
 			
 			// 2D Noise SDF.*
@@ -228,7 +228,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_1; // 2D Perlin Noise Fractal output 0
-			Variable_1 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_2, Variable_3, v_flt(0.002f), _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_1 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_2, Variable_3, v_flt(0.002f), _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.002f), v_flt(1.0f), Context.LOD));
 			Variable_1 = FMath::Clamp<v_flt>(Variable_1, -0.601283, 0.600269);
 			
 			// 2D Noise SDF.*
@@ -273,7 +273,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_1; // 2D Perlin Noise Fractal output 0
-			Variable_1 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_2, Variable_3, v_flt(0.002f), _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_1 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_2, Variable_3, v_flt(0.002f), _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.002f), v_flt(1.0f), Context.LOD));
 			Variable_1 = FMath::Clamp<v_flt>(Variable_1, -0.601283, 0.600269);
 			
 			// 2D Noise SDF.*
@@ -544,7 +544,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_13; // 2D Perlin Noise Fractal output 0
-			Variable_13 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_13 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD));
 			Variable_13 = FMath::Clamp<v_flt>(Variable_13, -0.306139, 0.328394);
 			
 			// *
@@ -563,7 +563,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_13; // 2D Perlin Noise Fractal output 0
-			Variable_13 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_13 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_11, Variable_12, v_flt(0.02f), _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD));
 			Variable_13 = FMath::Clamp<v_flt>(Variable_13, -0.306139, 0.328394);
 			
 			// *
@@ -624,7 +624,7 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_13; // 2D Perlin Noise Fractal output 0
-			Variable_13 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(Variable_11, Variable_12, v_flt(0.02f), _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_13 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(Variable_11, Variable_12, v_flt(0.02f), _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], v_flt(0.02f), v_flt(1.0f), Context.LOD));
 			Variable_13 = FMath::Clamp<v_flt>(Variable_13, -0.306139, 0.328394);
 			
 			// *
@@ -995,6 +995,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
@@ -392,19 +392,19 @@ public:
 			v_flt Variable_23; // 2D IQ Noise output 0
 			v_flt _2D_IQ_Noise_0_Temp_1; // 2D IQ Noise output 1
 			v_flt _2D_IQ_Noise_0_Temp_2; // 2D IQ Noise output 2
-			Variable_23 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_19, Variable_20, BufferConstant.Variable_31, _2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
+			Variable_23 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_19, Variable_20, BufferConstant.Variable_31, _2D_IQ_Noise_0_Noise.GetLODOctaves(_2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_31, v_flt(1.0f), Context.LOD),_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
 			Variable_23 = FMath::Clamp<v_flt>(Variable_23, -0.779186, 0.705623);
 			_2D_IQ_Noise_0_Temp_1 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_1, -1.482251, 1.789484);
 			_2D_IQ_Noise_0_Temp_2 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_2, -1.568460, 1.481016);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_5; // 2D Perlin Noise Fractal output 0
-			Variable_5 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_3, Variable_4, BufferConstant.Variable_28, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_5 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_3, Variable_4, BufferConstant.Variable_28, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_28, v_flt(1.0f), Context.LOD));
 			Variable_5 = FMath::Clamp<v_flt>(Variable_5, -0.643471, 0.527891);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_2; // 2D Perlin Noise Fractal output 0
-			Variable_2 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_27, _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_2 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_27, _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_27, v_flt(1.0f), Context.LOD));
 			Variable_2 = FMath::Clamp<v_flt>(Variable_2, -0.643471, 0.527891);
 			
 			// Vector Length.Vector Length
@@ -463,19 +463,19 @@ public:
 			v_flt Variable_23; // 2D IQ Noise output 0
 			v_flt _2D_IQ_Noise_0_Temp_1; // 2D IQ Noise output 1
 			v_flt _2D_IQ_Noise_0_Temp_2; // 2D IQ Noise output 2
-			Variable_23 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_19, Variable_20, BufferConstant.Variable_31, _2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
+			Variable_23 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_19, Variable_20, BufferConstant.Variable_31, _2D_IQ_Noise_0_Noise.GetLODOctaves(_2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_31, v_flt(1.0f), Context.LOD),_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
 			Variable_23 = FMath::Clamp<v_flt>(Variable_23, -0.779186, 0.705623);
 			_2D_IQ_Noise_0_Temp_1 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_1, -1.482251, 1.789484);
 			_2D_IQ_Noise_0_Temp_2 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_2, -1.568460, 1.481016);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_5; // 2D Perlin Noise Fractal output 0
-			Variable_5 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_3, Variable_4, BufferConstant.Variable_28, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_5 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_3, Variable_4, BufferConstant.Variable_28, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_28, v_flt(1.0f), Context.LOD));
 			Variable_5 = FMath::Clamp<v_flt>(Variable_5, -0.643471, 0.527891);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_2; // 2D Perlin Noise Fractal output 0
-			Variable_2 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_27, _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_2 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_27, _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_27, v_flt(1.0f), Context.LOD));
 			Variable_2 = FMath::Clamp<v_flt>(Variable_2, -0.643471, 0.527891);
 			
 			// Vector Length.Vector Length
@@ -691,19 +691,19 @@ public:
 			v_flt Variable_23; // 2D IQ Noise output 0
 			v_flt _2D_IQ_Noise_0_Temp_1; // 2D IQ Noise output 1
 			v_flt _2D_IQ_Noise_0_Temp_2; // 2D IQ Noise output 2
-			Variable_23 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(Variable_19, Variable_20, BufferConstant.Variable_31, _2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
+			Variable_23 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(Variable_19, Variable_20, BufferConstant.Variable_31, _2D_IQ_Noise_0_Noise.GetLODOctaves(_2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_31, v_flt(1.0f), Context.LOD),_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
 			Variable_23 = FMath::Clamp<v_flt>(Variable_23, -0.779186, 0.705623);
 			_2D_IQ_Noise_0_Temp_1 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_1, -1.482251, 1.789484);
 			_2D_IQ_Noise_0_Temp_2 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_2, -1.568460, 1.481016);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_5; // 2D Perlin Noise Fractal output 0
-			Variable_5 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_3, Variable_4, BufferConstant.Variable_28, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_5 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_3, Variable_4, BufferConstant.Variable_28, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_28, v_flt(1.0f), Context.LOD));
 			Variable_5 = FMath::Clamp<v_flt>(Variable_5, -0.643471, 0.527891);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_2; // 2D Perlin Noise Fractal output 0
-			Variable_2 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(Variable_0, Variable_1, BufferConstant.Variable_27, _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_2 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(Variable_0, Variable_1, BufferConstant.Variable_27, _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_27, v_flt(1.0f), Context.LOD));
 			Variable_2 = FMath::Clamp<v_flt>(Variable_2, -0.643471, 0.527891);
 			
 			// Vector Length.Vector Length
@@ -1614,6 +1614,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
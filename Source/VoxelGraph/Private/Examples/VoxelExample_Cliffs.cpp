@@ -366,19 +366,19 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_2; // 2D Perlin Noise Fractal output 0
-			Variable_2 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_30, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_2 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_30, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_30, v_flt(1.0f), Context.LOD));
 			Variable_2 = FMath::Clamp<v_flt>(Variable_2, -0.576700, 0.658489);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_23; // 2D Perlin Noise Fractal output 0
-			Variable_23 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_24, Variable_25, BufferConstant.Variable_33, _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_23 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_24, Variable_25, BufferConstant.Variable_33, _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_33, v_flt(1.0f), Context.LOD));
 			Variable_23 = FMath::Clamp<v_flt>(Variable_23, -0.594076, 0.593483);
 			
 			// 2D IQ Noise
 			v_flt Variable_16; // 2D IQ Noise output 0
 			v_flt _2D_IQ_Noise_0_Temp_1; // 2D IQ Noise output 1
 			v_flt _2D_IQ_Noise_0_Temp_2; // 2D IQ Noise output 2
-			Variable_16 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_14, Variable_15, BufferConstant.Variable_35, _2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
+			Variable_16 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_14, Variable_15, BufferConstant.Variable_35, _2D_IQ_Noise_0_Noise.GetLODOctaves(_2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_35, v_flt(1.0f), Context.LOD),_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
 			Variable_16 = FMath::Clamp<v_flt>(Variable_16, -0.648057, 0.611352);
 			_2D_IQ_Noise_0_Temp_1 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_1, -1.300998, 1.397865);
 			_2D_IQ_Noise_0_Temp_2 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_2, -1.723871, 1.259353);
@@ -419,19 +419,19 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_2; // 2D Perlin Noise Fractal output 0
-			Variable_2 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_30, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_2 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(BufferX.Variable_0, Variable_1, BufferConstant.Variable_30, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_30, v_flt(1.0f), Context.LOD));
 			Variable_2 = FMath::Clamp<v_flt>(Variable_2, -0.576700, 0.658489);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_23; // 2D Perlin Noise Fractal output 0
-			Variable_23 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_24, Variable_25, BufferConstant.Variable_33, _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_23 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(BufferX.Variable_24, Variable_25, BufferConstant.Variable_33, _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_33, v_flt(1.0f), Context.LOD));
 			Variable_23 = FMath::Clamp<v_flt>(Variable_23, -0.594076, 0.593483);
 			
 			// 2D IQ Noise
 			v_flt Variable_16; // 2D IQ Noise output 0
 			v_flt _2D_IQ_Noise_0_Temp_1; // 2D IQ Noise output 1
 			v_flt _2D_IQ_Noise_0_Temp_2; // 2D IQ Noise output 2
-			Variable_16 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_14, Variable_15, BufferConstant.Variable_35, _2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
+			Variable_16 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(BufferX.Variable_14, Variable_15, BufferConstant.Variable_35, _2D_IQ_Noise_0_Noise.GetLODOctaves(_2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_35, v_flt(1.0f), Context.LOD),_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
 			Variable_16 = FMath::Clamp<v_flt>(Variable_16, -0.648057, 0.611352);
 			_2D_IQ_Noise_0_Temp_1 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_1, -1.300998, 1.397865);
 			_2D_IQ_Noise_0_Temp_2 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_2, -1.723871, 1.259353);
@@ -540,19 +540,19 @@ public:
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_2; // 2D Perlin Noise Fractal output 0
-			Variable_2 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_0, Variable_1, BufferConstant.Variable_30, _2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_2 = _2D_Perlin_Noise_Fractal_0_Noise.GetPerlinFractal_2D(Variable_0, Variable_1, BufferConstant.Variable_30, _2D_Perlin_Noise_Fractal_0_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_30, v_flt(1.0f), Context.LOD));
 			Variable_2 = FMath::Clamp<v_flt>(Variable_2, -0.576700, 0.658489);
 			
 			// 2D Perlin Noise Fractal
 			v_flt Variable_23; // 2D Perlin Noise Fractal output 0
-			Variable_23 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(Variable_24, Variable_25, BufferConstant.Variable_33, _2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)]);
+			Variable_23 = _2D_Perlin_Noise_Fractal_1_Noise.GetPerlinFractal_2D(Variable_24, Variable_25, BufferConstant.Variable_33, _2D_Perlin_Noise_Fractal_1_Noise.GetLODOctaves(_2D_Perlin_Noise_Fractal_1_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_33, v_flt(1.0f), Context.LOD));
 			Variable_23 = FMath::Clamp<v_flt>(Variable_23, -0.594076, 0.593483);
 			
 			// 2D IQ Noise
 			v_flt Variable_16; // 2D IQ Noise output 0
 			v_flt _2D_IQ_Noise_0_Temp_1; // 2D IQ Noise output 1
 			v_flt _2D_IQ_Noise_0_Temp_2; // 2D IQ Noise output 2
-			Variable_16 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(Variable_14, Variable_15, BufferConstant.Variable_35, _2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)],_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
+			Variable_16 = _2D_IQ_Noise_0_Noise.IQNoise_2D_Deriv(Variable_14, Variable_15, BufferConstant.Variable_35, _2D_IQ_Noise_0_Noise.GetLODOctaves(_2D_IQ_Noise_0_LODToOctaves[FMath::Clamp(Context.LOD, 0, 31)], BufferConstant.Variable_35, v_flt(1.0f), Context.LOD),_2D_IQ_Noise_0_Temp_1,_2D_IQ_Noise_0_Temp_2);
 			Variable_16 = FMath::Clamp<v_flt>(Variable_16, -0.648057, 0.611352);
 			_2D_IQ_Noise_0_Temp_1 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_1, -1.300998, 1.397865);
 			_2D_IQ_Noise_0_Temp_2 = FMath::Clamp<v_flt>(_2D_IQ_Noise_0_Temp_2, -1.723871, 1.259353);
@@ -1255,6 +1255,13 @@ public:
 				},
 				{
 					{ "Value", NoTransformRangeAccessor<v_flt>::Get<1, TRangeOutputFunctionPtr<v_flt>>() },
+				},
+				{
+					{ "Value", NoTransformQueryZoneAccessor<v_flt>::Get<1, TQueryZoneOutputFunctionPtr<v_flt>>() },
+				},
+				{
+				},
+				{
 				}
 			},
 			{
@@ -0,0 +1,144 @@
+// Copyright 2021 Phyronnaz
+
+#include "VoxelGraphRangeCache.h"
+#include "VoxelUtilities/VoxelIntVectorUtilities.h"
+#include "HAL/ConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelGraphRangeCacheMemory);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Graph Range Cache Hits"), STAT_VoxelGraphRangeCacheHits, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Graph Range Cache Parent Hits"), STAT_VoxelGraphRangeCacheParentHits, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Graph Range Cache Misses"), STAT_VoxelGraphRangeCacheMisses, STATGROUP_VoxelCounters);
+
+static TAutoConsoleVariable<int32> CVarEnableGraphRangeCache(
+	TEXT("voxel.graph.EnableRangeCache"),
+	1,
+	TEXT("If true, the range analysis results of the graphs are cached, and children bounds reuse their parents results when they are entirely empty or full"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarGraphRangeCacheMaxEntries(
+	TEXT("voxel.graph.RangeCacheMaxEntries"),
+	65536,
+	TEXT("Max number of range analysis results cached per graph instance. The cache is emptied when reaching it"),
+	ECVF_Default);
+
+// Max number of parents to look at
+constexpr int32 GVoxelGraphRangeCacheMaxDepth = 16;
+
+FVoxelGraphRangeCache::~FVoxelGraphRangeCache()
+{
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphRangeCacheMemory, AllocatedSize);
+}
+
+bool FVoxelGraphRangeCache::IsEnabled()
+{
+	return CVarEnableGraphRangeCache.GetValueOnAnyThread() != 0;
+}
+
+bool FVoxelGraphRangeCache::CanCache(const FVoxelIntBox& Bounds)
+{
+	const FIntVector Size = Bounds.Size();
+	return
+		Size.X == Size.Y &&
+		Size.X == Size.Z &&
+		FMath::IsPowerOfTwo(Size.X) &&
+		Bounds.Min.X % Size.X == 0 &&
+		Bounds.Min.Y % Size.X == 0 &&
+		Bounds.Min.Z % Size.X == 0;
+}
+
+bool FVoxelGraphRangeCache::Find(uint32 Index, int32 LOD, const FVoxelIntBox& Bounds, TVoxelRange<v_flt>& OutRange) const
+{
+	FKey Key;
+	Key.Min = Bounds.Min;
+	Key.Size = Bounds.Size().X;
+	Key.LOD = LOD;
+	Key.Index = Index;
+
+	FScopeLock Lock(&Section);
+	if (const TVoxelRange<v_flt>* Range = Map.Find(Key))
+	{
+		INC_DWORD_STAT(STAT_VoxelGraphRangeCacheHits);
+		OutRange = *Range;
+		return true;
+	}
+	return false;
+}
+
+bool FVoxelGraphRangeCache::FindSignDefiniteParent(uint32 Index, int32 LOD, const FVoxelIntBox& Bounds, TVoxelRange<v_flt>& OutRange) const
+{
+	// Smallest aligned power of 2 cube containing Bounds
+	const FIntVector BoundsSize = Bounds.Size();
+	int32 Size = FMath::RoundUpToPowerOfTwo(FMath::Max(1, BoundsSize.GetMax()));
+	if (!CanCache(Bounds))
+	{
+		// Bounds itself isn't cached
+		Size /= 2;
+	}
+
+	FScopeLock Lock(&Section);
+	for (int32 Depth = 0; Depth < GVoxelGraphRangeCacheMaxDepth && Size < (1 << 30); Depth++)
+	{
+		Size *= 2;
+
+		FKey Key;
+		Key.Min = FVoxelUtilities::DivideFloor(Bounds.Min, Size) * Size;
+		Key.Size = Size;
+		Key.LOD = LOD;
+		Key.Index = Index;
+
+		if (!FVoxelIntBox(Key.Min, Key.Min + Size).Contains(Bounds))
+		{
+			// Bounds is across two parents
+			continue;
+		}
+
+		if (const TVoxelRange<v_flt>* Range = Map.Find(Key))
+		{
+			if (Range->Min > 0 || Range->Max < 0)
+			{
+				INC_DWORD_STAT(STAT_VoxelGraphRangeCacheParentHits);
+				OutRange = *Range;
+				return true;
+			}
+		}
+	}
+
+	INC_DWORD_STAT(STAT_VoxelGraphRangeCacheMisses);
+	return false;
+}
+
+void FVoxelGraphRangeCache::Add(uint32 Index, int32 LOD, const FVoxelIntBox& Bounds, const TVoxelRange<v_flt>& Range)
+{
+	checkVoxelSlow(CanCache(Bounds));
+
+	FKey Key;
+	Key.Min = Bounds.Min;
+	Key.Size = Bounds.Size().X;
+	Key.LOD = LOD;
+	Key.Index = Index;
+
+	FScopeLock Lock(&Section);
+	if (Map.Num() >= CVarGraphRangeCacheMaxEntries.GetValueOnAnyThread())
+	{
+		// Range analysis is cheap compared to the queries it saves: no need for anything smarter
+		Map.Reset();
+	}
+	Map.Add(Key, Range);
+	UpdateStats();
+}
+
+void FVoxelGraphRangeCache::Reset()
+{
+	FScopeLock Lock(&Section);
+	Map.Empty();
+	UpdateStats();
+}
+
+void FVoxelGraphRangeCache::UpdateStats()
+{
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphRangeCacheMemory, AllocatedSize);
+	AllocatedSize = Map.GetAllocatedSize();
+	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphRangeCacheMemory, AllocatedSize);
+}
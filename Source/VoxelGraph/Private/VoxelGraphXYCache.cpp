@@ -0,0 +1,216 @@
+// Copyright 2021 Phyronnaz
+
+#include "VoxelGraphXYCache.h"
+#include "HAL/ConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelGraphXYCacheMemory);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Graph XY Cache Hits"), STAT_VoxelGraphXYCacheHits, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Graph XY Cache Misses"), STAT_VoxelGraphXYCacheMisses, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Graph XY Cache Evictions"), STAT_VoxelGraphXYCacheEvictions, STATGROUP_VoxelCounters);
+
+static TAutoConsoleVariable<int32> CVarEnableGraphXYCache(
+	TEXT("voxel.graph.EnableXYCache"),
+	1,
+	TEXT("If true, the XY stage of the graphs is cached and shared by all the chunks of a column"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarGraphXYCacheBudgetMB(
+	TEXT("voxel.graph.XYCacheBudgetMB"),
+	64,
+	TEXT("Max memory used by the graphs XY cache, in MB"),
+	ECVF_Default);
+
+static FAutoConsoleCommand CmdLogGraphXYCache(
+	TEXT("voxel.graph.LogXYCache"),
+	TEXT("Log the hits & misses of the graphs XY cache since the last voxel.graph.ClearXYCache"),
+	FConsoleCommandDelegate::CreateStatic(&FVoxelGraphXYCache::LogStats));
+
+static FAutoConsoleCommand CmdClearGraphXYCache(
+	TEXT("voxel.graph.ClearXYCache"),
+	TEXT("Clear the graphs XY cache and its stats"),
+	FConsoleCommandDelegate::CreateStatic(&FVoxelGraphXYCache::Clear));
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+struct FVoxelGraphXYCacheStorage
+{
+	struct FValue
+	{
+		TVoxelSharedPtr<const FVoxelGraphXYCacheEntry> Entry;
+		int64 AllocatedSize = 0;
+		uint64 LastAccess = 0;
+	};
+
+	FCriticalSection Section;
+	TMap<FVoxelGraphXYCache::FKey, FValue> Map;
+	int64 AllocatedSize = 0;
+	uint64 AccessCounter = 0;
+
+	FThreadSafeCounter64 NumHits;
+	FThreadSafeCounter64 NumMisses;
+	FThreadSafeCounter64 NumEvictions;
+
+	~FVoxelGraphXYCacheStorage()
+	{
+		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphXYCacheMemory, AllocatedSize);
+	}
+
+	// Must be called under Section
+	void Evict(int64 Budget)
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		TArray<TPair<uint64, FVoxelGraphXYCache::FKey>> Accesses;
+		Accesses.Reserve(Map.Num());
+		for (auto& It : Map)
+		{
+			Accesses.Emplace(It.Value.LastAccess, It.Key);
+		}
+		Accesses.Sort([](const TPair<uint64, FVoxelGraphXYCache::FKey>& A, const TPair<uint64, FVoxelGraphXYCache::FKey>& B) { return A.Key < B.Key; });
+
+		// Evict a bit more than needed to not do this on every new tile
+		const int64 TargetSize = Budget - Budget / 4;
+
+		int32 NumEvicted = 0;
+		for (auto& Access : Accesses)
+		{
+			if (AllocatedSize <= TargetSize)
+			{
+				break;
+			}
+
+			FValue Value;
+			verify(Map.RemoveAndCopyValue(Access.Value, Value));
+			AllocatedSize -= Value.AllocatedSize;
+			DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphXYCacheMemory, Value.AllocatedSize);
+			NumEvicted++;
+		}
+
+		NumEvictions.Add(NumEvicted);
+		INC_DWORD_STAT_BY(STAT_VoxelGraphXYCacheEvictions, NumEvicted);
+	}
+};
+
+static FVoxelGraphXYCacheStorage GVoxelGraphXYCacheStorage;
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool FVoxelGraphXYCache::IsEnabled()
+{
+	return CVarEnableGraphXYCache.GetValueOnAnyThread() != 0 && CVarGraphXYCacheBudgetMB.GetValueOnAnyThread() > 0;
+}
+
+uint64 FVoxelGraphXYCache::NewInstanceId()
+{
+	static FThreadSafeCounter64 Counter;
+	return Counter.Increment();
+}
+
+TVoxelSharedPtr<const FVoxelGraphXYCacheEntry> FVoxelGraphXYCache::Find(const FKey& Key)
+{
+	auto& Storage = GVoxelGraphXYCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+	if (auto* Value = Storage.Map.Find(Key))
+	{
+		Value->LastAccess = ++Storage.AccessCounter;
+		Storage.NumHits.Increment();
+		INC_DWORD_STAT(STAT_VoxelGraphXYCacheHits);
+		return Value->Entry;
+	}
+
+	Storage.NumMisses.Increment();
+	INC_DWORD_STAT(STAT_VoxelGraphXYCacheMisses);
+	return nullptr;
+}
+
+void FVoxelGraphXYCache::Add(const FKey& Key, const TVoxelSharedRef<const FVoxelGraphXYCacheEntry>& Entry)
+{
+	auto& Storage = GVoxelGraphXYCacheStorage;
+	const int64 Budget = int64(CVarGraphXYCacheBudgetMB.GetValueOnAnyThread()) << 20;
+	const int64 EntrySize = Entry->GetAllocatedSize();
+
+	FScopeLock Lock(&Storage.Section);
+
+	// Another thread might have computed the same tile in the meantime
+	FVoxelGraphXYCacheStorage::FValue& Value = Storage.Map.FindOrAdd(Key);
+	Storage.AllocatedSize -= Value.AllocatedSize;
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphXYCacheMemory, Value.AllocatedSize);
+
+	Value.Entry = Entry;
+	Value.AllocatedSize = EntrySize;
+	Value.LastAccess = ++Storage.AccessCounter;
+
+	Storage.AllocatedSize += EntrySize;
+	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphXYCacheMemory, EntrySize);
+
+	if (Storage.AllocatedSize > Budget)
+	{
+		Storage.Evict(Budget);
+	}
+}
+
+void FVoxelGraphXYCache::RemoveInstance(uint64 InstanceId)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	if (InstanceId == 0)
+	{
+		// Never initialized
+		return;
+	}
+
+	auto& Storage = GVoxelGraphXYCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+	for (auto It = Storage.Map.CreateIterator(); It; ++It)
+	{
+		if (It.Key().InstanceId == InstanceId)
+		{
+			Storage.AllocatedSize -= It.Value().AllocatedSize;
+			DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphXYCacheMemory, It.Value().AllocatedSize);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FVoxelGraphXYCache::Clear()
+{
+	auto& Storage = GVoxelGraphXYCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGraphXYCacheMemory, Storage.AllocatedSize);
+	Storage.AllocatedSize = 0;
+	Storage.Map.Empty();
+
+	Storage.NumHits.Reset();
+	Storage.NumMisses.Reset();
+	Storage.NumEvictions.Reset();
+
+	LOG_VOXEL(Log, TEXT("Graph XY cache cleared"));
+}
+
+void FVoxelGraphXYCache::LogStats()
+{
+	auto& Storage = GVoxelGraphXYCacheStorage;
+
+	FScopeLock Lock(&Storage.Section);
+
+	const int64 NumHits = Storage.NumHits.GetValue();
+	const int64 NumMisses = Storage.NumMisses.GetValue();
+	const int64 NumQueries = FMath::Max<int64>(1, NumHits + NumMisses);
+
+	LOG_VOXEL(Log, TEXT("Graph XY cache: %d tiles using %.1fMB; %lld hits (%.1f%%); %lld misses; %lld evictions"),
+		Storage.Map.Num(),
+		Storage.AllocatedSize / double(1 << 20),
+		NumHits,
+		100. * NumHits / NumQueries,
+		NumMisses,
+		Storage.NumEvictions.GetValue());
+}
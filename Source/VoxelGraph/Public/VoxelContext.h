@@ -29,6 +29,9 @@ struct VOXELGRAPH_API FVoxelContext
 	{
 	}
 
+	// Distance between two queried voxels, eg to drop details that can't be represented at this LOD
+	FORCEINLINE int32 GetStep() const { return 1 << LOD; }
+
 	FORCEINLINE v_flt GetWorldX() const { return WorldX; }
 	FORCEINLINE v_flt GetWorldY() const { return WorldY; }
 	FORCEINLINE v_flt GetWorldZ() const { return WorldZ; }
@@ -101,6 +104,8 @@ struct VOXELGRAPH_API FVoxelContextRange
 	{
 	}
 
+	FORCEINLINE int32 GetStep() const { return 1 << LOD; }
+
 	FORCEINLINE TVoxelRange<v_flt> GetWorldX() const { return { v_flt(WorldBounds.Min.X), v_flt(WorldBounds.Max.X) }; }
 	FORCEINLINE TVoxelRange<v_flt> GetWorldY() const { return { v_flt(WorldBounds.Min.Y), v_flt(WorldBounds.Max.Y) }; }
 	FORCEINLINE TVoxelRange<v_flt> GetWorldZ() const { return { v_flt(WorldBounds.Min.Z), v_flt(WorldBounds.Max.Z) }; }
@@ -86,6 +86,12 @@ public:
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Config")
 	bool bEnableRangeAnalysis = true;
 
+	// Max change of the value output per voxel, eg 1 if the value is a distance. 0 if unknown
+	// If set, chunks without surface that range analysis can't detect are skipped using a few samples
+	// Must never be lower than the real value, else holes will appear in the terrain
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Config", meta = (ClampMin = 0))
+	float ValueLipschitzConstant = 0;
+
 public:
 	// Can be enabled in Window->Debug Graph
 	UPROPERTY(EditAnywhere, Category = "Debug", meta = (Refresh))
@@ -162,6 +168,7 @@ public:
 	virtual TVoxelSharedRef<FVoxelTransformableGeneratorInstance> GetTransformableInstance() override;
 	virtual TVoxelSharedRef<FVoxelTransformableGeneratorInstance> GetTransformableInstance(const TMap<FName, FString>& Parameters) override;
 	virtual FVoxelGeneratorOutputs GetGeneratorOutputs() const override;
+	virtual bool CanShareInstances() const override { return true; }
 	//~ End UVoxelGenerator Interface
 
 #if WITH_EDITOR
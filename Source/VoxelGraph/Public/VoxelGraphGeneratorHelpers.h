@@ -7,6 +7,9 @@
 #include "VoxelMinimal.h"
 #include "VoxelContext.h"
 #include "VoxelGraphConstants.h"
+#include "VoxelGraphXYCache.h"
+#include "VoxelGraphRangeCache.h"
+#include "VoxelGenerators/VoxelTransformStepper.h"
 #include "VoxelGenerators/VoxelGeneratorHelpers.h"
 #include "VoxelGenerators/VoxelGeneratorInstance.inl"
 #include "VoxelGraphGeneratorHelpers.generated.h"
@@ -29,6 +32,7 @@ class TVoxelGraphGeneratorInstanceHelper : public TVoxelTransformableGeneratorIn
 public:
 	using FVoxelGeneratorInstance::TOutputFunctionPtr;
 	using FVoxelGeneratorInstance::TRangeOutputFunctionPtr;
+	using FVoxelGeneratorInstance::TQueryZoneOutputFunctionPtr;
 	using FVoxelTransformableGeneratorInstance::TOutputFunctionPtr_Transform;
 	using FVoxelTransformableGeneratorInstance::TRangeOutputFunctionPtr_Transform;
 	
@@ -47,6 +51,7 @@ public:
 		bool bEnableRangeAnalysis)
 		: TVoxelTransformableGeneratorInstanceHelper<TChild, UWorldObject>(nullptr, CustomFunctionPtrs, CustomFunctionPtrs_Transform)
 		, bEnableRangeAnalysis(bEnableRangeAnalysis)
+		, ValueLipschitzConstant(0)
 		, CustomOutputsNames(FName())
 	{
 		auto& Array = const_cast<TStaticArray<FName, MAX_VOXELGRAPH_OUTPUTS>&>(CustomOutputsNames);
@@ -78,6 +83,7 @@ public:
 		UWorldObject& Object)
 		: TVoxelTransformableGeneratorInstanceHelper<TChild, UWorldObject>(&Object, CustomFunctionPtrs, CustomFunctionPtrs_Transform)
 		, bEnableRangeAnalysis(Object.bEnableRangeAnalysis)
+		, ValueLipschitzConstant(Object.ValueLipschitzConstant)
 		, CustomOutputsNames(InPlace, FName())
 	{
 		auto& Array = const_cast<TStaticArray<FName, MAX_VOXELGRAPH_OUTPUTS>&>(CustomOutputsNames);
@@ -97,6 +103,11 @@ public:
 			Array[It.Value] = It.Key;
 		}
 	}
+	~TVoxelGraphGeneratorInstanceHelper()
+	{
+		// The entries can't be used anymore: don't wait for them to be evicted
+		FVoxelGraphXYCache::RemoveInstance(XYCacheInstanceId);
+	}
 
 public:
 	template<bool bCustomTransform, typename T, uint32 Index>
@@ -160,6 +171,11 @@ public:
 
 		FVoxelContext Context(LOD, Items, LocalToWorld, bCustomTransform);
 		
+		if (!bCustomTransform && GetOutputWithXYCache<T, QueryZoneType, Index>(Context, DefaultValue, QueryZone, LOD, Items))
+		{
+			return;
+		}
+
 		if (!bCustomTransform)
 		{
 			// We can only use the dependencies analysis if we don't have a transform, or if it's only translation + scale
@@ -193,14 +209,27 @@ public:
 		}
 		else
 		{
-			// Have to query all the voxels individually
+			// Have to query all the voxels individually, but can step their local positions instead of inverse transforming each of them
+			const int32 Step = QueryZone.Step;
+			const FIntVector Min = QueryZone.Bounds.Min;
+			const FVoxelTransformStepper Stepper(LocalToWorld, Min, Step);
+
 			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
 			{
+				Context.WorldX = X;
+				
 				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
 				{
+					Context.WorldY = Y;
+					
+					FVoxelVector Local = Stepper.Get((X - Min.X) / Step, (Y - Min.Y) / Step);
 					for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
 					{
-						Context.UpdateCoordinates<true>(X, Y, Z);
+						Context.WorldZ = Z;
+						Context.LocalX = Local.X;
+						Context.LocalY = Local.Y;
+						Context.LocalZ = Local.Z;
+						Local = Local + Stepper.StepZ;
 
 						auto Outputs = Target.GetOutputs();
 						Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
@@ -213,6 +242,139 @@ public:
 		}
 	}
 
+	// Same as the no transform path of GetOutput, but with the X & XY buffers shared with the other query zones through FVoxelGraphXYCache
+	// Returns false if the cache can't be used
+	template<typename T, typename QueryZoneType, uint32 Index>
+	bool GetOutputWithXYCache(FVoxelContext& Context, T DefaultValue, TVoxelQueryZone<QueryZoneType>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const
+	{
+		auto&& Target = This().template GetTarget<Index>();
+
+		using FBufferX = typename TDecay<decltype(Target.GetBufferX())>::Type;
+		using FBufferXY = typename TDecay<decltype(Target.GetBufferXY())>::Type;
+		using FEntry = TVoxelGraphXYCacheEntry<FBufferX, FBufferXY>;
+
+		if (std::is_empty<FBufferXY>::value ||
+			!FVoxelGraphXYCache::IsEnabled() ||
+			// The XY stage might depend on the items
+			!Items.IsEmpty() ||
+			Items.ItemHolder.NumItems() > 0 ||
+			Items.QueryData.DataItemParameters.Num() > 0)
+		{
+			return false;
+		}
+
+		constexpr int32 TileSize = FVoxelGraphXYCache::TileSize;
+		const int32 Step = QueryZone.Step;
+		const FVoxelIntBox& Bounds = QueryZone.Bounds;
+
+		if (Bounds.Min.X % Step != 0 || Bounds.Min.Y % Step != 0)
+		{
+			return false;
+		}
+
+		// A miss computes whole tiles: not worth it for zones smaller than a tile, such as single value queries
+		const FIntVector NumColumns = FVoxelUtilities::DivideCeil(Bounds.Size(), Step);
+		if (int64(NumColumns.X) * int64(NumColumns.Y) < TileSize * TileSize)
+		{
+			return false;
+		}
+
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		const FIntPoint MinTile(
+			FVoxelUtilities::DivideFloor(Bounds.Min.X / Step, TileSize),
+			FVoxelUtilities::DivideFloor(Bounds.Min.Y / Step, TileSize));
+		const FIntPoint MaxTile(
+			FVoxelUtilities::DivideFloor((Bounds.Max.X - 1 - Bounds.Min.X) / Step + Bounds.Min.X / Step, TileSize),
+			FVoxelUtilities::DivideFloor((Bounds.Max.Y - 1 - Bounds.Min.Y) / Step + Bounds.Min.Y / Step, TileSize));
+		const FIntPoint NumTiles = MaxTile - MinTile + 1;
+
+		TArray<TVoxelSharedPtr<const FEntry>, TInlineAllocator<16>> Entries;
+		Entries.Reserve(NumTiles.X * NumTiles.Y);
+		for (int32 TileY = MinTile.Y; TileY <= MaxTile.Y; TileY++)
+		{
+			for (int32 TileX = MinTile.X; TileX <= MaxTile.X; TileX++)
+			{
+				FVoxelGraphXYCache::FKey Key;
+				Key.InstanceId = XYCacheInstanceId;
+				Key.Index = Index;
+				Key.LOD = LOD;
+				Key.Step = Step;
+				Key.Tile = FIntPoint(TileX, TileY);
+
+				// Safe: the key is unique to this instance and target, hence to FEntry
+				auto Entry = StaticCastSharedPtr<const FEntry>(FVoxelGraphXYCache::Find(Key));
+				if (!Entry.IsValid())
+				{
+					const TVoxelSharedRef<FEntry> NewEntry = MakeVoxelShared<FEntry>();
+					NewEntry->BuffersX.Reserve(TileSize);
+					NewEntry->BuffersXY.Reserve(TileSize * TileSize);
+
+					for (int32 LocalX = 0; LocalX < TileSize; LocalX++)
+					{
+						Context.LocalX = Context.WorldX = (TileX * TileSize + LocalX) * Step;
+
+						auto& BufferX = NewEntry->BuffersX.Add_GetRef(Target.GetBufferX());
+						Target.ComputeX(Context, BufferX);
+					}
+					NewEntry->BuffersXY.SetNum(TileSize * TileSize);
+					for (int32 LocalY = 0; LocalY < TileSize; LocalY++)
+					{
+						Context.LocalY = Context.WorldY = (TileY * TileSize + LocalY) * Step;
+
+						for (int32 LocalX = 0; LocalX < TileSize; LocalX++)
+						{
+							Context.LocalX = Context.WorldX = (TileX * TileSize + LocalX) * Step;
+
+							// Copy to keep the cached X buffer untouched
+							auto BufferX = NewEntry->BuffersX[LocalX];
+							auto& BufferXY = NewEntry->BuffersXY[LocalX + TileSize * LocalY];
+							BufferXY = Target.GetBufferXY();
+							Target.ComputeXYWithCache(Context, BufferX, BufferXY);
+						}
+					}
+
+					FVoxelGraphXYCache::Add(Key, NewEntry);
+					Entry = NewEntry;
+				}
+				Entries.Add(Entry);
+			}
+		}
+
+		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
+		{
+			Context.LocalX = Context.WorldX = X;
+
+			const int32 TileX = FVoxelUtilities::DivideFloor(X / Step, TileSize);
+			const int32 LocalX = X / Step - TileX * TileSize;
+
+			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
+			{
+				Context.LocalY = Context.WorldY = Y;
+
+				const int32 TileY = FVoxelUtilities::DivideFloor(Y / Step, TileSize);
+				const int32 LocalY = Y / Step - TileY * TileSize;
+
+				const FEntry& Entry = *Entries[(TileX - MinTile.X) + NumTiles.X * (TileY - MinTile.Y)];
+				const FBufferX& BufferX = Entry.BuffersX[LocalX];
+				const FBufferXY& BufferXY = Entry.BuffersXY[LocalX + TileSize * LocalY];
+
+				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
+				{
+					Context.LocalZ = Context.WorldZ = Z;
+
+					auto Outputs = Target.GetOutputs();
+					Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+					Outputs.template Set<T, Index>(DefaultValue);
+					Target.ComputeXYZWithCache(Context, BufferX, BufferXY, Outputs);
+					QueryZone.Set(X, Y, Z, QueryZoneType(Outputs.template Get<T, Index>()));
+				}
+			}
+		}
+
+		return true;
+	}
+
 	template<bool bCustomTransform, typename T, uint32 Index>
 	T GetDataImpl(const FTransform& LocalToWorld, T DefaultValue, v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const
 	{
@@ -259,6 +421,13 @@ public:
 	{
 		return GetCustomOutputRangeImpl<false, T, Index>(FTransform(), Bounds, LOD, Items);
 	}
+	// Uses the X & XY caches, unlike querying every voxel individually
+	template<typename T, uint32 Index>
+	void GetCustomOutputsNoTransform(TVoxelQueryZone<T>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const
+	{
+		static_assert(Index < MAX_VOXELGRAPH_OUTPUTS, "");
+		GetOutput<false, T, T, Index>(FTransform(), T{}, QueryZone, LOD, Items);
+	}
 
 public:
 	//~ Begin FVoxelGeneratorInstance Interface
@@ -266,6 +435,10 @@ public:
 	{
 		bInit = true;
 		MaterialConfig = InitStruct.MaterialConfig;
+		// New seeds: don't use the XY cache entries of the previous init, and free them
+		FVoxelGraphXYCache::RemoveInstance(XYCacheInstanceId);
+		XYCacheInstanceId = FVoxelGraphXYCache::NewInstanceId();
+		RangeCache.Reset();
 		InitGraph(InitStruct);
 	}
 	
@@ -282,7 +455,42 @@ public:
 	template<bool bCustomTransform>
 	TVoxelRange<v_flt> GetValueRangeImpl(const FTransform& LocalToWorld, const FVoxelIntBox& WorldBounds, int32 LOD, const FVoxelItemStack& Items) const
 	{
-		return GetOutputRange<bCustomTransform, v_flt, FVoxelGraphOutputsIndices::ValueIndex>(LocalToWorld, 1, WorldBounds, LOD, Items);
+		constexpr uint32 Index = FVoxelGraphOutputsIndices::ValueIndex;
+
+		// Transformed queries don't map to aligned bounds, and items can change the result
+		const bool bUseCache =
+			!bCustomTransform &&
+			bEnableRangeAnalysis &&
+			FVoxelGraphRangeCache::IsEnabled() &&
+			Items.IsEmpty() &&
+			Items.ItemHolder.NumItems() == 0 &&
+			Items.QueryData.DataItemParameters.Num() == 0;
+
+		if (!bUseCache)
+		{
+			return GetOutputRange<bCustomTransform, v_flt, Index>(LocalToWorld, 1, WorldBounds, LOD, Items);
+		}
+
+		const bool bCanCache = FVoxelGraphRangeCache::CanCache(WorldBounds);
+
+		TVoxelRange<v_flt> Range;
+		if (bCanCache && RangeCache.Find(Index, LOD, WorldBounds, Range))
+		{
+			return Range;
+		}
+		// If a parent is entirely empty or full, so are its children: no need to analyze them
+		if (RangeCache.FindSignDefiniteParent(Index, LOD, WorldBounds, Range))
+		{
+			return Range;
+		}
+
+		Range = GetOutputRange<bCustomTransform, v_flt, Index>(LocalToWorld, 1, WorldBounds, LOD, Items);
+
+		if (bCanCache)
+		{
+			RangeCache.Add(Index, LOD, WorldBounds, Range);
+		}
+		return Range;
 	}
 
 	virtual void GetValues(TVoxelQueryZone<FVoxelValue>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const override final
@@ -303,6 +511,16 @@ public:
 		GetData<true, FVoxelMaterial, FVoxelMaterial, FVoxelGraphOutputsIndices::MaterialIndex>(LocalToWorld, FVoxelMaterial::Default(), QueryZone, LOD, Items);
 	}
 
+	virtual bool GetValueLipschitzConstant(const FVoxelIntBox& Bounds, int32 LOD, v_flt& OutLipschitz) const override final
+	{
+		if (ValueLipschitzConstant <= 0)
+		{
+			return false;
+		}
+		OutLipschitz = ValueLipschitzConstant;
+		return true;
+	}
+
 	virtual FVector GetUpVector(v_flt X, v_flt Y, v_flt Z) const override final
 	{
 		auto&& Target = This().template GetTarget<
@@ -352,6 +570,15 @@ protected:
 		}
 	};
 	template<typename T>
+	struct NoTransformQueryZoneAccessor
+	{
+		template<uint32 Index, typename ReturnType>
+		static ReturnType Get()
+		{
+			return static_cast<ReturnType>(&TChild::template GetCustomOutputsNoTransform<T, Index>);
+		}
+	};
+	template<typename T>
 	struct WithTransformAccessor
 	{
 		template<uint32 Index, typename ReturnType>
@@ -372,11 +599,15 @@ protected:
 
 private:
 	const bool bEnableRangeAnalysis;
+	const v_flt ValueLipschitzConstant;
 	// Used to forward the custom output calls to the generator in the stack
 	const TStaticArray<FName, MAX_VOXELGRAPH_OUTPUTS> CustomOutputsNames;
 
 	bool bInit = false;
 	EVoxelMaterialConfig MaterialConfig = EVoxelMaterialConfig(-1);
+	uint64 XYCacheInstanceId = 0;
+	// Value range analysis results of the octree bounds, reset on init
+	mutable FVoxelGraphRangeCache RangeCache;
 
 	const TChild& This() const
 	{
@@ -398,6 +629,14 @@ public:
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Misc", meta = (HideInGenerator))
 	bool bEnableRangeAnalysis = true;
 
+	// See UVoxelGraphGenerator::ValueLipschitzConstant
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Misc", meta = (HideInGenerator))
+	float ValueLipschitzConstant = 0;
+
+	//~ Begin UVoxelGenerator Interface
+	virtual bool CanShareInstances() const override { return true; }
+	//~ End UVoxelGenerator Interface
+
 protected:
 	DEPRECATED_VOXEL_GRAPH_FUNCTION()
 	virtual TMap<FName, int32> GetDefaultSeeds() const { return {}; }
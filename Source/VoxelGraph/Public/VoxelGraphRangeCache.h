@@ -0,0 +1,63 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+#include "VoxelRange.h"
+#include "VoxelIntBox.h"
+
+DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Graph Range Cache Memory"), STAT_VoxelGraphRangeCacheMemory, STATGROUP_VoxelMemory, VOXELGRAPH_API);
+
+/**
+ * Memo of the range analysis results of a generator instance
+ * Only bounds that are power of 2 cubes aligned on their size are stored, as that's what the octrees query
+ * Thread safe
+ */
+class VOXELGRAPH_API FVoxelGraphRangeCache
+{
+public:
+	FVoxelGraphRangeCache() = default;
+	~FVoxelGraphRangeCache();
+
+	static bool IsEnabled();
+	static bool CanCache(const FVoxelIntBox& Bounds);
+
+	bool Find(uint32 Index, int32 LOD, const FVoxelIntBox& Bounds, TVoxelRange<v_flt>& OutRange) const;
+	// Look for a cached parent of Bounds whose range doesn't contain 0, ie proving that Bounds is entirely empty or full
+	// Only makes sense for the value output
+	bool FindSignDefiniteParent(uint32 Index, int32 LOD, const FVoxelIntBox& Bounds, TVoxelRange<v_flt>& OutRange) const;
+
+	void Add(uint32 Index, int32 LOD, const FVoxelIntBox& Bounds, const TVoxelRange<v_flt>& Range);
+	void Reset();
+
+private:
+	struct FKey
+	{
+		FIntVector Min;
+		int32 Size = 0;
+		int32 LOD = 0;
+		uint32 Index = 0;
+
+		bool operator==(const FKey& Other) const
+		{
+			return
+				Min == Other.Min &&
+				Size == Other.Size &&
+				LOD == Other.LOD &&
+				Index == Other.Index;
+		}
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(
+				GetTypeHash(Key.Min),
+				HashCombine(GetTypeHash(Key.Size), GetTypeHash(Key.LOD + 256 * Key.Index)));
+		}
+	};
+
+	mutable FCriticalSection Section;
+	TMap<FKey, TVoxelRange<v_flt>> Map;
+	int64 AllocatedSize = 0;
+
+	void UpdateStats();
+};
@@ -0,0 +1,79 @@
+// Copyright 2021 Phyronnaz
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+
+DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Graph XY Cache Memory"), STAT_VoxelGraphXYCacheMemory, STATGROUP_VoxelMemory, VOXELGRAPH_API);
+
+struct FVoxelGraphXYCacheEntry
+{
+	virtual ~FVoxelGraphXYCacheEntry() = default;
+
+	virtual int64 GetAllocatedSize() const = 0;
+};
+
+// The X & XY buffers of all the columns of a tile
+template<typename TBufferX, typename TBufferXY>
+struct TVoxelGraphXYCacheEntry : FVoxelGraphXYCacheEntry
+{
+	TArray<TBufferX> BuffersX;
+	TArray<TBufferXY> BuffersXY;
+
+	virtual int64 GetAllocatedSize() const override
+	{
+		return BuffersX.GetAllocatedSize() + BuffersXY.GetAllocatedSize();
+	}
+};
+
+/**
+ * Process-wide cache of the XY stage of the graphs, shared by all the query zones of a column
+ * Heightmap-like graphs do most of their work in the XY stage, that would otherwise be recomputed for every chunk of a column
+ * Thread safe. Least recently used tiles are evicted once over voxel.graph.XYCacheBudgetMB
+ */
+class VOXELGRAPH_API FVoxelGraphXYCache
+{
+public:
+	// Number of columns of an edge of a tile
+	static constexpr int32 TileSize = 16;
+
+	struct FKey
+	{
+		uint64 InstanceId = 0;
+		// Output index of the graph target
+		uint32 Index = 0;
+		int32 LOD = 0;
+		int32 Step = 0;
+		// In steps
+		FIntPoint Tile;
+
+		bool operator==(const FKey& Other) const
+		{
+			return
+				InstanceId == Other.InstanceId &&
+				Index == Other.Index &&
+				LOD == Other.LOD &&
+				Step == Other.Step &&
+				Tile == Other.Tile;
+		}
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(
+				HashCombine(GetTypeHash(Key.InstanceId), GetTypeHash(Key.Index)),
+				HashCombine(GetTypeHash(Key.Tile), GetTypeHash(Key.LOD + 256 * Key.Step)));
+		}
+	};
+
+	static bool IsEnabled();
+	// Unique id identifying a generator instance & its seeds. Never reused, unlike pointers
+	static uint64 NewInstanceId();
+
+	static TVoxelSharedPtr<const FVoxelGraphXYCacheEntry> Find(const FKey& Key);
+	static void Add(const FKey& Key, const TVoxelSharedRef<const FVoxelGraphXYCacheEntry>& Entry);
+	// Remove all the entries of an instance id, once it won't be used again
+	static void RemoveInstance(uint64 InstanceId);
+
+	static void Clear();
+	static void LogStats();
+};